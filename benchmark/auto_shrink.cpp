@@ -0,0 +1,137 @@
+// Copyright 2025 Joaquin M Lopez Munoz.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+// Memory footprint of a boost::unordered_flat_map<uint64_t, uint64_t> and of
+// a boost::unordered_map<uint64_t, uint64_t> grown to N elements and then
+// erased down to N/10 (peak-then-steady cache pattern), with
+// BOOST_UNORDERED_ENABLE_AUTO_SHRINK. Also reported: the latency of the
+// insertion triggering the shrinkage and lookup throughput after it.
+// Optional argument: N.
+
+#define _SILENCE_CXX17_OLD_ALLOCATOR_MEMBERS_DEPRECATION_WARNING
+#define _SILENCE_CXX20_CISO646_REMOVED_WARNING
+
+#define BOOST_UNORDERED_ENABLE_AUTO_SHRINK
+
+#include <boost/unordered/unordered_flat_map.hpp>
+#include <boost/unordered/unordered_map.hpp>
+#include <boost/core/detail/splitmix64.hpp>
+#include <boost/config.hpp>
+#include <vector>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <chrono>
+#include <memory>
+
+using namespace std::chrono_literals;
+
+static unsigned N = 10'000'000;
+constexpr unsigned K = 10'000'000; // lookups
+
+static std::vector< std::uint64_t > indices;
+
+static void init_indices()
+{
+    boost::detail::splitmix64 rng;
+
+    for( unsigned i = 0; i < N; ++i )
+    {
+        indices.push_back( rng() );
+    }
+}
+
+static std::size_t s_alloc_bytes = 0;
+
+template<class T> struct allocator
+{
+    using value_type = T;
+
+    allocator() = default;
+
+    template<class U> allocator( allocator<U> const & ) noexcept
+    {
+    }
+
+    template<class U> bool operator==( allocator<U> const & ) const noexcept
+    {
+        return true;
+    }
+
+    template<class U> bool operator!=( allocator<U> const& ) const noexcept
+    {
+        return false;
+    }
+
+    T* allocate( std::size_t n ) const
+    {
+        s_alloc_bytes += n * sizeof(T);
+        return std::allocator<T>().allocate( n );
+    }
+
+    void deallocate( T* p, std::size_t n ) const noexcept
+    {
+        s_alloc_bytes -= n * sizeof(T);
+        std::allocator<T>().deallocate( p, n );
+    }
+};
+
+using clock_type = std::chrono::steady_clock;
+
+template<class Map> BOOST_NOINLINE void test( char const* label )
+{
+    std::cout << label << ":\n";
+
+    {
+        Map map;
+
+        for( unsigned i = 0; i < N; ++i )
+        {
+            map.emplace( indices[ i ], i );
+        }
+
+        std::cout << "  Peak: size=" << map.size() << ", bucket_count=" << map.bucket_count() << ", " << s_alloc_bytes / 1024 / 1024 << " MB\n";
+
+        for( unsigned i = N / 10; i < N; ++i )
+        {
+            map.erase( indices[ i ] );
+        }
+
+        std::cout << "  After erasure: size=" << map.size() << ", bucket_count=" << map.bucket_count() << ", " << s_alloc_bytes / 1024 / 1024 << " MB\n";
+
+        auto t0 = clock_type::now();
+
+        map.emplace( indices[ N / 10 ], 0 );
+
+        auto t1 = clock_type::now();
+
+        std::cout << "  After next insertion: size=" << map.size() << ", bucket_count=" << map.bucket_count() << ", " << s_alloc_bytes / 1024 / 1024 << " MB (" << ( t1 - t0 ) / 1us << " us)\n";
+
+        boost::detail::splitmix64 rng( 42 );
+        std::uint64_t s = 0;
+
+        t0 = clock_type::now();
+
+        for( unsigned i = 0; i < K; ++i )
+        {
+            s += map.find( indices[ rng() % ( N / 10 ) ] )->second;
+        }
+
+        t1 = clock_type::now();
+
+        std::cout << "  Successful lookup: " << ( t1 - t0 ) / 1ns / K << " ns/lookup (s=" << s << ")\n\n";
+    }
+}
+
+int main( int argc, char* argv[] )
+{
+    if( argc > 1 ) N = static_cast<unsigned>( std::strtoul( argv[ 1 ], nullptr, 10 ) );
+
+    init_indices();
+
+    using value_type = std::pair<std::uint64_t const, std::uint64_t>;
+
+    test< boost::unordered_flat_map<std::uint64_t, std::uint64_t, boost::hash<std::uint64_t>, std::equal_to<std::uint64_t>, allocator<value_type>> >( "boost::unordered_flat_map" );
+    test< boost::unordered_map<std::uint64_t, std::uint64_t, boost::hash<std::uint64_t>, std::equal_to<std::uint64_t>, allocator<value_type>> >( "boost::unordered_map" );
+}
@@ -0,0 +1,259 @@
+// Copyright 2025 Joaquin M Lopez Munoz.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+// Read-through caching of Zipf-distributed keys (exponent 0.99, ten times as
+// many keys as the cache can hold) with boost::concurrent_flat_cache vs. a
+// mutex-protected std::unordered_map + std::list LRU cache for 1 to 64
+// threads. Cache sizes are given in the command line (default 1M), e.g.
+//
+//   cache 1000000 10000000 100000000
+
+#define _SILENCE_CXX17_OLD_ALLOCATOR_MEMBERS_DEPRECATION_WARNING
+#define _SILENCE_CXX20_CISO646_REMOVED_WARNING
+
+#include <boost/unordered/concurrent_flat_cache.hpp>
+#include <boost/core/detail/splitmix64.hpp>
+#include <boost/config.hpp>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+
+using namespace std::chrono_literals;
+
+constexpr std::uint64_t L = 16'000'000; // minimum operations per run
+
+// Rejection-inversion sampling of a Zipf distribution over 1..n
+// (W. Hormann, G. Derflinger, "Rejection-Inversion to Generate Variates
+// from Monotone Discrete Distributions", 1996)
+
+class zipf_distribution
+{
+private:
+
+    double n_, s_, hx1_, hn_, c_;
+
+    static double helper1( double x )
+    {
+        return std::abs( x ) > 1e-8? std::log1p( x ) / x: 1 - x * ( 0.5 - x * ( 1.0 / 3 - 0.25 * x ) );
+    }
+
+    static double helper2( double x )
+    {
+        return std::abs( x ) > 1e-8? std::expm1( x ) / x: 1 + x * 0.5 * ( 1 + x / 3 * ( 1 + 0.25 * x ) );
+    }
+
+    double h( double x ) const
+    {
+        return std::exp( -s_ * std::log( x ) );
+    }
+
+    double hintegral( double x ) const
+    {
+        double lx = std::log( x );
+        return helper2( ( 1 - s_ ) * lx ) * lx;
+    }
+
+    double hintegral_inverse( double x ) const
+    {
+        double t = std::max( x * ( 1 - s_ ), -1.0 );
+        return std::exp( helper1( t ) * x );
+    }
+
+public:
+
+    zipf_distribution( std::uint64_t n, double s ):
+        n_( static_cast<double>( n ) ), s_( s ),
+        hx1_( hintegral( 1.5 ) - 1 ), hn_( hintegral( n_ + 0.5 ) ),
+        c_( 2 - hintegral_inverse( hintegral( 2.5 ) - h( 2 ) ) )
+    {
+    }
+
+    std::uint64_t operator()( boost::detail::splitmix64& rng ) const
+    {
+        for( ;; )
+        {
+            double r = static_cast<double>( rng() >> 11 ) * 0x1.0p-53;
+            double u = hn_ + r * ( hx1_ - hn_ );
+            double x = hintegral_inverse( u );
+            double k = std::floor( x + 0.5 );
+
+            k = std::min( std::max( k, 1.0 ), n_ );
+            if( k - x <= c_ || u >= hintegral( k + 0.5 ) - h( k ) ) return static_cast<std::uint64_t>( k );
+        }
+    }
+};
+
+// ranks are scattered over the key space
+
+static std::uint64_t key_for( std::uint64_t rank )
+{
+    boost::detail::splitmix64 rng( rank );
+    return rng();
+}
+
+static std::uint64_t load( std::uint64_t key )
+{
+    return key * 7; // "slow backend"
+}
+
+using clock_type = std::chrono::steady_clock;
+
+struct flat_cache
+{
+    boost::concurrent_flat_cache<std::uint64_t, std::uint64_t> c;
+
+    explicit flat_cache( std::size_t n ): c( n ) {}
+
+    std::uint64_t get( std::uint64_t key, bool& hit )
+    {
+        std::uint64_t r = 0;
+        hit = c.cvisit( key, [&]( auto const& x ){ r = x.second; } ) != 0;
+
+        if( !hit )
+        {
+            r = load( key );
+            c.try_emplace( key, r );
+        }
+
+        return r;
+    }
+};
+
+struct lru_cache
+{
+    using list_type = std::list< std::pair<std::uint64_t, std::uint64_t> >;
+
+    std::size_t n_;
+    std::mutex mtx_;
+    list_type list_;
+    std::unordered_map< std::uint64_t, list_type::iterator > map_;
+
+    explicit lru_cache( std::size_t n ): n_( n )
+    {
+        map_.reserve( n );
+    }
+
+    std::uint64_t get( std::uint64_t key, bool& hit )
+    {
+        {
+            std::lock_guard<std::mutex> lck( mtx_ );
+
+            auto it = map_.find( key );
+            hit = it != map_.end();
+
+            if( hit )
+            {
+                list_.splice( list_.begin(), list_, it->second );
+                return it->second->second;
+            }
+        }
+
+        std::uint64_t r = load( key );
+
+        std::lock_guard<std::mutex> lck( mtx_ );
+
+        if( map_.find( key ) == map_.end() )
+        {
+            list_.emplace_front( key, r );
+            map_.emplace( key, list_.begin() );
+
+            if( map_.size() > n_ )
+            {
+                map_.erase( list_.back().first );
+                list_.pop_back();
+            }
+        }
+
+        return r;
+    }
+};
+
+template<class Cache> void run( Cache& cache, zipf_distribution const& zipf, std::uint64_t ops, unsigned num_threads, std::uint64_t& hits, std::uint64_t& s )
+{
+    std::vector<std::thread> threads;
+    std::atomic<std::uint64_t> h{ 0 }, s1{ 0 };
+
+    for( unsigned t = 0; t < num_threads; ++t )
+    {
+        threads.emplace_back( [&, t]{
+
+            boost::detail::splitmix64 rng( t + 1 );
+            std::uint64_t h2 = 0, s2 = 0;
+
+            for( std::uint64_t i = 0; i < ops / num_threads; ++i )
+            {
+                bool hit;
+                s2 += cache.get( key_for( zipf( rng ) ), hit );
+                h2 += hit;
+            }
+
+            h += h2;
+            s1 += s2;
+        });
+    }
+
+    for( auto& th: threads ) th.join();
+
+    hits = h;
+    s = s1;
+}
+
+template<class Cache> BOOST_NOINLINE void test( char const* label, std::size_t size, unsigned num_threads )
+{
+    std::uint64_t ops = std::max<std::uint64_t>( L, 2 * size );
+    zipf_distribution zipf( 10 * size, 0.99 );
+
+    Cache cache( size );
+
+    std::uint64_t hits, s;
+
+    run( cache, zipf, ops, num_threads, hits, s ); // warmup
+
+    auto t0 = clock_type::now();
+
+    run( cache, zipf, ops, num_threads, hits, s );
+
+    auto t1 = clock_type::now();
+
+    auto ms = ( t1 - t0 ) / 1ms + 1;
+
+    std::cout << std::setw( 26 ) << label << ", " << std::setw( 2 ) << num_threads << " threads: " << std::setw( 6 ) << ops / 1000 / ms << " Mops/s, hit ratio " << std::fixed << std::setprecision( 3 ) << double( hits ) / ( ops / num_threads * num_threads ) << " (s=" << s << ")\n";
+}
+
+int main( int argc, char** argv )
+{
+    std::vector<std::size_t> sizes;
+
+    for( int i = 1; i < argc; ++i )
+    {
+        sizes.push_back( std::strtoull( argv[ i ], nullptr, 10 ) );
+    }
+
+    if( sizes.empty() ) sizes.push_back( 1'000'000 );
+
+    std::cout << std::thread::hardware_concurrency() << " hardware threads\n\n";
+
+    for( auto size: sizes )
+    {
+        std::cout << "cache size " << size << "\n\n";
+
+        for( unsigned n = 1; n <= 64; n *= 2 )
+        {
+            test<flat_cache>( "boost::concurrent_flat_cache", size, n );
+            test<lru_cache>( "std::unordered_map+list", size, n );
+
+            std::cout << "\n";
+        }
+    }
+}
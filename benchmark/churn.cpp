@@ -0,0 +1,99 @@
+// Copyright 2025 Joaquin M Lopez Munoz.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+// Erase/insert churn at constant size on boost::unordered_flat_map (a sliding
+// window of keys, as in a session table with steady turnover). Anti-drift
+// periodically requests growth within the same capacity: reports overall
+// throughput and the per-operation latency tail, where such growth shows up.
+
+#define _SILENCE_CXX17_OLD_ALLOCATOR_MEMBERS_DEPRECATION_WARNING
+#define _SILENCE_CXX20_CISO646_REMOVED_WARNING
+
+#include <boost/unordered/unordered_flat_map.hpp>
+#include <boost/core/detail/splitmix64.hpp>
+#include <boost/config.hpp>
+#include <algorithm>
+#include <vector>
+#include <cstdint>
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+
+using namespace std::chrono_literals;
+
+constexpr unsigned N = 2'000'000; // window size
+constexpr unsigned K = 10;        // window turnovers
+
+static std::vector< std::uint64_t > indices;
+
+static void init_indices()
+{
+    boost::detail::splitmix64 rng;
+
+    for( unsigned i = 0; i < N * ( K + 1 ); ++i )
+    {
+        indices.push_back( rng() );
+    }
+}
+
+using clock_type = std::chrono::steady_clock;
+
+static void print_percentile( std::vector<std::uint64_t> const& latencies, char const* label, double p )
+{
+    auto i = static_cast<std::size_t>( p * static_cast<double>( latencies.size() - 1 ) );
+    std::cout << std::setw( 8 ) << label << ": " << std::setw( 12 ) << latencies[ i ] << " ns\n";
+}
+
+int main()
+{
+    init_indices();
+
+    std::vector<std::uint64_t> latencies;
+    latencies.reserve( N * K );
+
+    boost::unordered_flat_map<std::uint64_t, std::uint64_t> map;
+
+    // window size at ~90% of the maximum load
+
+    map.reserve( N * 10 / 9 );
+
+    for( unsigned i = 0; i < N; ++i )
+    {
+        map.emplace( indices[ i ], i );
+    }
+
+    std::cout << "size=" << map.size() << ", bucket_count=" << map.bucket_count() << "\n";
+
+    auto t0 = clock_type::now();
+
+    for( unsigned i = 0; i < N * K; ++i )
+    {
+        auto t1 = clock_type::now();
+        map.erase( indices[ i ] );
+        map.emplace( indices[ i + N ], i );
+        auto t2 = clock_type::now();
+
+        latencies.push_back( static_cast<std::uint64_t>( ( t2 - t1 ) / 1ns ) );
+    }
+
+    auto t1 = clock_type::now();
+    std::cout << "Churn: " << ( t1 - t0 ) / 1ms << " ms (size=" << map.size() << ", bucket_count=" << map.bucket_count() << ")\n";
+
+    std::uint64_t s = 0;
+
+    for( unsigned i = 0; i < N; ++i )
+    {
+        s += map.find( indices[ N * K + i ] )->second;
+    }
+
+    auto t2 = clock_type::now();
+    std::cout << "Lookup: " << ( t2 - t1 ) / 1ms << " ms (s=" << s << ")\n\n";
+
+    std::sort( latencies.begin(), latencies.end() );
+
+    print_percentile( latencies, "p50", 0.5 );
+    print_percentile( latencies, "p99", 0.99 );
+    print_percentile( latencies, "p99.99", 0.9999 );
+    print_percentile( latencies, "max", 1.0 );
+}
@@ -0,0 +1,149 @@
+// Copyright 2025 Joaquin M Lopez Munoz.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+// Lookup latency in boost::concurrent_flat_map while other threads insert
+// elements whose mapped values are expensive to build (a 200 us busy loop),
+// with the value built inside the group lock (try_emplace_or_cvisit) vs.
+// outside (compute_if_absent), for 1 to 16 threads. 1% of operations are
+// insertions of new keys, the rest lookups of existing keys in a small table,
+// so that lookups often hit a group being inserted into.
+
+#define _SILENCE_CXX17_OLD_ALLOCATOR_MEMBERS_DEPRECATION_WARNING
+#define _SILENCE_CXX20_CISO646_REMOVED_WARNING
+
+#include <boost/unordered/concurrent_flat_map.hpp>
+#include <boost/core/detail/splitmix64.hpp>
+#include <boost/config.hpp>
+#include <algorithm>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+
+using namespace std::chrono_literals;
+
+constexpr unsigned N = 1'000;      // existing keys
+constexpr unsigned L = 200'000;    // operations per thread
+constexpr auto     D = 200us;      // cost of building a value
+
+using clock_type = std::chrono::steady_clock;
+
+struct slow_arg
+{
+    std::uint64_t x;
+};
+
+struct blob
+{
+    std::uint64_t x;
+
+    blob( slow_arg a ): x( a.x )
+    {
+        auto t0 = clock_type::now();
+        while( clock_type::now() - t0 < D );
+    }
+};
+
+using map_type = boost::concurrent_flat_map<std::uint64_t, blob>;
+
+struct in_lock
+{
+    static void insert( map_type& map, std::uint64_t k )
+    {
+        map.try_emplace_or_cvisit( k, slow_arg{ k }, []( auto const& ){} );
+    }
+};
+
+struct out_of_lock
+{
+    static void insert( map_type& map, std::uint64_t k )
+    {
+        map.compute_if_absent( k, [&]{ return blob( slow_arg{ k } ); } );
+    }
+};
+
+static void print_percentile( std::vector<std::uint64_t> const& latencies, char const* label, double p )
+{
+    auto i = static_cast<std::size_t>( p * static_cast<double>( latencies.size() - 1 ) );
+    std::cout << " " << label << " " << std::setw( 8 ) << latencies[ i ] << " ns";
+}
+
+template<class Insert> BOOST_NOINLINE void test( char const* label, unsigned num_threads )
+{
+    map_type map;
+
+    for( unsigned i = 0; i < N; ++i )
+    {
+        map.emplace( i, blob{ slow_arg{ i } } );
+    }
+
+    std::vector< std::vector<std::uint64_t> > latencies( num_threads );
+    std::vector<std::thread> threads;
+
+    auto t0 = clock_type::now();
+
+    for( unsigned t = 0; t < num_threads; ++t )
+    {
+        threads.emplace_back( [&, t]{
+
+            boost::detail::splitmix64 rng( t + 1 );
+            auto& lt = latencies[ t ];
+
+            lt.reserve( L );
+
+            for( std::uint64_t i = 0; i < L; ++i )
+            {
+                auto r = rng();
+
+                if( r % 100 == 0 )
+                {
+                    // new key, never looked up again
+
+                    Insert::insert( map, ( std::uint64_t( t + 1 ) << 32 ) + i );
+                }
+                else
+                {
+                    auto t1 = clock_type::now();
+                    map.cvisit( ( r >> 32 ) % N, []( auto const& ){} );
+                    auto t2 = clock_type::now();
+
+                    lt.push_back( static_cast<std::uint64_t>( ( t2 - t1 ) / 1ns ) );
+                }
+            }
+        });
+    }
+
+    for( auto& th: threads ) th.join();
+
+    auto t1 = clock_type::now();
+
+    std::vector<std::uint64_t> all;
+
+    for( auto& lt: latencies ) all.insert( all.end(), lt.begin(), lt.end() );
+
+    std::sort( all.begin(), all.end() );
+
+    std::cout << std::setw( 21 ) << label << ", " << std::setw( 2 ) << num_threads << " threads: " << std::setw( 6 ) << num_threads * L / ( ( t1 - t0 ) / 1ms + 1 ) << " Kops/s, lookup latency";
+
+    print_percentile( all, "p50", 0.5 );
+    print_percentile( all, "p99", 0.99 );
+    print_percentile( all, "p99.9", 0.999 );
+
+    std::cout << "\n";
+}
+
+int main()
+{
+    std::cout << std::thread::hardware_concurrency() << " hardware threads\n\n";
+
+    for( unsigned n = 1; n <= 16; n *= 2 )
+    {
+        test<in_lock>( "try_emplace_or_cvisit", n );
+        test<out_of_lock>( "compute_if_absent", n );
+
+        std::cout << "\n";
+    }
+}
@@ -0,0 +1,114 @@
+// Copyright 2025 Joaquin M Lopez Munoz.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+// Throughput of upserting batches of keys into boost::concurrent_flat_map
+// (insert the key with count 1, or increment the count of an existing one)
+// with range insert_and_visit, which hashes and prefetches in bulk and locks
+// the container once per batch, versus a loop of single-element
+// insert_and_visit calls, from 1 to a maximum number of threads.
+// Optional argument: maximum number of threads.
+
+#define _SILENCE_CXX17_OLD_ALLOCATOR_MEMBERS_DEPRECATION_WARNING
+#define _SILENCE_CXX20_CISO646_REMOVED_WARNING
+
+#include <boost/unordered/concurrent_flat_map.hpp>
+#include <boost/core/detail/splitmix64.hpp>
+#include <boost/config.hpp>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+
+using namespace std::chrono_literals;
+
+constexpr unsigned N = 20'000'000; // total upserts
+constexpr unsigned K = 2'000'000; // distinct keys
+constexpr unsigned B = 10'000; // batch size
+
+static unsigned max_threads = 2 * std::thread::hardware_concurrency();
+
+using value_type = std::pair<std::uint64_t, std::uint64_t>;
+
+static std::vector< value_type > batches;
+
+static void init_batches()
+{
+    boost::detail::splitmix64 rng;
+
+    std::vector< std::uint64_t > keys;
+
+    for( unsigned i = 0; i < K; ++i )
+    {
+        keys.push_back( rng() );
+    }
+
+    for( unsigned i = 0; i < N; ++i )
+    {
+        batches.push_back( { keys[ rng() % K ], 1 } );
+    }
+}
+
+using clock_type = std::chrono::steady_clock;
+
+using map_type = boost::concurrent_flat_map<std::uint64_t, std::uint64_t>;
+
+template<class F> BOOST_NOINLINE void test( char const* label, unsigned num_threads, F f )
+{
+    map_type map;
+    std::vector<std::thread> threads;
+
+    auto t0 = clock_type::now();
+
+    for( unsigned t = 0; t < num_threads; ++t )
+    {
+        threads.emplace_back( [&, t]{
+
+            for( unsigned i = t * B; i < N; i += num_threads * B )
+            {
+                f( map, batches.data() + i, batches.data() + i + B );
+            }
+        });
+    }
+
+    for( auto& th: threads ) th.join();
+
+    auto t1 = clock_type::now();
+
+    std::uint64_t s = 0;
+    map.cvisit_all( [&]( auto const& x ){ s += x.second; } );
+
+    std::cout << std::setw( 4 ) << num_threads << " threads, " << label << ": " << std::setw( 6 ) << N / 1000 / ( ( t1 - t0 ) / 1ms + 1 ) << " Mupserts/s (size=" << map.size() << ", s=" << s << ")\n";
+}
+
+int main( int argc, char* argv[] )
+{
+    if( argc > 1 ) max_threads = static_cast<unsigned>( std::strtoul( argv[ 1 ], nullptr, 10 ) );
+    if( max_threads == 0 ) max_threads = 1;
+
+    init_batches();
+
+    std::cout << "boost::concurrent_flat_map, " << N << " upserts in batches of " << B << ", " << std::thread::hardware_concurrency() << " hardware threads\n\n";
+
+    for( unsigned n = 1; n <= max_threads; n *= 2 )
+    {
+        test( "scalar", n, []( map_type& map, value_type const* first, value_type const* last ){
+
+            for( ; first != last; ++first )
+            {
+                map.insert_and_visit( *first, []( auto& ){}, []( auto& x ){ ++x.second; } );
+            }
+        });
+
+        test( "bulk  ", n, []( map_type& map, value_type const* first, value_type const* last ){
+
+            map.insert_and_visit( first, last, []( auto& ){}, []( auto& x ){ ++x.second; } );
+        });
+
+        std::cout << "\n";
+    }
+}
@@ -0,0 +1,105 @@
+// Copyright 2025 Joaquin M Lopez Munoz.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+// Throughput of concurrent insertion and erasure in boost::concurrent_flat_map
+// from 1 to a maximum number of threads (by default, 128), each working on a
+// disjoint set of keys. Insertion and erasure update the size of the
+// container, so this measures how well size tracking scales.
+// Optional argument: maximum number of threads.
+
+#define _SILENCE_CXX17_OLD_ALLOCATOR_MEMBERS_DEPRECATION_WARNING
+#define _SILENCE_CXX20_CISO646_REMOVED_WARNING
+
+#include <boost/unordered/concurrent_flat_map.hpp>
+#include <boost/core/detail/splitmix64.hpp>
+#include <boost/config.hpp>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+
+using namespace std::chrono_literals;
+
+constexpr unsigned N = 10'000'000;
+
+static unsigned max_threads = 128;
+
+static std::vector< std::uint64_t > indices;
+
+static void init_indices()
+{
+    boost::detail::splitmix64 rng;
+
+    for( unsigned i = 0; i < N; ++i )
+    {
+        indices.push_back( rng() );
+    }
+}
+
+using clock_type = std::chrono::steady_clock;
+
+using map_type = boost::concurrent_flat_map<std::uint64_t, std::uint64_t>;
+
+template<class F> BOOST_NOINLINE std::chrono::steady_clock::duration run( unsigned num_threads, F f )
+{
+    std::vector<std::thread> threads;
+
+    auto t0 = clock_type::now();
+
+    for( unsigned t = 0; t < num_threads; ++t )
+    {
+        threads.emplace_back( [&, t]{
+
+            for( unsigned i = t; i < N; i += num_threads )
+            {
+                f( i );
+            }
+        });
+    }
+
+    for( auto& th: threads ) th.join();
+
+    return clock_type::now() - t0;
+}
+
+BOOST_NOINLINE void test( unsigned num_threads )
+{
+    map_type map;
+
+    // reserve upfront so as to measure insertion rather than rehashing
+
+    map.reserve( N );
+
+    auto d1 = run( num_threads, [&]( unsigned i ){
+
+        map.emplace( indices[ i ], i );
+    });
+
+    auto d2 = run( num_threads, [&]( unsigned i ){
+
+        map.erase( indices[ i ] );
+    });
+
+    std::cout << std::setw( 4 ) << num_threads << " threads: "
+        << std::setw( 6 ) << N / 1000 / ( d1 / 1ms + 1 ) << " Minsertions/s, "
+        << std::setw( 6 ) << N / 1000 / ( d2 / 1ms + 1 ) << " Merasures/s (size=" << map.size() << ")\n";
+}
+
+int main( int argc, char* argv[] )
+{
+    if( argc > 1 ) max_threads = static_cast<unsigned>( std::strtoul( argv[ 1 ], nullptr, 10 ) );
+    if( max_threads == 0 ) max_threads = 1;
+
+    init_indices();
+
+    std::cout << "boost::concurrent_flat_map, " << N << " elements, " << std::thread::hardware_concurrency() << " hardware threads\n\n";
+
+    for( unsigned n = 1; n <= max_threads; n *= 2 )
+    {
+        test( n );
+    }
+}
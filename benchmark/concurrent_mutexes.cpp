@@ -0,0 +1,133 @@
+// Copyright 2025 Joaquin M Lopez Munoz.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+// Latency of exclusive operations (clear, rehash) on a small
+// boost::concurrent_flat_map versus lookup throughput with an increasing
+// number of threads. Build with different values of
+// BOOST_UNORDERED_CONCURRENT_MAX_MUTEXES to compare: fewer container-level
+// mutexes speed up the former at the expense of more contention in the latter.
+// Optional argument: maximum number of lookup threads.
+
+#define _SILENCE_CXX17_OLD_ALLOCATOR_MEMBERS_DEPRECATION_WARNING
+#define _SILENCE_CXX20_CISO646_REMOVED_WARNING
+
+#include <boost/unordered/concurrent_flat_map.hpp>
+#include <boost/core/detail/splitmix64.hpp>
+#include <boost/config.hpp>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+
+using namespace std::chrono_literals;
+
+constexpr unsigned N = 1'000'000;
+constexpr unsigned K = 100'000; // exclusive operations
+constexpr unsigned L = 10'000'000; // lookups per thread
+
+static unsigned max_threads = 2 * std::thread::hardware_concurrency();
+
+static std::vector< std::uint64_t > indices;
+
+static void init_indices()
+{
+    boost::detail::splitmix64 rng;
+
+    for( unsigned i = 0; i < N; ++i )
+    {
+        indices.push_back( rng() );
+    }
+}
+
+using clock_type = std::chrono::steady_clock;
+
+using map_type = boost::concurrent_flat_map<std::uint64_t, std::uint64_t>;
+
+template<class F> BOOST_NOINLINE void test_exclusive( char const* label, F f )
+{
+    map_type map;
+
+    auto t0 = clock_type::now();
+
+    for( unsigned i = 0; i < K; ++i )
+    {
+        f( map, i );
+    }
+
+    auto t1 = clock_type::now();
+
+    std::cout << std::setw( 10 ) << label << ": " << ( t1 - t0 ) / 1ns / K << " ns/op\n";
+}
+
+BOOST_NOINLINE void test_lookup( map_type const& map, unsigned num_threads )
+{
+    std::vector<std::thread> threads;
+    std::atomic<std::uint64_t> s{ 0 };
+
+    auto t0 = clock_type::now();
+
+    for( unsigned t = 0; t < num_threads; ++t )
+    {
+        threads.emplace_back( [&, t]{
+
+            boost::detail::splitmix64 rng( t );
+            std::uint64_t s2 = 0;
+
+            for( unsigned i = 0; i < L; ++i )
+            {
+                map.cvisit( indices[ rng() % N ], [&]( auto const& x ){ s2 += x.second; } );
+            }
+
+            s += s2;
+        });
+    }
+
+    for( auto& th: threads ) th.join();
+
+    auto t1 = clock_type::now();
+
+    std::cout << std::setw( 4 ) << num_threads << " threads: " << num_threads * ( L / 1000 ) / ( ( t1 - t0 ) / 1ms + 1 ) << " Mlookups/s (s=" << s.load() << ")\n";
+}
+
+int main( int argc, char* argv[] )
+{
+    if( argc > 1 ) max_threads = static_cast<unsigned>( std::strtoul( argv[ 1 ], nullptr, 10 ) );
+    if( max_threads == 0 ) max_threads = 1;
+
+    init_indices();
+
+    std::cout << "BOOST_UNORDERED_CONCURRENT_MAX_MUTEXES=" << BOOST_UNORDERED_CONCURRENT_MAX_MUTEXES << ", " << std::thread::hardware_concurrency() << " hardware threads\n\n";
+
+    std::cout << "Exclusive operations on a map with 16 elements:\n";
+
+    test_exclusive( "clear", []( map_type& map, unsigned i ){
+
+        for( unsigned j = 0; j < 16; ++j ) map.emplace( indices[ ( i + j ) % N ], j );
+        map.clear();
+    });
+
+    test_exclusive( "rehash", []( map_type& map, unsigned i ){
+
+        map.emplace( indices[ i % N ], i );
+        map.rehash( i % 2? 0: 64 );
+    });
+
+    std::cout << "\nSuccessful lookup on a map with " << N << " elements:\n";
+
+    map_type map;
+
+    for( unsigned i = 0; i < N; ++i )
+    {
+        map.emplace( indices[ i ], i );
+    }
+
+    for( unsigned n = 1; n <= max_threads; n *= 2 )
+    {
+        test_lookup( map, n );
+    }
+}
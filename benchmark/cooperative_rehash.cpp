@@ -0,0 +1,156 @@
+// Copyright 2025 Joaquin M Lopez Munoz.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+// Per-operation latency distribution of boost::concurrent_flat_map with
+// several threads inserting and several threads looking up concurrently.
+// Build once without and once with BOOST_UNORDERED_ENABLE_COOPERATIVE_REHASH:
+// the tail of the distribution (threads stalled while another thread
+// rehashes the whole table) should shrink in the latter.
+// Optional arguments: number of inserting threads, number of lookup threads.
+
+#define _SILENCE_CXX17_OLD_ALLOCATOR_MEMBERS_DEPRECATION_WARNING
+#define _SILENCE_CXX20_CISO646_REMOVED_WARNING
+
+#include <boost/unordered/concurrent_flat_map.hpp>
+#include <boost/core/detail/splitmix64.hpp>
+#include <boost/config.hpp>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+
+using namespace std::chrono_literals;
+
+constexpr unsigned N = 20'000'000;
+
+static unsigned num_writers = 4;
+static unsigned num_readers = 4;
+
+static std::vector< std::uint64_t > indices;
+
+static void init_indices()
+{
+    boost::detail::splitmix64 rng;
+
+    for( unsigned i = 0; i < N; ++i )
+    {
+        indices.push_back( rng() );
+    }
+}
+
+using clock_type = std::chrono::steady_clock;
+
+static void print_percentile( std::vector<std::uint64_t> const& latencies, char const* label, double p )
+{
+    auto i = static_cast<std::size_t>( p * static_cast<double>( latencies.size() - 1 ) );
+    std::cout << std::setw( 8 ) << label << ": " << std::setw( 12 ) << latencies[ i ] << " ns\n";
+}
+
+static void print_latencies( char const* label, std::vector< std::vector<std::uint64_t> >& per_thread )
+{
+    std::vector<std::uint64_t> latencies;
+
+    for( auto& v: per_thread )
+    {
+        latencies.insert( latencies.end(), v.begin(), v.end() );
+    }
+
+    std::sort( latencies.begin(), latencies.end() );
+
+    std::cout << label << " (" << latencies.size() << " ops):\n";
+
+    print_percentile( latencies, "p50", 0.5 );
+    print_percentile( latencies, "p99", 0.99 );
+    print_percentile( latencies, "p99.9", 0.999 );
+    print_percentile( latencies, "p99.99", 0.9999 );
+    print_percentile( latencies, "max", 1.0 );
+
+    std::cout << "\n";
+}
+
+int main( int argc, char* argv[] )
+{
+    if( argc > 1 ) num_writers = static_cast<unsigned>( std::strtoul( argv[ 1 ], nullptr, 10 ) );
+    if( argc > 2 ) num_readers = static_cast<unsigned>( std::strtoul( argv[ 2 ], nullptr, 10 ) );
+
+    init_indices();
+
+#if defined(BOOST_UNORDERED_ENABLE_COOPERATIVE_REHASH)
+    std::cout << "boost::concurrent_flat_map, cooperative rehash";
+#else
+    std::cout << "boost::concurrent_flat_map";
+#endif
+
+    std::cout << ", " << num_writers << " inserting threads, " << num_readers << " lookup threads\n\n";
+
+    boost::concurrent_flat_map<std::uint64_t, std::uint64_t> map;
+
+    std::vector< std::vector<std::uint64_t> > insert_latencies( num_writers );
+    std::vector< std::vector<std::uint64_t> > lookup_latencies( num_readers );
+    std::atomic<unsigned> inserted{ 0 };
+    std::atomic<unsigned> writers_done{ 0 };
+    std::vector<std::thread> threads;
+
+    auto t0 = clock_type::now();
+
+    for( unsigned t = 0; t < num_writers; ++t )
+    {
+        threads.emplace_back( [&, t]{
+
+            auto& latencies = insert_latencies[ t ];
+            latencies.reserve( N / num_writers + 1 );
+
+            for( unsigned i = t; i < N; i += num_writers )
+            {
+                auto t1 = clock_type::now();
+                map.emplace( indices[ i ], i );
+                auto t2 = clock_type::now();
+
+                latencies.push_back( static_cast<std::uint64_t>( ( t2 - t1 ) / 1ns ) );
+                inserted.fetch_add( 1, std::memory_order_relaxed );
+            }
+
+            ++writers_done;
+        });
+    }
+
+    std::atomic<std::uint64_t> s{ 0 };
+
+    for( unsigned t = 0; t < num_readers; ++t )
+    {
+        threads.emplace_back( [&, t]{
+
+            auto& latencies = lookup_latencies[ t ];
+            boost::detail::splitmix64 rng( t );
+            std::uint64_t s2 = 0;
+
+            while( writers_done < num_writers )
+            {
+                unsigned n = inserted.load( std::memory_order_relaxed );
+                std::uint64_t k = indices[ n? rng() % n: 0 ];
+
+                auto t1 = clock_type::now();
+                map.visit( k, [&]( auto const& x ){ s2 += x.second; } );
+                auto t2 = clock_type::now();
+
+                latencies.push_back( static_cast<std::uint64_t>( ( t2 - t1 ) / 1ns ) );
+            }
+
+            s += s2;
+        });
+    }
+
+    for( auto& th: threads ) th.join();
+
+    auto t1 = clock_type::now();
+    std::cout << "Total: " << ( t1 - t0 ) / 1ms << " ms (size=" << map.size() << ", s=" << s.load() << ")\n\n";
+
+    print_latencies( "Insertion", insert_latencies );
+    print_latencies( "Lookup", lookup_latencies );
+}
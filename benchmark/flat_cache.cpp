@@ -0,0 +1,247 @@
+// Copyright 2025 Joaquin M Lopez Munoz.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+// Single-threaded read-through caching of Zipf-distributed keys (exponent
+// 0.99, ten times as many keys as the cache can hold) with
+// boost::unordered_flat_cache under its three eviction policies vs.
+// boost::unordered_node_map + std::list LRU. Cache sizes are given in the
+// command line (default 1M), e.g.
+//
+//   flat_cache 10000 1000000 10000000
+
+#define _SILENCE_CXX17_OLD_ALLOCATOR_MEMBERS_DEPRECATION_WARNING
+#define _SILENCE_CXX20_CISO646_REMOVED_WARNING
+
+#include <boost/unordered/unordered_flat_cache.hpp>
+#include <boost/unordered/unordered_node_map.hpp>
+#include <boost/core/detail/splitmix64.hpp>
+#include <boost/config.hpp>
+#include <algorithm>
+#include <vector>
+#include <list>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+
+using namespace std::chrono_literals;
+
+constexpr std::uint64_t L = 16'000'000; // minimum operations per run
+
+// Rejection-inversion sampling of a Zipf distribution over 1..n
+// (W. Hormann, G. Derflinger, "Rejection-Inversion to Generate Variates
+// from Monotone Discrete Distributions", 1996)
+
+class zipf_distribution
+{
+private:
+
+    double n_, s_, hx1_, hn_, c_;
+
+    static double helper1( double x )
+    {
+        return std::abs( x ) > 1e-8? std::log1p( x ) / x: 1 - x * ( 0.5 - x * ( 1.0 / 3 - 0.25 * x ) );
+    }
+
+    static double helper2( double x )
+    {
+        return std::abs( x ) > 1e-8? std::expm1( x ) / x: 1 + x * 0.5 * ( 1 + x / 3 * ( 1 + 0.25 * x ) );
+    }
+
+    double h( double x ) const
+    {
+        return std::exp( -s_ * std::log( x ) );
+    }
+
+    double hintegral( double x ) const
+    {
+        double lx = std::log( x );
+        return helper2( ( 1 - s_ ) * lx ) * lx;
+    }
+
+    double hintegral_inverse( double x ) const
+    {
+        double t = std::max( x * ( 1 - s_ ), -1.0 );
+        return std::exp( helper1( t ) * x );
+    }
+
+public:
+
+    zipf_distribution( std::uint64_t n, double s ):
+        n_( static_cast<double>( n ) ), s_( s ),
+        hx1_( hintegral( 1.5 ) - 1 ), hn_( hintegral( n_ + 0.5 ) ),
+        c_( 2 - hintegral_inverse( hintegral( 2.5 ) - h( 2 ) ) )
+    {
+    }
+
+    std::uint64_t operator()( boost::detail::splitmix64& rng ) const
+    {
+        for( ;; )
+        {
+            double r = static_cast<double>( rng() >> 11 ) * 0x1.0p-53;
+            double u = hn_ + r * ( hx1_ - hn_ );
+            double x = hintegral_inverse( u );
+            double k = std::floor( x + 0.5 );
+
+            k = std::min( std::max( k, 1.0 ), n_ );
+            if( k - x <= c_ || u >= hintegral( k + 0.5 ) - h( k ) ) return static_cast<std::uint64_t>( k );
+        }
+    }
+};
+
+// keys are precomputed so that sampling doesn't dominate the measurement;
+// ranks are scattered over the key space
+
+static std::vector< std::uint64_t > keys;
+
+static void init_keys( std::size_t size, std::uint64_t ops )
+{
+    zipf_distribution zipf( 10 * size, 0.99 );
+    boost::detail::splitmix64 rng;
+
+    keys.clear();
+    keys.reserve( ops );
+
+    for( std::uint64_t i = 0; i < ops; ++i )
+    {
+        boost::detail::splitmix64 rng2( zipf( rng ) );
+        keys.push_back( rng2() );
+    }
+}
+
+static std::uint64_t load( std::uint64_t key )
+{
+    return key * 7; // "slow backend"
+}
+
+using clock_type = std::chrono::steady_clock;
+
+struct flat_cache
+{
+    boost::unordered_flat_cache<std::uint64_t, std::uint64_t> c;
+
+    flat_cache( std::size_t n, boost::unordered::cache_eviction policy ): c( n, policy ) {}
+
+    std::uint64_t get( std::uint64_t key, bool& hit )
+    {
+        auto it = c.find( key );
+        hit = it != c.end();
+
+        if( hit ) return it->second;
+        return c.try_emplace( key, load( key ) ).first->second;
+    }
+};
+
+struct lru_cache
+{
+    using list_type = std::list<std::uint64_t>;
+    using map_type = boost::unordered_node_map< std::uint64_t, std::pair<std::uint64_t, list_type::iterator> >;
+
+    std::size_t n_;
+    list_type list_;
+    map_type map_;
+
+    explicit lru_cache( std::size_t n ): n_( n )
+    {
+        map_.reserve( n + 1 );
+    }
+
+    std::uint64_t get( std::uint64_t key, bool& hit )
+    {
+        auto it = map_.find( key );
+        hit = it != map_.end();
+
+        if( hit )
+        {
+            list_.splice( list_.begin(), list_, it->second.second );
+            return it->second.first;
+        }
+
+        std::uint64_t r = load( key );
+
+        list_.push_front( key );
+        map_.emplace( key, std::make_pair( r, list_.begin() ) );
+
+        if( map_.size() > n_ )
+        {
+            map_.erase( list_.back() );
+            list_.pop_back();
+        }
+
+        return r;
+    }
+};
+
+template<class Cache> void run( Cache& cache, std::uint64_t& hits, std::uint64_t& s )
+{
+    hits = 0;
+    s = 0;
+
+    for( auto key: keys )
+    {
+        bool hit;
+        s += cache.get( key, hit );
+        hits += hit;
+    }
+}
+
+template<class Cache> BOOST_NOINLINE void test( char const* label, Cache& cache )
+{
+    std::uint64_t hits, s;
+
+    run( cache, hits, s ); // warmup
+
+    auto t0 = clock_type::now();
+
+    run( cache, hits, s );
+
+    auto t1 = clock_type::now();
+
+    std::cout << std::setw( 31 ) << label << ": " << std::setw( 5 ) << ( t1 - t0 ) / 1ns / keys.size() << " ns/op, hit ratio " << std::fixed << std::setprecision( 3 ) << double( hits ) / keys.size() << " (s=" << s << ")\n";
+}
+
+int main( int argc, char** argv )
+{
+    using boost::unordered::cache_eviction;
+
+    std::vector<std::size_t> sizes;
+
+    for( int i = 1; i < argc; ++i )
+    {
+        sizes.push_back( std::strtoull( argv[ i ], nullptr, 10 ) );
+    }
+
+    if( sizes.empty() ) sizes.push_back( 1'000'000 );
+
+    for( auto size: sizes )
+    {
+        std::cout << "cache size " << size << "\n\n";
+
+        init_keys( size, std::max<std::uint64_t>( L, 2 * size ) );
+
+        {
+            flat_cache cache( size, cache_eviction::clock );
+            test( "unordered_flat_cache (clock)", cache );
+        }
+
+        {
+            flat_cache cache( size, cache_eviction::sieve );
+            test( "unordered_flat_cache (sieve)", cache );
+        }
+
+        {
+            flat_cache cache( size, cache_eviction::lru );
+            test( "unordered_flat_cache (lru)", cache );
+        }
+
+        {
+            lru_cache cache( size );
+            test( "unordered_node_map+list (lru)", cache );
+        }
+
+        std::cout << "\n";
+    }
+}
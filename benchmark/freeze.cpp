@@ -0,0 +1,101 @@
+// Copyright 2025 Joaquin M Lopez Munoz.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+// Lookup throughput of boost::concurrent_flat_map before and after freeze()
+// for 1 to 64 threads.
+
+#define _SILENCE_CXX17_OLD_ALLOCATOR_MEMBERS_DEPRECATION_WARNING
+#define _SILENCE_CXX20_CISO646_REMOVED_WARNING
+
+#include <boost/unordered/concurrent_flat_map.hpp>
+#include <boost/core/detail/splitmix64.hpp>
+#include <boost/config.hpp>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+
+using namespace std::chrono_literals;
+
+constexpr unsigned N = 1'000'000; // distinct keys
+constexpr unsigned L = 32'000'000; // total lookups
+
+static std::vector< std::uint64_t > indices;
+
+static void init_indices()
+{
+    boost::detail::splitmix64 rng;
+
+    for( unsigned i = 0; i < N; ++i )
+    {
+        indices.push_back( rng() );
+    }
+}
+
+using clock_type = std::chrono::steady_clock;
+
+using map_type = boost::concurrent_flat_map<std::uint64_t, std::uint64_t>;
+
+BOOST_NOINLINE void test( char const* label, map_type const& map, unsigned num_threads )
+{
+    std::vector<std::thread> threads;
+    std::atomic<std::uint64_t> s{ 0 };
+
+    auto t0 = clock_type::now();
+
+    for( unsigned t = 0; t < num_threads; ++t )
+    {
+        threads.emplace_back( [&, t]{
+
+            boost::detail::splitmix64 rng( t );
+            std::uint64_t s2 = 0;
+
+            for( unsigned i = 0; i < L / num_threads; ++i )
+            {
+                // half of the lookups are unsuccessful
+
+                std::uint64_t key = indices[ rng() % N ] + ( i & 1 );
+                map.cvisit( key, [&]( auto const& x ){ s2 += x.second; } );
+            }
+
+            s += s2;
+        });
+    }
+
+    for( auto& th: threads ) th.join();
+
+    auto t1 = clock_type::now();
+
+    auto ms = ( t1 - t0 ) / 1ms + 1;
+
+    std::cout << std::setw( 10 ) << label << ", " << std::setw( 2 ) << num_threads << " threads: " << std::setw( 6 ) << L / 1000 / ms << " Mops/s (s=" << s.load() << ")\n";
+}
+
+int main()
+{
+    init_indices();
+
+    map_type map;
+
+    for( unsigned i = 0; i < N; ++i )
+    {
+        map.emplace( indices[ i ], i );
+    }
+
+    std::cout << "boost::concurrent_flat_map, " << std::thread::hardware_concurrency() << " hardware threads\n\n";
+
+    for( unsigned n = 1; n <= 64; n *= 2 )
+    {
+        test( "not frozen", map, n );
+
+        map.freeze();
+        test( "frozen", map, n );
+        map.thaw();
+
+        std::cout << "\n";
+    }
+}
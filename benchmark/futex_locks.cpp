@@ -0,0 +1,144 @@
+// Copyright 2025 Joaquin M Lopez Munoz.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+// Throughput and CPU usage of boost::concurrent_flat_map with increasingly
+// more threads than hardware threads, for a lookup-heavy workload and for a
+// workload with periodic exclusive operations (rehash) on which other threads
+// must wait. Build with and without BOOST_UNORDERED_ENABLE_FUTEX_LOCKS to
+// compare. Optional argument: maximum oversubscription factor.
+
+#define _SILENCE_CXX17_OLD_ALLOCATOR_MEMBERS_DEPRECATION_WARNING
+#define _SILENCE_CXX20_CISO646_REMOVED_WARNING
+
+#include <boost/unordered/concurrent_flat_map.hpp>
+#include <boost/core/detail/splitmix64.hpp>
+#include <boost/config.hpp>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+
+using namespace std::chrono_literals;
+
+constexpr unsigned N = 1'000'000; // distinct keys
+constexpr unsigned L = 20'000'000; // total operations
+
+static unsigned max_factor = 8;
+
+static std::vector< std::uint64_t > indices;
+
+static void init_indices()
+{
+    boost::detail::splitmix64 rng;
+
+    for( unsigned i = 0; i < N; ++i )
+    {
+        indices.push_back( rng() );
+    }
+}
+
+using clock_type = std::chrono::steady_clock;
+
+using map_type = boost::concurrent_flat_map<std::uint64_t, std::uint64_t>;
+
+template<class F> BOOST_NOINLINE void test( char const* label, unsigned num_threads, F f )
+{
+    map_type map;
+
+    for( unsigned i = 0; i < N; ++i )
+    {
+        map.emplace( indices[ i ], i );
+    }
+
+    std::vector<std::thread> threads;
+    std::atomic<std::uint64_t> s{ 0 };
+
+    auto t0 = clock_type::now();
+    auto c0 = std::clock();
+
+    for( unsigned t = 0; t < num_threads; ++t )
+    {
+        threads.emplace_back( [&, t]{
+
+            boost::detail::splitmix64 rng( t );
+            std::uint64_t s2 = 0;
+
+            for( unsigned i = 0; i < L / num_threads; ++i )
+            {
+                f( map, rng, i, s2 );
+            }
+
+            s += s2;
+        });
+    }
+
+    for( auto& th: threads ) th.join();
+
+    auto t1 = clock_type::now();
+    auto c1 = std::clock();
+
+    auto ms = ( t1 - t0 ) / 1ms + 1;
+    double cpu = static_cast<double>( c1 - c0 ) / CLOCKS_PER_SEC;
+
+    std::cout << std::setw( 10 ) << label << ", " << std::setw( 4 ) << num_threads << " threads: " << std::setw( 6 ) << L / 1000 / ms << " Mops/s, " << std::fixed << std::setprecision( 2 ) << std::setw( 7 ) << cpu * 1000 / ms << " CPUs busy (s=" << s.load() << ")\n";
+}
+
+int main( int argc, char* argv[] )
+{
+    if( argc > 1 ) max_factor = static_cast<unsigned>( std::strtoul( argv[ 1 ], nullptr, 10 ) );
+    if( max_factor == 0 ) max_factor = 1;
+
+    init_indices();
+
+    unsigned hw = std::thread::hardware_concurrency();
+    if( hw == 0 ) hw = 1;
+
+#if defined(BOOST_UNORDERED_ENABLE_FUTEX_LOCKS)
+    std::cout << "boost::concurrent_flat_map, BOOST_UNORDERED_ENABLE_FUTEX_LOCKS, " << hw << " hardware threads\n\n";
+#else
+    std::cout << "boost::concurrent_flat_map, " << hw << " hardware threads\n\n";
+#endif
+
+    for( unsigned k = 1; k <= max_factor; k *= 2 )
+    {
+        unsigned n = k * hw;
+
+        test( "lookup", n, []( map_type& map, boost::detail::splitmix64& rng, unsigned i, std::uint64_t& s2 ){
+
+            std::uint64_t key = indices[ rng() % N ];
+
+            if( i % 16 == 0 )
+            {
+                map.visit( key, []( auto& x ){ ++x.second; } );
+            }
+            else
+            {
+                map.cvisit( key, [&]( auto const& x ){ s2 += x.second; } );
+            }
+        });
+
+        test( "exclusive", n, []( map_type& map, boost::detail::splitmix64& rng, unsigned i, std::uint64_t& s2 ){
+
+            std::uint64_t key = indices[ rng() % N ];
+
+            if( i % 100'000 == 0 )
+            {
+                // switch between two capacities, blocking all other threads
+                // for the duration of the rehash
+                map.rehash( ( i / 100'000 % 2 + 1 ) * 2 * N );
+            }
+            else
+            {
+                map.cvisit( key, [&]( auto const& x ){ s2 += x.second; } );
+            }
+        });
+
+        std::cout << "\n";
+    }
+}
@@ -0,0 +1,128 @@
+// Copyright 2025 Joaquin M Lopez Munoz.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+// Throughput of a mixed workload (90% lookups, 10% updates) on
+// boost::concurrent_flat_map with 16, 64 and 128 threads, for uniformly
+// distributed and Zipf-distributed keys. Build with
+// BOOST_UNORDERED_CONCURRENT_GROUP_ACCESS_LAYOUT set to 0 (packed group
+// locks), 1 (one lock per cache line) and 2 (one lock per cache line of
+// group metadata) to compare.
+
+#define _SILENCE_CXX17_OLD_ALLOCATOR_MEMBERS_DEPRECATION_WARNING
+#define _SILENCE_CXX20_CISO646_REMOVED_WARNING
+
+#include <boost/unordered/concurrent_flat_map.hpp>
+#include <boost/core/detail/splitmix64.hpp>
+#include <boost/config.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+
+using namespace std::chrono_literals;
+
+constexpr unsigned N = 1'000'000; // distinct keys
+constexpr unsigned M = 16'000'000; // precomputed key sequence
+constexpr unsigned L = 4'000'000; // operations per thread
+
+static std::vector< std::uint64_t > keys;
+static std::vector< std::uint32_t > uniform_indices;
+static std::vector< std::uint32_t > zipf_indices;
+
+static void init_indices()
+{
+    boost::detail::splitmix64 rng;
+
+    for( unsigned i = 0; i < N; ++i )
+    {
+        keys.push_back( rng() );
+    }
+
+    // Zipf distribution with s = 1 by inversion of the cumulative distribution
+
+    std::vector<double> cdf( N );
+    double s = 0;
+
+    for( unsigned i = 0; i < N; ++i )
+    {
+        s += 1.0 / ( i + 1 );
+        cdf[ i ] = s;
+    }
+
+    for( unsigned i = 0; i < M; ++i )
+    {
+        uniform_indices.push_back( static_cast<std::uint32_t>( rng() % N ) );
+
+        double x = static_cast<double>( rng() >> 11 ) / 9007199254740992.0 * s; // [0, s)
+        zipf_indices.push_back( static_cast<std::uint32_t>( std::upper_bound( cdf.begin(), cdf.end() - 1, x ) - cdf.begin() ) );
+    }
+}
+
+using clock_type = std::chrono::steady_clock;
+
+using map_type = boost::concurrent_flat_map<std::uint64_t, std::uint64_t>;
+
+BOOST_NOINLINE void test( char const* label, std::vector< std::uint32_t > const& indices, unsigned num_threads )
+{
+    map_type map;
+
+    for( unsigned i = 0; i < N; ++i )
+    {
+        map.emplace( keys[ i ], 0 );
+    }
+
+    std::vector<std::thread> threads;
+    std::atomic<std::uint64_t> s{ 0 };
+
+    auto t0 = clock_type::now();
+
+    for( unsigned t = 0; t < num_threads; ++t )
+    {
+        threads.emplace_back( [&, t]{
+
+            std::uint64_t s2 = 0;
+            unsigned j = static_cast<unsigned>( ( std::uint64_t( t ) * M ) / num_threads );
+
+            for( unsigned i = 0; i < L; ++i, ++j )
+            {
+                std::uint64_t k = keys[ indices[ j % M ] ];
+
+                if( i % 10 == 0 )
+                {
+                    map.visit( k, []( auto& x ){ ++x.second; } );
+                }
+                else
+                {
+                    map.cvisit( k, [&]( auto const& x ){ s2 += x.second; } );
+                }
+            }
+
+            s += s2;
+        });
+    }
+
+    for( auto& th: threads ) th.join();
+
+    auto t1 = clock_type::now();
+
+    std::cout << std::setw( 8 ) << label << ", " << std::setw( 4 ) << num_threads << " threads: " << std::setw( 6 ) << num_threads * ( L / 1000 ) / ( ( t1 - t0 ) / 1ms + 1 ) << " Mops/s (s=" << s.load() << ")\n";
+}
+
+int main()
+{
+    init_indices();
+
+    std::cout << "boost::concurrent_flat_map, BOOST_UNORDERED_CONCURRENT_GROUP_ACCESS_LAYOUT=" << BOOST_UNORDERED_CONCURRENT_GROUP_ACCESS_LAYOUT << ", " << std::thread::hardware_concurrency() << " hardware threads\n\n";
+
+    for( unsigned n: { 16u, 64u, 128u } )
+    {
+        test( "uniform", uniform_indices, n );
+        test( "Zipf", zipf_indices, n );
+    }
+}
@@ -0,0 +1,129 @@
+// Copyright 2025 Joaquin M Lopez Munoz.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+// Random lookup throughput on a boost::unordered_flat_map<uint64_t, uint64_t>
+// whose bucket array is 1 GB+, with std::allocator and with
+// boost::huge_page_allocator (transparent huge pages). Optional arguments:
+// number of elements and "hugetlb" to use the reserved huge page pool
+// instead (see /proc/sys/vm/nr_hugepages).
+
+#define _SILENCE_CXX17_OLD_ALLOCATOR_MEMBERS_DEPRECATION_WARNING
+#define _SILENCE_CXX20_CISO646_REMOVED_WARNING
+
+#include <boost/unordered/unordered_flat_map.hpp>
+#include <boost/unordered/huge_page_allocator.hpp>
+#include <boost/core/detail/splitmix64.hpp>
+#include <boost/config.hpp>
+#include <vector>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <chrono>
+
+using namespace std::chrono_literals;
+
+static unsigned N = 40'000'000; // ~64M buckets, 1 GB of elements
+constexpr unsigned K = 20'000'000; // lookups
+
+static std::vector< std::uint64_t > indices;
+
+static void init_indices()
+{
+    boost::detail::splitmix64 rng;
+
+    for( unsigned i = 0; i < N; ++i )
+    {
+        indices.push_back( rng() );
+    }
+}
+
+using clock_type = std::chrono::steady_clock;
+
+// kB of anonymous memory backed by transparent huge pages, if available
+
+static std::string anon_huge_pages()
+{
+    std::ifstream is( "/proc/self/smaps_rollup" );
+    std::string line;
+
+    while( std::getline( is, line ) )
+    {
+        if( line.compare( 0, 14, "AnonHugePages:" ) == 0 ) return line.substr( 14 );
+    }
+
+    return " n/a";
+}
+
+template<class Map> BOOST_NOINLINE void test( char const* label, Map& map )
+{
+    std::cout << label << ":\n";
+
+    auto t0 = clock_type::now();
+
+    for( unsigned i = 0; i < N; ++i )
+    {
+        map.emplace( indices[ i ], i );
+    }
+
+    auto t1 = clock_type::now();
+
+    std::cout << "  Insertion: " << ( t1 - t0 ) / 1ms << " ms (size=" << map.size() << ", bucket_count=" << map.bucket_count() << ")\n";
+    std::cout << "  AnonHugePages:" << anon_huge_pages() << "\n";
+
+    boost::detail::splitmix64 rng( 42 );
+    std::uint64_t s = 0;
+
+    t0 = clock_type::now();
+
+    for( unsigned i = 0; i < K; ++i )
+    {
+        s += map.find( indices[ rng() % N ] )->second;
+    }
+
+    t1 = clock_type::now();
+
+    std::cout << "  Successful lookup: " << ( t1 - t0 ) / 1ms << " ms, " << ( t1 - t0 ) / 1ns / K << " ns/lookup (s=" << s << ")\n";
+
+    t0 = clock_type::now();
+
+    for( unsigned i = 0; i < K; ++i )
+    {
+        s += map.count( rng() );
+    }
+
+    t1 = clock_type::now();
+
+    std::cout << "  Unsuccessful lookup: " << ( t1 - t0 ) / 1ms << " ms, " << ( t1 - t0 ) / 1ns / K << " ns/lookup (s=" << s << ")\n\n";
+}
+
+int main( int argc, char* argv[] )
+{
+    bool hugetlb = false;
+
+    for( int i = 1; i < argc; ++i )
+    {
+        if( std::strcmp( argv[ i ], "hugetlb" ) == 0 ) hugetlb = true;
+        else N = static_cast<unsigned>( std::strtoul( argv[ i ], nullptr, 10 ) );
+    }
+
+    init_indices();
+
+    {
+        boost::unordered_flat_map<std::uint64_t, std::uint64_t> map;
+        test( "std::allocator", map );
+    }
+
+    {
+        using allocator_type = boost::huge_page_allocator< std::pair<std::uint64_t const, std::uint64_t> >;
+
+        boost::huge_page_options opts;
+        opts.hugetlb = hugetlb;
+
+        boost::unordered_flat_map<std::uint64_t, std::uint64_t, boost::hash<std::uint64_t>, std::equal_to<std::uint64_t>, allocator_type> map( 0, boost::hash<std::uint64_t>(), std::equal_to<std::uint64_t>(), allocator_type( opts ) );
+        test( hugetlb? "boost::huge_page_allocator (hugetlb)": "boost::huge_page_allocator", map );
+    }
+}
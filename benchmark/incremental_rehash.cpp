@@ -0,0 +1,120 @@
+// Copyright 2025 Joaquin M Lopez Munoz.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+// Per-insertion latency distribution of boost::unordered_flat_map. Build once
+// without and once with BOOST_UNORDERED_ENABLE_INCREMENTAL_REHASH: the tail
+// of the distribution (rehash spikes) should shrink in the latter, at the
+// expense of somewhat slower lookups while migrations are in progress.
+
+#define _SILENCE_CXX17_OLD_ALLOCATOR_MEMBERS_DEPRECATION_WARNING
+#define _SILENCE_CXX20_CISO646_REMOVED_WARNING
+
+#include <boost/unordered/unordered_flat_map.hpp>
+#include <boost/core/detail/splitmix64.hpp>
+#include <boost/config.hpp>
+#include <algorithm>
+#include <vector>
+#include <cstdint>
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+
+using namespace std::chrono_literals;
+
+constexpr unsigned N = 20'000'000;
+
+static std::vector< std::uint64_t > indices;
+
+static void init_indices()
+{
+    boost::detail::splitmix64 rng;
+
+    for( unsigned i = 0; i < N; ++i )
+    {
+        indices.push_back( rng() );
+    }
+}
+
+using clock_type = std::chrono::steady_clock;
+
+static void print_percentile( std::vector<std::uint64_t> const& latencies, char const* label, double p )
+{
+    auto i = static_cast<std::size_t>( p * static_cast<double>( latencies.size() - 1 ) );
+    std::cout << std::setw( 8 ) << label << ": " << std::setw( 12 ) << latencies[ i ] << " ns\n";
+}
+
+int main()
+{
+    init_indices();
+
+#if defined(BOOST_UNORDERED_ENABLE_INCREMENTAL_REHASH)
+    std::cout << "boost::unordered_flat_map, incremental rehash\n\n";
+#else
+    std::cout << "boost::unordered_flat_map\n\n";
+#endif
+
+    std::vector<std::uint64_t> latencies;
+    latencies.reserve( N );
+
+    boost::unordered_flat_map<std::uint64_t, std::uint64_t> map;
+
+    auto t0 = clock_type::now();
+
+    for( unsigned i = 0; i < N; ++i )
+    {
+        auto t1 = clock_type::now();
+        map.emplace( indices[ i ], i );
+        auto t2 = clock_type::now();
+
+        latencies.push_back( static_cast<std::uint64_t>( ( t2 - t1 ) / 1ns ) );
+    }
+
+    auto t1 = clock_type::now();
+    std::cout << "Insertion: " << ( t1 - t0 ) / 1ms << " ms (size=" << map.size() << ")\n";
+
+    std::uint64_t s = 0;
+
+    for( auto i: indices )
+    {
+        auto it = map.find( i + 1 );
+        if( it != map.end() ) s += it->second;
+    }
+
+    for( auto i: indices )
+    {
+        s += map.find( i )->second;
+    }
+
+    auto t2 = clock_type::now();
+    std::cout << "Lookup: " << ( t2 - t1 ) / 1ms << " ms (s=" << s << ")\n\n";
+
+    // latency histogram in powers of two
+
+    std::vector<std::size_t> histogram( 64 );
+
+    for( auto l: latencies )
+    {
+        std::size_t b = 0;
+        while( ( std::uint64_t( 1 ) << ( b + 1 ) ) <= l ) ++b;
+        ++histogram[ b ];
+    }
+
+    for( std::size_t b = 0; b < histogram.size(); ++b )
+    {
+        if( histogram[ b ] )
+        {
+            std::cout << "[" << std::setw( 10 ) << ( std::uint64_t( 1 ) << b ) << ", " << std::setw( 10 ) << ( std::uint64_t( 1 ) << ( b + 1 ) ) << ") ns: " << histogram[ b ] << "\n";
+        }
+    }
+
+    std::cout << "\n";
+
+    std::sort( latencies.begin(), latencies.end() );
+
+    print_percentile( latencies, "p50", 0.5 );
+    print_percentile( latencies, "p99", 0.99 );
+    print_percentile( latencies, "p99.9", 0.999 );
+    print_percentile( latencies, "p99.99", 0.9999 );
+    print_percentile( latencies, "max", 1.0 );
+}
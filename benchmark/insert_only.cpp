@@ -0,0 +1,97 @@
+// Copyright 2025 Joaquin M Lopez Munoz.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+// Deduplication (insertion of keys with many repetitions, interleaved with
+// lookups) with boost::concurrent_flat_set vs.
+// boost::concurrent_insert_only_flat_set for 1 to 128 threads.
+
+#define _SILENCE_CXX17_OLD_ALLOCATOR_MEMBERS_DEPRECATION_WARNING
+#define _SILENCE_CXX20_CISO646_REMOVED_WARNING
+
+#include <boost/unordered/concurrent_flat_set.hpp>
+#include <boost/unordered/concurrent_insert_only_flat_set.hpp>
+#include <boost/core/detail/splitmix64.hpp>
+#include <boost/config.hpp>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+
+using namespace std::chrono_literals;
+
+constexpr unsigned N = 1'000'000; // distinct keys
+constexpr unsigned L = 16'000'000; // total operations
+
+static std::vector< std::uint64_t > indices;
+
+static void init_indices()
+{
+    boost::detail::splitmix64 rng;
+
+    for( unsigned i = 0; i < N; ++i )
+    {
+        indices.push_back( rng() );
+    }
+}
+
+using clock_type = std::chrono::steady_clock;
+
+template<class Set> BOOST_NOINLINE void test( char const* label, unsigned num_threads )
+{
+    Set set;
+
+    std::vector<std::thread> threads;
+    std::atomic<std::uint64_t> s{ 0 };
+
+    auto t0 = clock_type::now();
+
+    for( unsigned t = 0; t < num_threads; ++t )
+    {
+        threads.emplace_back( [&, t]{
+
+            boost::detail::splitmix64 rng( t );
+            std::uint64_t s2 = 0;
+
+            for( unsigned i = 0; i < L / num_threads; ++i )
+            {
+                std::uint64_t key = indices[ rng() % N ];
+
+                if( i % 4 == 0 )
+                {
+                    s2 += set.contains( key );
+                }
+                else
+                {
+                    s2 += set.insert( key );
+                }
+            }
+
+            s += s2;
+        });
+    }
+
+    for( auto& th: threads ) th.join();
+
+    auto t1 = clock_type::now();
+
+    auto ms = ( t1 - t0 ) / 1ms + 1;
+
+    std::cout << std::setw( 35 ) << label << ", " << std::setw( 3 ) << num_threads << " threads: " << std::setw( 6 ) << L / 1000 / ms << " Mops/s (size=" << set.size() << ", s=" << s.load() << ")\n";
+}
+
+int main()
+{
+    init_indices();
+
+    for( unsigned n = 1; n <= 128; n *= 2 )
+    {
+        test< boost::concurrent_flat_set<std::uint64_t> >( "boost::concurrent_flat_set", n );
+        test< boost::concurrent_insert_only_flat_set<std::uint64_t> >( "boost::concurrent_insert_only_flat_set", n );
+
+        std::cout << "\n";
+    }
+}
@@ -0,0 +1,128 @@
+// Copyright 2025 Joaquin M Lopez Munoz.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+// Lookup throughput of boost::concurrent_flat_map with 1, 8, 32 and 128
+// threads, on a large map and on a small map where all threads hit the same
+// few bucket groups, both with and without a thread updating elements
+// concurrently. Build once without and once with
+// BOOST_UNORDERED_ENABLE_OPTIMISTIC_READS: in the latter, lookups do not
+// write to the group locks, which should improve scaling on the small map.
+
+#define _SILENCE_CXX17_OLD_ALLOCATOR_MEMBERS_DEPRECATION_WARNING
+#define _SILENCE_CXX20_CISO646_REMOVED_WARNING
+
+#include <boost/unordered/concurrent_flat_map.hpp>
+#include <boost/core/detail/splitmix64.hpp>
+#include <boost/config.hpp>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+
+using namespace std::chrono_literals;
+
+constexpr unsigned N = 1'000'000;
+constexpr unsigned L = 10'000'000; // lookups per thread
+
+static std::vector< std::uint64_t > indices;
+
+static void init_indices()
+{
+    boost::detail::splitmix64 rng;
+
+    for( unsigned i = 0; i < N; ++i )
+    {
+        indices.push_back( rng() );
+    }
+}
+
+using clock_type = std::chrono::steady_clock;
+
+using map_type = boost::concurrent_flat_map<std::uint64_t, std::uint64_t>;
+
+BOOST_NOINLINE void test( map_type& map, unsigned n, unsigned num_threads, bool update )
+{
+    std::vector<std::thread> threads;
+    std::atomic<std::uint64_t> s{ 0 };
+    std::atomic<bool> done{ false };
+
+    std::thread updater;
+
+    if( update )
+    {
+        updater = std::thread( [&]{
+
+            for( std::uint64_t i = 0; !done; ++i )
+            {
+                map.visit( indices[ i % n ], []( auto& x ){ ++x.second; } );
+            }
+        });
+    }
+
+    auto t0 = clock_type::now();
+
+    for( unsigned t = 0; t < num_threads; ++t )
+    {
+        threads.emplace_back( [&, t]{
+
+            boost::detail::splitmix64 rng( t );
+            std::uint64_t s2 = 0;
+
+            for( unsigned i = 0; i < L; ++i )
+            {
+                map.cvisit( indices[ rng() % n ], [&]( auto const& x ){ s2 += x.second; } );
+            }
+
+            s += s2;
+        });
+    }
+
+    for( auto& th: threads ) th.join();
+
+    auto t1 = clock_type::now();
+
+    done = true;
+    if( update ) updater.join();
+
+    std::cout << std::setw( 4 ) << num_threads << " threads: " << std::setw( 6 ) << num_threads * ( L / 1000 ) / ( ( t1 - t0 ) / 1ms + 1 ) << " Mlookups/s (s=" << s.load() << ")\n";
+}
+
+BOOST_NOINLINE void test( unsigned n, bool update )
+{
+    std::cout << "Successful lookup on a map with " << n << " elements" << ( update? ", one thread updating:\n": ":\n" );
+
+    map_type map;
+
+    for( unsigned i = 0; i < n; ++i )
+    {
+        map.emplace( indices[ i ], i );
+    }
+
+    for( unsigned num_threads: { 1u, 8u, 32u, 128u } )
+    {
+        test( map, n, num_threads, update );
+    }
+
+    std::cout << "\n";
+}
+
+int main()
+{
+    init_indices();
+
+#if defined(BOOST_UNORDERED_ENABLE_OPTIMISTIC_READS)
+    std::cout << "boost::concurrent_flat_map, optimistic reads";
+#else
+    std::cout << "boost::concurrent_flat_map";
+#endif
+
+    std::cout << ", " << std::thread::hardware_concurrency() << " hardware threads\n\n";
+
+    test( N, false );
+    test( 16, false );
+    test( 16, true );
+}
@@ -0,0 +1,96 @@
+// Copyright 2025 Joaquin M Lopez Munoz.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+// Cost of reserve(N) on a boost::unordered_flat_set<uint64_t> (startup time)
+// followed by the latency of the first insertions into the reserved table
+// (first-query latency), with std::allocator and the lazy_zero and populate
+// modes of boost::huge_page_allocator. Optional argument: N.
+
+#define _SILENCE_CXX17_OLD_ALLOCATOR_MEMBERS_DEPRECATION_WARNING
+#define _SILENCE_CXX20_CISO646_REMOVED_WARNING
+
+#include <boost/unordered/unordered_flat_set.hpp>
+#include <boost/unordered/huge_page_allocator.hpp>
+#include <boost/core/detail/splitmix64.hpp>
+#include <boost/config.hpp>
+#include <algorithm>
+#include <vector>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+
+using namespace std::chrono_literals;
+
+static std::size_t N = 100'000'000;
+constexpr unsigned K = 1'000'000; // first insertions
+
+using clock_type = std::chrono::steady_clock;
+
+template<class Set> BOOST_NOINLINE void test( char const* label, Set& set )
+{
+    std::cout << label << ":\n";
+
+    auto t0 = clock_type::now();
+
+    set.reserve( N );
+
+    auto t1 = clock_type::now();
+
+    std::cout << "  reserve: " << ( t1 - t0 ) / 1ms << " ms (bucket_count=" << set.bucket_count() << ")\n";
+
+    std::vector<std::uint64_t> latencies;
+    latencies.reserve( K );
+
+    boost::detail::splitmix64 rng;
+
+    for( unsigned i = 0; i < K; ++i )
+    {
+        auto x = rng();
+
+        auto t2 = clock_type::now();
+        set.insert( x );
+        auto t3 = clock_type::now();
+
+        latencies.push_back( static_cast<std::uint64_t>( ( t3 - t2 ) / 1ns ) );
+    }
+
+    auto t4 = clock_type::now();
+
+    std::cout << "  first " << K << " insertions: " << ( t4 - t1 ) / 1ms << " ms\n";
+    std::cout << "  reserve + insertions: " << ( t4 - t0 ) / 1ms << " ms\n";
+
+    std::sort( latencies.begin(), latencies.end() );
+
+    std::cout << "  p50: " << latencies[ K / 2 ] << " ns, p99: " << latencies[ K / 100 * 99 ] << " ns, max: " << latencies.back() << " ns\n\n";
+}
+
+using allocator_type = boost::huge_page_allocator<std::uint64_t>;
+using huge_set = boost::unordered_flat_set<std::uint64_t, boost::hash<std::uint64_t>, std::equal_to<std::uint64_t>, allocator_type>;
+
+static void test_huge( char const* label, bool lazy_zero, bool populate )
+{
+    boost::huge_page_options opts;
+    opts.lazy_zero = lazy_zero;
+    opts.populate = populate;
+
+    huge_set set( 0, boost::hash<std::uint64_t>(), std::equal_to<std::uint64_t>(), allocator_type( opts ) );
+    test( label, set );
+}
+
+int main( int argc, char* argv[] )
+{
+    if( argc > 1 ) N = std::strtoull( argv[ 1 ], nullptr, 10 );
+
+    {
+        boost::unordered_flat_set<std::uint64_t> set;
+        test( "std::allocator", set );
+    }
+
+    test_huge( "boost::huge_page_allocator", false, false );
+    test_huge( "boost::huge_page_allocator, lazy_zero", true, false );
+    test_huge( "boost::huge_page_allocator, populate", false, true );
+    test_huge( "boost::huge_page_allocator, lazy_zero + populate", true, true );
+}
@@ -0,0 +1,166 @@
+// Copyright 2025 Joaquin M Lopez Munoz.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+// Measures the operations affected by BOOST_UNORDERED_ENABLE_RUNTIME_DISPATCH
+// (full-table traversal on tables with different occupancies) plus lookup as
+// a control. Build once without the macro and once with it: the "sse2" run of
+// the latter should be on par with the baseline, and the "avx2" run shows the
+// gain when the CPU supports it.
+
+#define _SILENCE_CXX17_OLD_ALLOCATOR_MEMBERS_DEPRECATION_WARNING
+#define _SILENCE_CXX20_CISO646_REMOVED_WARNING
+
+#include <boost/unordered/unordered_flat_map.hpp>
+#include <boost/core/detail/splitmix64.hpp>
+#include <boost/config.hpp>
+#include <vector>
+#include <cstdint>
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+
+using namespace std::chrono_literals;
+
+static void print_time( std::chrono::steady_clock::time_point & t1, char const* label, std::uint64_t s, std::size_t size )
+{
+    auto t2 = std::chrono::steady_clock::now();
+
+    std::cout << label << ": " << ( t2 - t1 ) / 1ms << " ms (s=" << s << ", size=" << size << ")\n";
+
+    t1 = t2;
+}
+
+constexpr unsigned N = 4'000'000;
+constexpr int K = 10;
+
+static std::vector< std::uint64_t > indices;
+
+static void init_indices()
+{
+    boost::detail::splitmix64 rng;
+
+    for( unsigned i = 0; i < N; ++i )
+    {
+        indices.push_back( rng() );
+    }
+}
+
+using map_type = boost::unordered_flat_map<std::uint64_t, std::uint64_t>;
+
+template<class Map> BOOST_NOINLINE void test_copy( Map const& map, std::chrono::steady_clock::time_point & t1 )
+{
+    std::uint64_t s = 0;
+
+    for( int j = 0; j < K; ++j )
+    {
+        Map map2( map );
+        s += map2.size();
+    }
+
+    print_time( t1, "Copy construction", s, map.size() );
+}
+
+template<class Map> BOOST_NOINLINE void test_erase_if( Map& map, std::chrono::steady_clock::time_point & t1 )
+{
+    std::uint64_t s = 0;
+
+    for( int j = 0; j < K; ++j )
+    {
+        // traverses the whole table without erasing anything
+        std::uint64_t s2 = 0;
+        erase_if( map, [&]( typename Map::value_type const& x ) { s2 += x.second; return false; } );
+        s += s2;
+    }
+
+    print_time( t1, "Traversal with erase_if", s, map.size() );
+}
+
+template<class Map> BOOST_NOINLINE void test_lookup( Map& map, std::chrono::steady_clock::time_point & t1 )
+{
+    std::uint64_t s = 0;
+
+    for( int j = 0; j < K; ++j )
+    {
+        for( auto i: indices )
+        {
+            auto it = map.find( i );
+            if( it != map.end() ) s += it->second;
+        }
+    }
+
+    print_time( t1, "Lookup", s, map.size() );
+}
+
+struct record
+{
+    std::string label_;
+    long long time_;
+};
+
+static std::vector<record> times;
+
+static void test( std::string const& label, unsigned divisor )
+{
+    std::cout << label << ", 1/" << divisor << " occupancy" << std::endl;
+
+    map_type map;
+    map.reserve( N );
+
+    for( unsigned i = 0; i < N / divisor; ++i )
+    {
+        map.emplace( indices[ i ], i );
+    }
+
+    auto t0 = std::chrono::steady_clock::now();
+    auto t1 = t0;
+
+    test_copy( map, t1 );
+    test_erase_if( map, t1 );
+    test_lookup( map, t1 );
+
+    auto tN = std::chrono::steady_clock::now();
+    std::cout << "Total: " << ( tN - t0 ) / 1ms << " ms\n\n";
+
+    times.push_back( { label + ", 1/" + std::to_string( divisor ), ( tN - t0 ) / 1ms } );
+}
+
+static void test_all( std::string const& label )
+{
+    for( unsigned divisor: { 1u, 4u, 16u, 64u } )
+    {
+        test( label, divisor );
+    }
+}
+
+int main()
+{
+    init_indices();
+
+#if defined(BOOST_UNORDERED_RUNTIME_DISPATCH)
+
+    bool avx2 = boost::unordered::detail::foa::cpu_features<>::avx2;
+
+    boost::unordered::detail::foa::cpu_features<>::avx2 = false;
+    test_all( "runtime dispatch, sse2" );
+
+    if( avx2 )
+    {
+        boost::unordered::detail::foa::cpu_features<>::avx2 = true;
+        test_all( "runtime dispatch, avx2" );
+    }
+
+#else
+
+    test_all( "baseline" );
+
+#endif
+
+    std::cout << "---\n\n";
+
+    for( auto const& x: times )
+    {
+        std::cout << std::setw( 36 ) << ( x.label_ + ": " ) << std::setw( 5 ) << x.time_ << " ms\n";
+    }
+}
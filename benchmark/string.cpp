@@ -383,7 +383,15 @@ int main()
     test<std_unordered_map>( "std::unordered_map" );
     test<boost_unordered_map>( "boost::unordered_map" );
     test<boost_unordered_node_map>( "boost::unordered_node_map" );
+
+    // build with -mavx2 -DBOOST_UNORDERED_ENABLE_GROUP32 to compare the
+    // 31-slot AVX2 metadata group against the default 15-slot group
+
+#if defined(BOOST_UNORDERED_ENABLE_GROUP32) && defined(BOOST_UNORDERED_AVX2)
+    test<boost_unordered_flat_map>( "boost::unordered_flat_map, group32" );
+#else
     test<boost_unordered_flat_map>( "boost::unordered_flat_map" );
+#endif
 
 #ifdef HAVE_ANKERL_UNORDERED_DENSE
 
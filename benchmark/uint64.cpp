@@ -97,6 +97,43 @@ template<class Map> BOOST_NOINLINE void test_insert( Map& map, std::chrono::stea
     std::cout << std::endl;
 }
 
+template<class Map> BOOST_NOINLINE void test_bulk_insert( Map& map, std::chrono::steady_clock::time_point & t1 )
+{
+    constexpr unsigned B = 1024;
+
+    std::vector< std::pair<std::uint64_t, std::uint64_t> > block;
+    block.reserve( B );
+
+    auto insert = [&]( std::vector< std::uint64_t > const& indices )
+    {
+        for( unsigned i = 1; i <= N; i += B )
+        {
+            block.clear();
+
+            for( unsigned j = i; j < i + B && j <= N; ++j )
+            {
+                block.push_back( { indices[ j ], j } );
+            }
+
+            map.insert( block.begin(), block.end() );
+        }
+    };
+
+    insert( indices1 );
+
+    print_time( t1, "Consecutive bulk insert",  0, map.size() );
+
+    insert( indices2 );
+
+    print_time( t1, "Random bulk insert",  0, map.size() );
+
+    insert( indices3 );
+
+    print_time( t1, "Consecutive reversed bulk insert",  0, map.size() );
+
+    std::cout << std::endl;
+}
+
 template<class Map> BOOST_NOINLINE void test_lookup( Map& map, std::chrono::steady_clock::time_point & t1 )
 {
     std::uint64_t s;
@@ -143,6 +180,42 @@ template<class Map> BOOST_NOINLINE void test_lookup( Map& map, std::chrono::stea
     std::cout << std::endl;
 }
 
+template<class Map> BOOST_NOINLINE void test_bulk_lookup( Map& map, std::chrono::steady_clock::time_point & t1 )
+{
+    std::uint64_t s;
+
+    auto visit = [&]( auto const& x ) { s += x.second; };
+
+    s = 0;
+
+    for( int j = 0; j < K; ++j )
+    {
+        map.visit( indices1.begin() + 1, indices1.end(), visit );
+    }
+
+    print_time( t1, "Consecutive bulk lookup",  s, map.size() );
+
+    s = 0;
+
+    for( int j = 0; j < K; ++j )
+    {
+        map.visit( indices2.begin() + 1, indices2.end(), visit );
+    }
+
+    print_time( t1, "Random bulk lookup",  s, map.size() );
+
+    s = 0;
+
+    for( int j = 0; j < K; ++j )
+    {
+        map.visit( indices3.begin() + 1, indices3.end(), visit );
+    }
+
+    print_time( t1, "Consecutive reversed bulk lookup",  s, map.size() );
+
+    std::cout << std::endl;
+}
+
 template<class Map> BOOST_NOINLINE void test_iteration( Map& map, std::chrono::steady_clock::time_point & t1 )
 {
     auto it = map.begin();
@@ -197,6 +270,23 @@ template<class Map> BOOST_NOINLINE void test_erase( Map& map, std::chrono::stead
     std::cout << std::endl;
 }
 
+template<class Map> BOOST_NOINLINE void test_bulk_erase( Map& map, std::chrono::steady_clock::time_point & t1 )
+{
+    map.erase_bulk( indices1.begin() + 1, indices1.begin() + N + 1 );
+
+    print_time( t1, "Consecutive bulk erase",  0, map.size() );
+
+    map.erase_bulk( indices2.begin() + 1, indices2.begin() + N + 1 );
+
+    print_time( t1, "Random bulk erase",  0, map.size() );
+
+    map.erase_bulk( indices3.begin() + 1, indices3.begin() + N + 1 );
+
+    print_time( t1, "Consecutive reversed bulk erase",  0, map.size() );
+
+    std::cout << std::endl;
+}
+
 // counting allocator
 
 static std::size_t s_alloc_bytes = 0;
@@ -251,7 +341,7 @@ struct record
 
 static std::vector<record> times;
 
-template<template<class...> class Map> BOOST_NOINLINE void test( char const* label )
+template<template<class...> class Map, bool Bulk = false> BOOST_NOINLINE void test( char const* label )
 {
     std::cout << label << ":\n\n";
 
@@ -263,16 +353,33 @@ template<template<class...> class Map> BOOST_NOINLINE void test( char const* lab
     auto t0 = std::chrono::steady_clock::now();
     auto t1 = t0;
 
-    test_insert( map, t1 );
+    if constexpr( Bulk )
+    {
+        test_bulk_insert( map, t1 );
+    }
+    else
+    {
+        test_insert( map, t1 );
+    }
 
     std::cout << "Memory: " << s_alloc_bytes << " bytes in " << s_alloc_count << " allocations\n\n";
 
     record rec = { label, 0, s_alloc_bytes, s_alloc_count };
 
-    test_lookup( map, t1 );
-    test_iteration( map, t1 );
-    test_lookup( map, t1 );
-    test_erase( map, t1 );
+    if constexpr( Bulk )
+    {
+        test_bulk_lookup( map, t1 );
+        test_iteration( map, t1 );
+        test_bulk_lookup( map, t1 );
+        test_bulk_erase( map, t1 );
+    }
+    else
+    {
+        test_lookup( map, t1 );
+        test_iteration( map, t1 );
+        test_lookup( map, t1 );
+        test_erase( map, t1 );
+    }
 
     auto tN = std::chrono::steady_clock::now();
     std::cout << "Total: " << ( tN - t0 ) / 1ms << " ms\n\n";
@@ -331,7 +438,17 @@ int main()
 
     test<boost_unordered_map>( "boost::unordered_map" );
     test<boost_unordered_node_map>( "boost::unordered_node_map" );
+
+    // build with -mavx2 -DBOOST_UNORDERED_ENABLE_GROUP32 to compare the
+    // 31-slot AVX2 metadata group against the default 15-slot group
+
+#if defined(BOOST_UNORDERED_ENABLE_GROUP32) && defined(BOOST_UNORDERED_AVX2)
+    test<boost_unordered_flat_map>( "boost::unordered_flat_map, group32" );
+#else
     test<boost_unordered_flat_map>( "boost::unordered_flat_map" );
+#endif
+
+    test<boost_unordered_flat_map, true>( "boost::unordered_flat_map, bulk" );
 
 #ifdef HAVE_ANKERL_UNORDERED_DENSE
 
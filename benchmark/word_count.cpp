@@ -83,6 +83,38 @@ template<class Map> BOOST_NOINLINE void test_word_count( Map& map, std::chrono::
     std::cout << std::endl;
 }
 
+template<class Map> BOOST_NOINLINE void test_bulk_word_count( Map& map, std::chrono::steady_clock::time_point & t1 )
+{
+    constexpr std::size_t B = 1024;
+
+    std::size_t s = 0;
+
+    std::vector< std::pair<std::string_view, std::size_t> > block;
+    std::vector< std::string_view > keys;
+
+    block.reserve( B );
+    keys.reserve( B );
+
+    for( std::size_t i = 0; i < words.size(); i += B )
+    {
+        block.clear();
+        keys.clear();
+
+        for( std::size_t j = i; j < i + B && j < words.size(); ++j )
+        {
+            block.push_back( { words[ j ], 0 } );
+            keys.push_back( words[ j ] );
+        }
+
+        map.insert( block.begin(), block.end() );
+        s += map.visit( keys.begin(), keys.end(), []( auto& x ) { ++x.second; } );
+    }
+
+    print_time( t1, "Bulk word count", s, map.size() );
+
+    std::cout << std::endl;
+}
+
 template<class Map> BOOST_NOINLINE void test_contains( Map& map, std::chrono::steady_clock::time_point & t1 )
 {
     std::size_t s = 0;
@@ -100,6 +132,39 @@ template<class Map> BOOST_NOINLINE void test_contains( Map& map, std::chrono::st
     std::cout << std::endl;
 }
 
+template<class Map> BOOST_NOINLINE void test_bulk_contains( Map& map, std::chrono::steady_clock::time_point & t1 )
+{
+    constexpr std::size_t B = 1024;
+
+    std::size_t s = 0;
+
+    std::vector< std::string_view > keys;
+    bool found[ B ];
+
+    keys.reserve( B );
+
+    for( std::size_t i = 0; i < words.size(); i += B )
+    {
+        keys.clear();
+
+        for( std::size_t j = i; j < i + B && j < words.size(); ++j )
+        {
+            std::string_view w2( words[ j ] );
+            w2.remove_prefix( 1 );
+
+            keys.push_back( w2 );
+        }
+
+        auto last = map.contains( keys.begin(), keys.end(), found );
+
+        for( auto p = found; p != last; ++p ) s += *p;
+    }
+
+    print_time( t1, "Bulk contains", s, map.size() );
+
+    std::cout << std::endl;
+}
+
 template<class Map> BOOST_NOINLINE void test_count( Map& map, std::chrono::steady_clock::time_point & t1 )
 {
     std::size_t s = 0;
@@ -190,7 +255,7 @@ struct record
 
 static std::vector<record> times;
 
-template<template<class...> class Map> BOOST_NOINLINE void test( char const* label )
+template<template<class...> class Map, bool Bulk = false> BOOST_NOINLINE void test( char const* label )
 {
     std::cout << label << ":\n\n";
 
@@ -202,13 +267,28 @@ template<template<class...> class Map> BOOST_NOINLINE void test( char const* lab
     auto t0 = std::chrono::steady_clock::now();
     auto t1 = t0;
 
-    test_word_count( map, t1 );
+    if constexpr( Bulk )
+    {
+        test_bulk_word_count( map, t1 );
+    }
+    else
+    {
+        test_word_count( map, t1 );
+    }
 
     std::cout << "Memory: " << s_alloc_bytes << " bytes in " << s_alloc_count << " allocations\n\n";
 
     record rec = { label, 0, s_alloc_bytes, s_alloc_count };
 
-    test_contains( map, t1 );
+    if constexpr( Bulk )
+    {
+        test_bulk_contains( map, t1 );
+    }
+    else
+    {
+        test_contains( map, t1 );
+    }
+
     test_count( map, t1 );
     test_iteration( map, t1 );
 
@@ -338,6 +418,7 @@ int main()
     test<boost_unordered_map>( "boost::unordered_map" );
     test<boost_unordered_node_map>( "boost::unordered_node_map" );
     test<boost_unordered_flat_map>( "boost::unordered_flat_map" );
+    test<boost_unordered_flat_map, true>( "boost::unordered_flat_map, bulk" );
 
 #ifdef HAVE_ANKERL_UNORDERED_DENSE
 
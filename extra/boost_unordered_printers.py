@@ -113,7 +113,7 @@ class BoostUnorderedFoaTableCoreCumulativeStatsPrinter:
 
     def children(self):
         def generator():
-            members = ["insertion", "successful_lookup", "unsuccessful_lookup"]
+            members = ["insertion", "successful_lookup", "unsuccessful_lookup", "rehash", "in_place_rehash", "shrink"]
             for member in members:
                 yield "", member
                 yield "", self.val[member]
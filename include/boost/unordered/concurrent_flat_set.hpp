@@ -71,6 +71,7 @@ namespace boost {
       using const_pointer =
         typename boost::allocator_const_pointer<allocator_type>::type;
       static constexpr size_type bulk_visit_size = table_type::bulk_visit_size;
+      using cursor = typename table_type::cursor;
 
 #if defined(BOOST_UNORDERED_ENABLE_STATS)
       using stats = typename table_type::stats;
@@ -275,6 +276,57 @@ namespace boost {
         return table_.visit(std::forward<K>(k), f);
       }
 
+      template <class F>
+      BOOST_FORCEINLINE size_type visit(
+        key_type const& k, precomputed_hash hash, F f)
+      {
+        BOOST_UNORDERED_STATIC_ASSERT_CONST_INVOCABLE(F)
+        return table_.visit(k, hash, f);
+      }
+
+      template <class F>
+      BOOST_FORCEINLINE size_type visit(
+        key_type const& k, precomputed_hash hash, F f) const
+      {
+        BOOST_UNORDERED_STATIC_ASSERT_CONST_INVOCABLE(F)
+        return table_.visit(k, hash, f);
+      }
+
+      template <class F>
+      BOOST_FORCEINLINE size_type cvisit(
+        key_type const& k, precomputed_hash hash, F f) const
+      {
+        BOOST_UNORDERED_STATIC_ASSERT_CONST_INVOCABLE(F)
+        return table_.visit(k, hash, f);
+      }
+
+      template <class K, class F>
+      BOOST_FORCEINLINE typename std::enable_if<
+        detail::are_transparent<K, hasher, key_equal>::value, size_type>::type
+      visit(K const& k, precomputed_hash hash, F f)
+      {
+        BOOST_UNORDERED_STATIC_ASSERT_CONST_INVOCABLE(F)
+        return table_.visit(k, hash, f);
+      }
+
+      template <class K, class F>
+      BOOST_FORCEINLINE typename std::enable_if<
+        detail::are_transparent<K, hasher, key_equal>::value, size_type>::type
+      visit(K const& k, precomputed_hash hash, F f) const
+      {
+        BOOST_UNORDERED_STATIC_ASSERT_CONST_INVOCABLE(F)
+        return table_.visit(k, hash, f);
+      }
+
+      template <class K, class F>
+      BOOST_FORCEINLINE typename std::enable_if<
+        detail::are_transparent<K, hasher, key_equal>::value, size_type>::type
+      cvisit(K const& k, precomputed_hash hash, F f) const
+      {
+        BOOST_UNORDERED_STATIC_ASSERT_CONST_INVOCABLE(F)
+        return table_.visit(k, hash, f);
+      }
+
       template<class FwdIterator, class F>
       BOOST_FORCEINLINE
       size_t visit(FwdIterator first, FwdIterator last, F f)
@@ -370,6 +422,27 @@ namespace boost {
         return table_.cvisit_while(f);
       }
 
+      template <class F>
+      cursor visit_range(cursor c, size_type max_groups, F f)
+      {
+        BOOST_UNORDERED_STATIC_ASSERT_CONST_INVOCABLE(F)
+        return table_.visit_range(c, max_groups, f);
+      }
+
+      template <class F>
+      cursor visit_range(cursor c, size_type max_groups, F f) const
+      {
+        BOOST_UNORDERED_STATIC_ASSERT_CONST_INVOCABLE(F)
+        return table_.visit_range(c, max_groups, f);
+      }
+
+      template <class F>
+      cursor cvisit_range(cursor c, size_type max_groups, F f) const
+      {
+        BOOST_UNORDERED_STATIC_ASSERT_CONST_INVOCABLE(F)
+        return table_.cvisit_range(c, max_groups, f);
+      }
+
 #if defined(BOOST_UNORDERED_PARALLEL_ALGORITHMS)
       template <class ExecPolicy, class F>
       typename std::enable_if<detail::is_execution_policy<ExecPolicy>::value,
@@ -427,11 +500,7 @@ namespace boost {
       template <class InputIterator>
       size_type insert(InputIterator begin, InputIterator end)
       {
-        size_type count_elements = 0;
-        for (auto pos = begin; pos != end; ++pos, ++count_elements) {
-          table_.emplace(*pos);
-        }
-        return count_elements;
+        return table_.insert(begin, end);
       }
 
       size_type insert(std::initializer_list<value_type> ilist)
@@ -467,11 +536,7 @@ namespace boost {
       size_type insert_or_visit(InputIterator first, InputIterator last, F f)
       {
         BOOST_UNORDERED_STATIC_ASSERT_CONST_INVOCABLE(F)
-        size_type count_elements = 0;
-        for (; first != last; ++first, ++count_elements) {
-          table_.emplace_or_visit(*first, f);
-        }
-        return count_elements;
+        return table_.insert_or_visit(first, last, f);
       }
 
       template <class F>
@@ -509,11 +574,7 @@ namespace boost {
       size_type insert_or_cvisit(InputIterator first, InputIterator last, F f)
       {
         BOOST_UNORDERED_STATIC_ASSERT_CONST_INVOCABLE(F)
-        size_type count_elements = 0;
-        for (; first != last; ++first, ++count_elements) {
-          table_.emplace_or_cvisit(*first, f);
-        }
-        return count_elements;
+        return table_.insert_or_cvisit(first, last, f);
       }
 
       template <class F>
@@ -557,11 +618,7 @@ namespace boost {
       {
         BOOST_UNORDERED_STATIC_ASSERT_CONST_INVOCABLE(F1)
         BOOST_UNORDERED_STATIC_ASSERT_CONST_INVOCABLE(F2)
-        size_type count_elements = 0;
-        for (; first != last; ++first, ++count_elements) {
-          table_.emplace_and_visit(*first, f1, f2);
-        }
-        return count_elements;
+        return table_.insert_and_visit(first, last, f1, f2);
       }
 
       template <class F1, class F2>
@@ -607,11 +664,7 @@ namespace boost {
       {
         BOOST_UNORDERED_STATIC_ASSERT_CONST_INVOCABLE(F1)
         BOOST_UNORDERED_STATIC_ASSERT_CONST_INVOCABLE(F2)
-        size_type count_elements = 0;
-        for (; first != last; ++first, ++count_elements) {
-          table_.emplace_and_cvisit(*first, f1, f2);
-        }
-        return count_elements;
+        return table_.insert_and_cvisit(first, last, f1, f2);
       }
 
       template <class F1, class F2>
@@ -682,6 +735,20 @@ namespace boost {
         return table_.erase(std::forward<K>(k));
       }
 
+      BOOST_FORCEINLINE size_type erase(
+        key_type const& k, precomputed_hash hash)
+      {
+        return table_.erase(k, hash);
+      }
+
+      template <class K>
+      BOOST_FORCEINLINE typename std::enable_if<
+        detail::are_transparent<K, hasher, key_equal>::value, size_type>::type
+      erase(K const& k, precomputed_hash hash)
+      {
+        return table_.erase(k, hash);
+      }
+
       template <class F>
       BOOST_FORCEINLINE size_type erase_if(key_type const& k, F f)
       {
@@ -774,6 +841,12 @@ namespace boost {
       void rehash(size_type n) { table_.rehash(n); }
       void reserve(size_type n) { table_.reserve(n); }
 
+      /// Read-only Phase
+      ///
+      void freeze() { table_.freeze(); }
+      void thaw() { table_.thaw(); }
+      bool is_frozen() const noexcept { return table_.is_frozen(); }
+
 #if defined(BOOST_UNORDERED_ENABLE_STATS)
       /// Stats
       ///
@@ -791,6 +864,20 @@ namespace boost {
 
       hasher hash_function() const { return table_.hash_function(); }
       key_equal key_eq() const { return table_.key_eq(); }
+
+      precomputed_hash hash_function_mixed(key_type const& k) const
+      {
+        return table_.hash_function_mixed(k);
+      }
+
+      template <class K>
+      typename std::enable_if<
+        detail::are_transparent<K, hasher, key_equal>::value,
+        precomputed_hash>::type
+      hash_function_mixed(K const& k) const
+      {
+        return table_.hash_function_mixed(k);
+      }
     };
 
     template <class Key, class Hash, class KeyEqual, class Allocator>
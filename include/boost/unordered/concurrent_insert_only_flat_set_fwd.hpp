@@ -0,0 +1,66 @@
+/* Fast open-addressing concurrent insert-only hashset.
+ *
+ * Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/unordered for library home page.
+ */
+
+#ifndef BOOST_UNORDERED_CONCURRENT_INSERT_ONLY_FLAT_SET_FWD_HPP
+#define BOOST_UNORDERED_CONCURRENT_INSERT_ONLY_FLAT_SET_FWD_HPP
+
+#include <boost/config.hpp>
+#include <boost/container_hash/hash_fwd.hpp>
+
+#include <functional>
+#include <memory>
+
+#ifndef BOOST_NO_CXX17_HDR_MEMORY_RESOURCE
+#include <memory_resource>
+#endif
+
+namespace boost {
+  namespace unordered {
+
+    template <class Key, class Hash = boost::hash<Key>,
+      class Pred = std::equal_to<Key>,
+      class Allocator = std::allocator<Key> >
+    class concurrent_insert_only_flat_set;
+
+    template <class Key, class Hash, class KeyEqual, class Allocator>
+    bool operator==(
+      concurrent_insert_only_flat_set<Key, Hash, KeyEqual, Allocator> const&
+        lhs,
+      concurrent_insert_only_flat_set<Key, Hash, KeyEqual, Allocator> const&
+        rhs);
+
+    template <class Key, class Hash, class KeyEqual, class Allocator>
+    bool operator!=(
+      concurrent_insert_only_flat_set<Key, Hash, KeyEqual, Allocator> const&
+        lhs,
+      concurrent_insert_only_flat_set<Key, Hash, KeyEqual, Allocator> const&
+        rhs);
+
+    template <class Key, class Hash, class Pred, class Alloc>
+    void swap(concurrent_insert_only_flat_set<Key, Hash, Pred, Alloc>& x,
+      concurrent_insert_only_flat_set<Key, Hash, Pred, Alloc>& y)
+      noexcept(noexcept(x.swap(y)));
+
+#ifndef BOOST_NO_CXX17_HDR_MEMORY_RESOURCE
+    namespace pmr {
+      template <class Key, class Hash = boost::hash<Key>,
+        class Pred = std::equal_to<Key> >
+      using concurrent_insert_only_flat_set =
+        boost::unordered::concurrent_insert_only_flat_set<Key, Hash, Pred,
+          std::pmr::polymorphic_allocator<Key> >;
+    } // namespace pmr
+#endif
+
+  } // namespace unordered
+
+  using boost::unordered::concurrent_insert_only_flat_set;
+} // namespace boost
+
+#endif // BOOST_UNORDERED_CONCURRENT_INSERT_ONLY_FLAT_SET_FWD_HPP
@@ -82,6 +82,7 @@ namespace boost {
       using insert_return_type =
         detail::foa::iteratorless_insert_return_type<node_type>;
       static constexpr size_type bulk_visit_size = table_type::bulk_visit_size;
+      using cursor = typename table_type::cursor;
 
 #if defined(BOOST_UNORDERED_ENABLE_STATS)
       using stats = typename table_type::stats;
@@ -283,6 +284,105 @@ namespace boost {
         return table_.visit(std::forward<K>(k), f);
       }
 
+      template <class F>
+      BOOST_FORCEINLINE size_type visit(
+        key_type const& k, precomputed_hash hash, F f)
+      {
+        BOOST_UNORDERED_STATIC_ASSERT_INVOCABLE(F)
+        return table_.visit(k, hash, f);
+      }
+
+      template <class F>
+      BOOST_FORCEINLINE size_type visit(
+        key_type const& k, precomputed_hash hash, F f) const
+      {
+        BOOST_UNORDERED_STATIC_ASSERT_CONST_INVOCABLE(F)
+        return table_.visit(k, hash, f);
+      }
+
+      template <class F>
+      BOOST_FORCEINLINE size_type cvisit(
+        key_type const& k, precomputed_hash hash, F f) const
+      {
+        BOOST_UNORDERED_STATIC_ASSERT_CONST_INVOCABLE(F)
+        return table_.visit(k, hash, f);
+      }
+
+      template <class K, class F>
+      BOOST_FORCEINLINE typename std::enable_if<
+        detail::are_transparent<K, hasher, key_equal>::value, size_type>::type
+      visit(K const& k, precomputed_hash hash, F f)
+      {
+        BOOST_UNORDERED_STATIC_ASSERT_INVOCABLE(F)
+        return table_.visit(k, hash, f);
+      }
+
+      template <class K, class F>
+      BOOST_FORCEINLINE typename std::enable_if<
+        detail::are_transparent<K, hasher, key_equal>::value, size_type>::type
+      visit(K const& k, precomputed_hash hash, F f) const
+      {
+        BOOST_UNORDERED_STATIC_ASSERT_CONST_INVOCABLE(F)
+        return table_.visit(k, hash, f);
+      }
+
+      template <class K, class F>
+      BOOST_FORCEINLINE typename std::enable_if<
+        detail::are_transparent<K, hasher, key_equal>::value, size_type>::type
+      cvisit(K const& k, precomputed_hash hash, F f) const
+      {
+        BOOST_UNORDERED_STATIC_ASSERT_CONST_INVOCABLE(F)
+        return table_.visit(k, hash, f);
+      }
+
+      template <class F>
+      BOOST_FORCEINLINE try_result try_visit(key_type const& k, F f)
+      {
+        BOOST_UNORDERED_STATIC_ASSERT_INVOCABLE(F)
+        return table_.try_visit(k, f);
+      }
+
+      template <class F>
+      BOOST_FORCEINLINE try_result try_visit(key_type const& k, F f) const
+      {
+        BOOST_UNORDERED_STATIC_ASSERT_CONST_INVOCABLE(F)
+        return table_.try_visit(k, f);
+      }
+
+      template <class F>
+      BOOST_FORCEINLINE try_result try_cvisit(key_type const& k, F f) const
+      {
+        BOOST_UNORDERED_STATIC_ASSERT_CONST_INVOCABLE(F)
+        return table_.try_visit(k, f);
+      }
+
+      template <class K, class F>
+      BOOST_FORCEINLINE typename std::enable_if<
+        detail::are_transparent<K, hasher, key_equal>::value, try_result>::type
+      try_visit(K&& k, F f)
+      {
+        BOOST_UNORDERED_STATIC_ASSERT_INVOCABLE(F)
+        return table_.try_visit(std::forward<K>(k), f);
+      }
+
+      template <class K, class F>
+      BOOST_FORCEINLINE typename std::enable_if<
+        detail::are_transparent<K, hasher, key_equal>::value, try_result>::type
+      try_visit(K&& k, F f) const
+      {
+        BOOST_UNORDERED_STATIC_ASSERT_CONST_INVOCABLE(F)
+        return table_.try_visit(std::forward<K>(k), f);
+      }
+
+      template <class K, class F>
+      BOOST_FORCEINLINE typename std::enable_if<
+        detail::are_transparent<K, hasher, key_equal>::value, try_result>::type
+      try_cvisit(K&& k, F f) const
+      {
+        BOOST_UNORDERED_STATIC_ASSERT_CONST_INVOCABLE(F)
+        return table_.try_visit(std::forward<K>(k), f);
+      }
+
       template<class FwdIterator, class F>
       BOOST_FORCEINLINE
       size_t visit(FwdIterator first, FwdIterator last, F f)
@@ -378,6 +478,27 @@ namespace boost {
         return table_.cvisit_while(f);
       }
 
+      template <class F>
+      cursor visit_range(cursor c, size_type max_groups, F f)
+      {
+        BOOST_UNORDERED_STATIC_ASSERT_INVOCABLE(F)
+        return table_.visit_range(c, max_groups, f);
+      }
+
+      template <class F>
+      cursor visit_range(cursor c, size_type max_groups, F f) const
+      {
+        BOOST_UNORDERED_STATIC_ASSERT_CONST_INVOCABLE(F)
+        return table_.visit_range(c, max_groups, f);
+      }
+
+      template <class F>
+      cursor cvisit_range(cursor c, size_type max_groups, F f) const
+      {
+        BOOST_UNORDERED_STATIC_ASSERT_CONST_INVOCABLE(F)
+        return table_.cvisit_range(c, max_groups, f);
+      }
+
 #if defined(BOOST_UNORDERED_PARALLEL_ALGORITHMS)
       template <class ExecPolicy, class F>
       typename std::enable_if<detail::is_execution_policy<ExecPolicy>::value,
@@ -428,11 +549,7 @@ namespace boost {
       template <class InputIterator>
       size_type insert(InputIterator begin, InputIterator end)
       {
-        size_type count_elements = 0;
-        for (auto pos = begin; pos != end; ++pos, ++count_elements) {
-          table_.emplace(*pos);
-        }
-        return count_elements;
+        return table_.insert(begin, end);
       }
 
       size_type insert(std::initializer_list<value_type> ilist)
@@ -502,11 +619,7 @@ namespace boost {
       size_type insert_or_visit(InputIterator first, InputIterator last, F f)
       {
         BOOST_UNORDERED_STATIC_ASSERT_INVOCABLE(F)
-        size_type count_elements = 0;
-        for (; first != last; ++first, ++count_elements) {
-          table_.emplace_or_visit(*first, f);
-        }
-        return count_elements;
+        return table_.insert_or_visit(first, last, f);
       }
 
       template <class F>
@@ -556,11 +669,7 @@ namespace boost {
       size_type insert_or_cvisit(InputIterator first, InputIterator last, F f)
       {
         BOOST_UNORDERED_STATIC_ASSERT_CONST_INVOCABLE(F)
-        size_type count_elements = 0;
-        for (; first != last; ++first, ++count_elements) {
-          table_.emplace_or_cvisit(*first, f);
-        }
-        return count_elements;
+        return table_.insert_or_cvisit(first, last, f);
       }
 
       template <class F>
@@ -614,11 +723,7 @@ namespace boost {
       {
         BOOST_UNORDERED_STATIC_ASSERT_INVOCABLE(F1)
         BOOST_UNORDERED_STATIC_ASSERT_INVOCABLE(F2)
-        size_type count_elements = 0;
-        for (; first != last; ++first, ++count_elements) {
-          table_.emplace_and_visit(*first, f1, f2);
-        }
-        return count_elements;
+        return table_.insert_and_visit(first, last, f1, f2);
       }
 
       template <class F1, class F2>
@@ -676,11 +781,7 @@ namespace boost {
       {
         BOOST_UNORDERED_STATIC_ASSERT_INVOCABLE(F1)
         BOOST_UNORDERED_STATIC_ASSERT_CONST_INVOCABLE(F2)
-        size_type count_elements = 0;
-        for (; first != last; ++first, ++count_elements) {
-          table_.emplace_and_cvisit(*first, f1, f2);
-        }
-        return count_elements;
+        return table_.insert_and_cvisit(first, last, f1, f2);
       }
 
       template <class F1, class F2>
@@ -907,6 +1008,103 @@ namespace boost {
           std::forward<Args>(args)...);
       }
 
+      template <class F>
+      bool compute_if_absent(key_type const& k, F factory)
+      {
+        return table_.compute_if_absent_or_cvisit(
+          k, factory, [](value_type const&) {});
+      }
+
+      template <class F> bool compute_if_absent(key_type&& k, F factory)
+      {
+        return table_.compute_if_absent_or_cvisit(
+          std::move(k), factory, [](value_type const&) {});
+      }
+
+      template <class F, class G>
+      bool compute_if_absent_or_visit(key_type const& k, F factory, G g)
+      {
+        BOOST_UNORDERED_STATIC_ASSERT_INVOCABLE(G)
+        return table_.compute_if_absent_or_visit(k, factory, g);
+      }
+
+      template <class F, class G>
+      bool compute_if_absent_or_cvisit(key_type const& k, F factory, G g)
+      {
+        BOOST_UNORDERED_STATIC_ASSERT_CONST_INVOCABLE(G)
+        return table_.compute_if_absent_or_cvisit(k, factory, g);
+      }
+
+      template <class F, class G>
+      bool compute_if_absent_or_visit(key_type&& k, F factory, G g)
+      {
+        BOOST_UNORDERED_STATIC_ASSERT_INVOCABLE(G)
+        return table_.compute_if_absent_or_visit(std::move(k), factory, g);
+      }
+
+      template <class F, class G>
+      bool compute_if_absent_or_cvisit(key_type&& k, F factory, G g)
+      {
+        BOOST_UNORDERED_STATIC_ASSERT_CONST_INVOCABLE(G)
+        return table_.compute_if_absent_or_cvisit(std::move(k), factory, g);
+      }
+
+      template <class Arg, class... Args>
+      BOOST_FORCEINLINE try_result try_visit_or_emplace(
+        key_type const& k, Arg&& arg, Args&&... args)
+      {
+        BOOST_UNORDERED_STATIC_ASSERT_LAST_ARG_INVOCABLE(Arg, Args...)
+        return table_.try_visit_or_emplace(
+          k, std::forward<Arg>(arg), std::forward<Args>(args)...);
+      }
+
+      template <class Arg, class... Args>
+      BOOST_FORCEINLINE try_result try_cvisit_or_emplace(
+        key_type const& k, Arg&& arg, Args&&... args)
+      {
+        BOOST_UNORDERED_STATIC_ASSERT_LAST_ARG_CONST_INVOCABLE(Arg, Args...)
+        return table_.try_cvisit_or_emplace(
+          k, std::forward<Arg>(arg), std::forward<Args>(args)...);
+      }
+
+      template <class Arg, class... Args>
+      BOOST_FORCEINLINE try_result try_visit_or_emplace(
+        key_type&& k, Arg&& arg, Args&&... args)
+      {
+        BOOST_UNORDERED_STATIC_ASSERT_LAST_ARG_INVOCABLE(Arg, Args...)
+        return table_.try_visit_or_emplace(
+          std::move(k), std::forward<Arg>(arg), std::forward<Args>(args)...);
+      }
+
+      template <class Arg, class... Args>
+      BOOST_FORCEINLINE try_result try_cvisit_or_emplace(
+        key_type&& k, Arg&& arg, Args&&... args)
+      {
+        BOOST_UNORDERED_STATIC_ASSERT_LAST_ARG_CONST_INVOCABLE(Arg, Args...)
+        return table_.try_cvisit_or_emplace(
+          std::move(k), std::forward<Arg>(arg), std::forward<Args>(args)...);
+      }
+
+      template <class K, class Arg, class... Args>
+      BOOST_FORCEINLINE typename std::enable_if<
+        detail::are_transparent<K, hasher, key_equal>::value, try_result>::type
+      try_visit_or_emplace(K&& k, Arg&& arg, Args&&... args)
+      {
+        BOOST_UNORDERED_STATIC_ASSERT_LAST_ARG_INVOCABLE(Arg, Args...)
+        return table_.try_visit_or_emplace(std::forward<K>(k),
+          std::forward<Arg>(arg), std::forward<Args>(args)...);
+      }
+
+      template <class K, class Arg, class... Args>
+      BOOST_FORCEINLINE typename std::enable_if<
+        detail::are_transparent<K, hasher, key_equal>::value, try_result>::type
+      try_cvisit_or_emplace(K&& k, Arg&& arg, Args&&... args)
+      {
+        BOOST_UNORDERED_STATIC_ASSERT_LAST_ARG_CONST_INVOCABLE(Arg, Args...)
+        return table_.try_cvisit_or_emplace(std::forward<K>(k),
+          std::forward<Arg>(arg), std::forward<Args>(args)...);
+      }
+
       BOOST_FORCEINLINE size_type erase(key_type const& k)
       {
         return table_.erase(k);
@@ -920,6 +1118,33 @@ namespace boost {
         return table_.erase(std::forward<K>(k));
       }
 
+      BOOST_FORCEINLINE size_type erase(
+        key_type const& k, precomputed_hash hash)
+      {
+        return table_.erase(k, hash);
+      }
+
+      template <class K>
+      BOOST_FORCEINLINE typename std::enable_if<
+        detail::are_transparent<K, hasher, key_equal>::value, size_type>::type
+      erase(K const& k, precomputed_hash hash)
+      {
+        return table_.erase(k, hash);
+      }
+
+      BOOST_FORCEINLINE try_result try_erase(key_type const& k)
+      {
+        return table_.try_erase(k);
+      }
+
+      template <class K>
+      BOOST_FORCEINLINE typename std::enable_if<
+        detail::are_transparent<K, hasher, key_equal>::value, try_result>::type
+      try_erase(K&& k)
+      {
+        return table_.try_erase(std::forward<K>(k));
+      }
+
       template <class F>
       BOOST_FORCEINLINE size_type erase_if(key_type const& k, F f)
       {
@@ -1047,6 +1272,12 @@ namespace boost {
       void rehash(size_type n) { table_.rehash(n); }
       void reserve(size_type n) { table_.reserve(n); }
 
+      /// Read-only Phase
+      ///
+      void freeze() { table_.freeze(); }
+      void thaw() { table_.thaw(); }
+      bool is_frozen() const noexcept { return table_.is_frozen(); }
+
 #if defined(BOOST_UNORDERED_ENABLE_STATS)
       /// Stats
       ///
@@ -1064,6 +1295,20 @@ namespace boost {
 
       hasher hash_function() const { return table_.hash_function(); }
       key_equal key_eq() const { return table_.key_eq(); }
+
+      precomputed_hash hash_function_mixed(key_type const& k) const
+      {
+        return table_.hash_function_mixed(k);
+      }
+
+      template <class K>
+      typename std::enable_if<
+        detail::are_transparent<K, hasher, key_equal>::value,
+        precomputed_hash>::type
+      hash_function_mixed(K const& k) const
+      {
+        return table_.hash_function_mixed(k);
+      }
     };
 
     template <class Key, class T, class Hash, class KeyEqual, class Allocator>
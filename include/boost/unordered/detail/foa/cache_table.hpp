@@ -0,0 +1,258 @@
+/* Fast open-addressing bounded cache.
+ *
+ * Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/unordered for library home page.
+ */
+
+#ifndef BOOST_UNORDERED_DETAIL_FOA_CACHE_TABLE_HPP
+#define BOOST_UNORDERED_DETAIL_FOA_CACHE_TABLE_HPP
+
+#include <boost/assert.hpp>
+#include <boost/config.hpp>
+#include <boost/core/allocator_access.hpp>
+#include <boost/unordered/detail/foa/table.hpp>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace boost{
+namespace unordered{
+namespace detail{
+namespace foa{
+
+#include <boost/unordered/detail/foa/ignore_wshadow.hpp>
+
+/* table with a maximum number of elements. Eviction state is kept in a side
+ * array of marks, one byte per slot, indexed by slot position; the hand is a
+ * slot position advancing in circular order over the occupied slots:
+ * nonzero marks are decremented, the first element with a zero mark is
+ * evicted. Lookup sets the mark of the element found to hit_mark and
+ * insertion sets it to insert_mark, which gives:
+ *
+ *   - CLOCK with hit_mark=insert_mark=1.
+ *   - SIEVE-like quick demotion with hit_mark=1, insert_mark=0: elements
+ *     not looked up again after insertion are the first to go.
+ *   - An approximate LRU with hit_mark>1 (recently hit elements survive
+ *     several turns of the hand).
+ *
+ * Once full, insertion evicts an element right after constructing the new
+ * one, as the arguments may refer to the element evicted: the table is
+ * never more than one element over the maximum size and doesn't grow.
+ * Anti-drift (see recover_slot) lowers ml as elements are erased; rather than
+ * letting the table rehash when ml reaches the maximum size, which would move
+ * elements away from their marks, overflow bits are recalculated without
+ * relocating any element. The table is reserved with some headroom over
+ * the maximum size so that this happens seldom.
+ */
+
+template<typename TypePolicy,typename Hash,typename Pred,typename Allocator>
+class cache_table:table<TypePolicy,Hash,Pred,Allocator>
+{
+  using super=table<TypePolicy,Hash,Pred,Allocator>;
+  using core=typename super::super;
+  using type_policy=typename super::type_policy;
+  using group_type=typename super::group_type;
+  using locator=typename super::locator;
+  using super::N;
+  using mark_allocator_type=
+    typename boost::allocator_rebind<Allocator,unsigned char>::type;
+
+public:
+  using key_type=typename super::key_type;
+  using init_type=typename super::init_type;
+  using value_type=typename super::value_type;
+  using element_type=typename super::element_type;
+  using hasher=typename super::hasher;
+  using key_equal=typename super::key_equal;
+  using allocator_type=typename super::allocator_type;
+  using size_type=typename super::size_type;
+  using iterator=typename super::iterator;
+  using const_iterator=typename super::const_iterator;
+
+  cache_table(
+    std::size_t max_size_,unsigned char hit_mark_,unsigned char insert_mark_,
+    const Hash& h_=Hash(),const Pred& pred_=Pred(),
+    const Allocator& al_=Allocator()):
+    super(0,h_,pred_,al_),
+    max_size{max_size_},hit_mark{hit_mark_},insert_mark{insert_mark_},
+    marks(mark_allocator_type(al_))
+  {
+    BOOST_ASSERT(max_size>0);
+    super::reserve(max_size+max_size/4+1); /* +1 for insertion when full */
+    marks.resize(core::capacity()+1);
+  }
+
+  cache_table(const cache_table&)=delete;
+  cache_table& operator=(const cache_table&)=delete;
+
+  using super::get_allocator;
+  using super::begin;
+  using super::end;
+  using super::cbegin;
+  using super::cend;
+  using super::empty;
+  using super::size;
+  using super::hash_function;
+  using super::key_eq;
+
+  std::size_t capacity()const noexcept{return max_size;}
+
+  template<typename Key>
+  BOOST_FORCEINLINE iterator find(const Key& x)
+  {
+    auto loc=core::find(x);
+    if(loc)touch(loc.p);
+    return super::make_iterator(loc);
+  }
+
+  template<typename Key>
+  BOOST_FORCEINLINE const_iterator find(const Key& x)const
+  {
+    return const_cast<cache_table*>(this)->find(x);
+  }
+
+  template<typename Key>
+  BOOST_FORCEINLINE std::size_t count(const Key& x)const
+  {
+    return find(x)!=end();
+  }
+
+  template<typename Key>
+  BOOST_FORCEINLINE bool contains(const Key& x)const
+  {
+    return find(x)!=end();
+  }
+
+  BOOST_FORCEINLINE std::pair<iterator,bool> insert(const init_type& x)
+  {
+    return emplace_impl(x);
+  }
+
+  BOOST_FORCEINLINE std::pair<iterator,bool> insert(init_type&& x)
+  {
+    return emplace_impl(std::move(x));
+  }
+
+  template<typename Key,typename... Args>
+  BOOST_FORCEINLINE std::pair<iterator,bool> try_emplace(
+    Key&& x,Args&&... args)
+  {
+    return emplace_impl(
+      try_emplace_args_t{},std::forward<Key>(x),std::forward<Args>(args)...);
+  }
+
+  template<typename Key,typename M>
+  BOOST_FORCEINLINE std::pair<iterator,bool> insert_or_assign(
+    Key&& x,M&& obj)
+  {
+    auto res=try_emplace(std::forward<Key>(x),std::forward<M>(obj));
+    if(!res.second)res.first->second=std::forward<M>(obj);
+    return res;
+  }
+
+  BOOST_FORCEINLINE void erase(const_iterator pos)noexcept
+  {
+    super::erase(pos);
+  }
+
+  template<typename Key>
+  BOOST_FORCEINLINE
+  auto erase(const Key& x) -> typename std::enable_if<
+    !std::is_convertible<Key,iterator>::value&&
+    !std::is_convertible<Key,const_iterator>::value, std::size_t>::type
+  {
+    auto loc=core::find(x);
+    if(!loc)return 0;
+    core::erase(loc.pg,loc.n,loc.p);
+    return 1;
+  }
+
+  using super::clear;
+
+private:
+  std::size_t index_of(const element_type* p)const noexcept
+  {
+    return static_cast<std::size_t>(p-this->arrays.elements());
+  }
+
+  BOOST_FORCEINLINE void touch(const element_type* p)
+  {
+    marks[index_of(p)]=hit_mark;
+  }
+
+  template<typename... Args>
+  BOOST_FORCEINLINE std::pair<iterator,bool> emplace_impl(Args&&... args)
+  {
+    const auto &k=this->key_from(std::forward<Args>(args)...);
+    auto        hash=this->hash_for(k);
+    auto        pos0=this->position_for(hash);
+    auto        loc=core::find(k,pos0,hash);
+
+    if(loc){
+      touch(loc.p);
+      return {super::make_iterator(loc),false};
+    }
+    if(BOOST_UNLIKELY(this->size_ctrl.size>=this->size_ctrl.ml)){
+      core::unchecked_recalculate_overflow();
+    }
+    loc=this->unchecked_emplace_at(pos0,hash,std::forward<Args>(args)...);
+    marks[index_of(loc.p)]=insert_mark;
+    if(BOOST_UNLIKELY(size()>max_size))evict(index_of(loc.p));
+    return {super::make_iterator(loc),true};
+  }
+
+  /* Advances the hand until an element with a zero mark other than the one
+   * at position skip is found, and erases it. Terminates in at most
+   * 1+max(hit_mark,insert_mark) turns.
+   */
+
+  BOOST_NOINLINE void evict(std::size_t skip)
+  {
+    BOOST_ASSERT(size()>1);
+
+    auto groups_size=this->arrays.groups_size_mask+1;
+    auto last=this->arrays.groups()+groups_size;
+    auto pos=(hand/N)&this->arrays.groups_size_mask;
+    auto n0=static_cast<unsigned int>(hand%N);
+    for(;;){
+      auto pg=this->arrays.groups()+pos;
+      auto p=this->arrays.elements()+pos*N;
+      auto mask=core::match_really_occupied(pg,last)&~((1<<n0)-1);
+      while(mask){
+        auto n=unchecked_countr_zero(mask);
+        auto& mark=marks[pos*N+n];
+        if(pos*N+n!=skip){
+          if(mark)--mark;
+          else{
+            core::erase(pg,n,p+n);
+            hand=pos*N+n+1;
+            return;
+          }
+        }
+        mask&=mask-1;
+      }
+      pos=(pos+1)&this->arrays.groups_size_mask;
+      n0=0;
+    }
+  }
+
+  std::size_t                                    max_size;
+  unsigned char                                  hit_mark;
+  unsigned char                                  insert_mark;
+  std::vector<unsigned char,mark_allocator_type> marks;
+  std::size_t                                    hand=0;
+};
+
+#include <boost/unordered/detail/foa/restore_wshadow.hpp>
+
+} /* namespace foa */
+} /* namespace detail */
+} /* namespace unordered */
+} /* namespace boost */
+
+#endif
@@ -0,0 +1,455 @@
+/* Fast open-addressing concurrent bounded cache.
+ *
+ * Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/unordered for library home page.
+ */
+
+#ifndef BOOST_UNORDERED_DETAIL_FOA_CONCURRENT_CACHE_TABLE_HPP
+#define BOOST_UNORDERED_DETAIL_FOA_CONCURRENT_CACHE_TABLE_HPP
+
+#include <atomic>
+#include <boost/config.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/unordered/detail/foa/concurrent_table.hpp>
+#include <boost/unordered/detail/foa/flat_cache_types.hpp>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <utility>
+
+namespace boost{
+namespace unordered{
+namespace detail{
+namespace foa{
+
+/* concurrent_table with a maximum number of elements and, optionally, a
+ * maximum total weight as given by a user-provided weigher (a byte budget,
+ * typically). Elements are cache_elements (see flat_cache_types) and
+ * eviction follows the CLOCK algorithm:
+ *
+ *   - Lookup sets the reference bit of the element found if not already
+ *     set (so that hot elements are not written to over and over), under
+ *     the same shared group lock as plain visitation.
+ *   - Insertion leaves the reference bit clear, so that elements not
+ *     looked up again are the first to go (scan resistance). If the cache
+ *     is then over budget, a hand is advanced over the groups of the table,
+ *     each visited under its exclusive group lock: referenced elements get
+ *     their bit cleared, unreferenced ones are erased until the cache is
+ *     within budget again. The hand is an atomic group index, so concurrent
+ *     insertions sweep different groups.
+ *   - Elements may have an expiry time (when a TTL is set): expired
+ *     elements are invisible to lookup and traversal, replaced by
+ *     insertion of equivalent elements and evicted first by the hand.
+ *
+ * Reference bits and expiry times are kept in the slot next to the value
+ * rather than in group metadata, as the latter has no spare bits and
+ * group_access is shared by all concurrent tables. Size may go over the
+ * maximum by the number of threads concurrently inserting before their
+ * sweeps catch up, so the table is reserved with some headroom over the
+ * maximum number of elements on construction and never grows. Anti-drift
+ * (see recover_slot) still lowers ml as elements are evicted: when ml is
+ * reached, overflow bits are recalculated in place under container-level
+ * write locking (see is_bounded), which does not move any element and is
+ * much cheaper than a rehash, but stalls other threads nonetheless. The
+ * headroom makes this happen more seldom.
+ */
+
+template<typename Key,typename T>
+struct is_bounded<flat_cache_types<Key,T>>:std::true_type{};
+
+template<typename TypePolicy,typename Hash,typename Pred,typename Allocator>
+class concurrent_cache_table:
+  concurrent_table<TypePolicy,Hash,Pred,Allocator>
+{
+  using super=concurrent_table<TypePolicy,Hash,Pred,Allocator>;
+  using type_policy=typename super::type_policy;
+  using group_type=typename super::group_type;
+  using group_exclusive=typename super::group_exclusive;
+  using super::N;
+
+public:
+  using key_type=typename super::key_type;
+  using init_type=typename super::init_type;
+  using value_type=typename super::value_type;
+  using element_type=typename super::element_type;
+  using hasher=typename super::hasher;
+  using key_equal=typename super::key_equal;
+  using allocator_type=typename super::allocator_type;
+  using size_type=typename super::size_type;
+  using weigher_type=std::function<std::size_t(const value_type&)>;
+  using clock=std::chrono::steady_clock;
+
+#if defined(BOOST_UNORDERED_ENABLE_STATS)
+  using stats=typename super::stats;
+#endif
+
+  concurrent_cache_table(
+    std::size_t max_size_,std::size_t max_weight_,weigher_type weigher_,
+    const Hash& h_=Hash(),const Pred& pred_=Pred(),
+    const Allocator& al_=Allocator()):
+    super(0,h_,pred_,al_),
+    max_size{max_size_},max_weight{max_weight_},weigher(std::move(weigher_))
+  {
+    super::reserve(max_size+max_size/4);
+  }
+
+  concurrent_cache_table(const concurrent_cache_table&)=delete;
+  concurrent_cache_table& operator=(const concurrent_cache_table&)=delete;
+
+  using super::get_allocator;
+  using super::size;
+  using super::hash_function;
+  using super::key_eq;
+
+#if defined(BOOST_UNORDERED_ENABLE_STATS)
+  using super::get_stats;
+  using super::reset_stats;
+#endif
+
+  std::size_t capacity()const noexcept{return max_size;}
+  std::size_t max_bytes()const noexcept{return weigher?max_weight:0;}
+  std::size_t bytes()const noexcept
+  {
+    return weight.load(std::memory_order_relaxed);
+  }
+
+  clock::duration ttl()const noexcept
+  {
+    return clock::duration{ttl_.load(std::memory_order_relaxed)};
+  }
+
+  void set_ttl(clock::duration d)noexcept
+  {
+    ttl_.store(d.count()>0?d.count():0,std::memory_order_relaxed);
+  }
+
+  template<typename Key,typename F>
+  BOOST_FORCEINLINE std::size_t visit(const Key& x,F&& f)
+  {
+    std::size_t res=0;
+    super::visit(x,[&,this](value_type& v){
+      if(touch(element_from(v))){
+        f(v);
+        res=1;
+      }
+    });
+    return res;
+  }
+
+  template<typename Key,typename F>
+  BOOST_FORCEINLINE std::size_t visit(const Key& x,F&& f)const
+  {
+    return cvisit(x,std::forward<F>(f));
+  }
+
+  template<typename Key,typename F>
+  BOOST_FORCEINLINE std::size_t cvisit(const Key& x,F&& f)const
+  {
+    std::size_t res=0;
+    super::cvisit(x,[&,this](const value_type& v){
+      if(touch(element_from(v))){
+        f(v);
+        res=1;
+      }
+    });
+    return res;
+  }
+
+  template<typename Key>
+  BOOST_FORCEINLINE std::size_t count(const Key& x)const
+  {
+    return cvisit(x,[](const value_type&){});
+  }
+
+  template<typename Key>
+  BOOST_FORCEINLINE bool contains(const Key& x)const
+  {
+    return count(x)!=0;
+  }
+
+  /* Traversal neither sets reference bits nor visits expired elements. */
+
+  template<typename F> std::size_t visit_all(F&& f)
+  {
+    std::size_t res=0;
+    super::visit_all([&,this](value_type& v){
+      if(!expired(element_from(v))){
+        f(v);
+        ++res;
+      }
+    });
+    return res;
+  }
+
+  template<typename F> std::size_t cvisit_all(F&& f)const
+  {
+    std::size_t res=0;
+    super::cvisit_all([&,this](const value_type& v){
+      if(!expired(element_from(v))){
+        f(v);
+        ++res;
+      }
+    });
+    return res;
+  }
+
+  template<typename Key,typename... Args>
+  BOOST_FORCEINLINE bool try_emplace(Key&& x,Args&&... args)
+  {
+    return emplace_or_visit(
+      [](const value_type&){},
+      [&](value_type& v){
+        v.second=typename type_policy::raw_mapped_type(
+          std::forward<Args>(args)...);
+      },
+      try_emplace_args_t{},std::forward<Key>(x),std::forward<Args>(args)...);
+  }
+
+  BOOST_FORCEINLINE bool insert(const init_type& x)
+  {
+    return insert_or_cvisit(x,[](const value_type&){});
+  }
+
+  BOOST_FORCEINLINE bool insert(init_type&& x)
+  {
+    return insert_or_cvisit(std::move(x),[](const value_type&){});
+  }
+
+  template<typename F>
+  BOOST_FORCEINLINE bool insert_or_visit(const init_type& x,F&& f)
+  {
+    return emplace_or_visit(
+      std::forward<F>(f),[&](value_type& v){v.second=x.second;},x);
+  }
+
+  template<typename F>
+  BOOST_FORCEINLINE bool insert_or_visit(init_type&& x,F&& f)
+  {
+    return emplace_or_visit(
+      std::forward<F>(f),[&](value_type& v){v.second=std::move(x.second);},
+      std::move(x));
+  }
+
+  template<typename F>
+  BOOST_FORCEINLINE bool insert_or_cvisit(const init_type& x,F&& f)
+  {
+    return insert_or_visit(x,[&](const value_type& v){f(v);});
+  }
+
+  template<typename F>
+  BOOST_FORCEINLINE bool insert_or_cvisit(init_type&& x,F&& f)
+  {
+    return insert_or_visit(std::move(x),[&](const value_type& v){f(v);});
+  }
+
+  /* Assignment renews the element as if it were inserted anew. */
+
+  template<typename Key,typename M>
+  BOOST_FORCEINLINE bool insert_or_assign(Key&& x,M&& obj)
+  {
+    bool res=super::emplace_and_visit_impl(
+      group_exclusive{},
+      [this](value_type& v){admit(element_from(v));},
+      [&,this](value_type& v){
+        auto& e=element_from(v);
+        release(e);
+        v.second=std::forward<M>(obj);
+        admit(e);
+      },
+      try_emplace_args_t{},std::forward<Key>(x),std::forward<M>(obj));
+    if(res)evict_if_over_budget();
+    return res;
+  }
+
+  template<typename Key>
+  BOOST_FORCEINLINE std::size_t erase(const Key& x)
+  {
+    return super::erase_if(x,[this](const value_type& v){
+      release(element_from(v));
+      return true;
+    });
+  }
+
+  template<typename F>
+  std::size_t erase_if(F&& f)
+  {
+    return super::erase_if([&,this](value_type& v){
+      if(f(v)){
+        release(element_from(v));
+        return true;
+      }
+      return false;
+    });
+  }
+
+  void clear()
+  {
+    erase_if([](const value_type&){return true;});
+  }
+
+private:
+  using steady_rep=clock::rep;
+
+  static element_type& element_from(value_type& x)
+  {
+    return static_cast<element_type&>(x);
+  }
+
+  static const element_type& element_from(const value_type& x)
+  {
+    return static_cast<const element_type&>(x);
+  }
+
+  static boost::uint64_t now()
+  {
+    return static_cast<boost::uint64_t>(
+      clock::now().time_since_epoch().count());
+  }
+
+  static bool expired(boost::uint64_t stamp)
+  {
+    auto expiry=stamp>>1;
+    return expiry&&expiry<=now();
+  }
+
+  static bool expired(const element_type& e)
+  {
+    return expired(e.stamp.load(std::memory_order_relaxed));
+  }
+
+  /* Returns false if e is expired, sets its reference bit otherwise. */
+
+  static BOOST_FORCEINLINE bool touch(const element_type& e)
+  {
+    auto stamp=e.stamp.load(std::memory_order_relaxed);
+    if(BOOST_UNLIKELY(expired(stamp)))return false;
+    if(!(stamp&element_type::referenced)){
+      e.stamp.fetch_or(element_type::referenced,std::memory_order_relaxed);
+    }
+    return true;
+  }
+
+  /* Called with exclusive group access to newly inserted or reassigned
+   * elements.
+   */
+
+  void admit(element_type& e)
+  {
+    boost::uint64_t stamp=0;
+    auto            d=ttl_.load(std::memory_order_relaxed);
+    if(d)stamp|=(now()+static_cast<boost::uint64_t>(d))<<1;
+    e.stamp.store(stamp,std::memory_order_relaxed);
+    if(weigher){
+      e.weight=weigher(type_policy::value_from(e));
+      weight.fetch_add(e.weight,std::memory_order_relaxed);
+    }
+  }
+
+  void release(const element_type& e)
+  {
+    if(e.weight)weight.fetch_sub(e.weight,std::memory_order_relaxed);
+  }
+
+  /* Inserts an element from args unless an equivalent unexpired one
+   * exists, in which case f is invoked on it. Expired equivalent elements
+   * are reassigned instead with assign, which counts as an insertion.
+   */
+
+  template<typename F,typename Assign,typename... Args>
+  BOOST_FORCEINLINE bool emplace_or_visit(
+    F&& f,Assign&& assign,Args&&... args)
+  {
+    bool reassigned=false;
+    bool res=super::emplace_and_visit_impl(
+      group_exclusive{},
+      [this](value_type& v){admit(element_from(v));},
+      [&,this](value_type& v){
+        auto& e=element_from(v);
+        if(touch(e))f(v);
+        else{
+          release(e);
+          assign(v);
+          admit(e);
+          reassigned=true;
+        }
+      },
+      std::forward<Args>(args)...);
+    if(res)evict_if_over_budget();
+    return res||reassigned;
+  }
+
+  bool over_budget_hint()const noexcept
+  {
+    /* size_ctrl.size overcounts by the size credits outstanding */
+    return this->size_ctrl.size>max_size||
+           (weigher&&weight.load(std::memory_order_relaxed)>max_weight);
+  }
+
+  bool over_budget()const noexcept
+  {
+    return this->unprotected_size()>max_size||
+           (weigher&&weight.load(std::memory_order_relaxed)>max_weight);
+  }
+
+  void evict_if_over_budget()
+  {
+    if(BOOST_LIKELY(!over_budget_hint()))return;
+
+    /* two turns of the hand are enough to evict any element not referenced
+     * again in the meantime
+     */
+
+    auto lck=this->shared_access();
+    if(!this->arrays.elements())return;
+    auto groups_size=this->arrays.groups_size_mask+1;
+    for(std::size_t i=0;i<2*groups_size&&over_budget();++i){
+      sweep(
+        hand.fetch_add(1,std::memory_order_relaxed)&
+        this->arrays.groups_size_mask);
+    }
+  }
+
+  void sweep(std::size_t pos)
+  {
+    auto pg=this->arrays.groups()+pos;
+    auto last=this->arrays.groups()+this->arrays.groups_size_mask+1;
+    auto p=this->arrays.elements()+pos*N;
+    auto lck=this->access(group_exclusive{},this->arrays,pos);
+    auto mask=super::match_really_occupied(group_exclusive{},pg,last);
+    while(mask){
+      auto n=unchecked_countr_zero(mask);
+      auto stamp=p[n].stamp.load(std::memory_order_relaxed);
+      if(expired(stamp)){
+        release(p[n]);
+        this->unprotected_erase(pg,n,p+n);
+      }
+      else if(stamp&element_type::referenced){
+        p[n].stamp.fetch_and(
+          ~element_type::referenced,std::memory_order_relaxed);
+      }
+      else if(over_budget()){
+        release(p[n]);
+        this->unprotected_erase(pg,n,p+n);
+      }
+      mask&=mask-1;
+    }
+  }
+
+  std::size_t                     max_size;
+  std::size_t                     max_weight;
+  weigher_type                    weigher;
+  std::atomic<std::size_t>        weight{0};
+  std::atomic<steady_rep>         ttl_{0};
+  std::atomic<std::size_t>        hand{0};
+};
+
+} /* namespace foa */
+} /* namespace detail */
+} /* namespace unordered */
+} /* namespace boost */
+
+#endif
@@ -18,12 +18,14 @@
 #include <boost/core/ignore_unused.hpp>
 #include <boost/core/no_exceptions_support.hpp>
 #include <boost/core/serialization.hpp>
+#include <boost/core/yield_primitives.hpp>
 #include <boost/cstdint.hpp>
 #include <boost/mp11/tuple.hpp>
 #include <boost/throw_exception.hpp>
 #include <boost/unordered/detail/archive_constructed.hpp>
 #include <boost/unordered/detail/bad_archive_exception.hpp>
 #include <boost/unordered/detail/foa/core.hpp>
+#include <boost/unordered/detail/foa/pending_registry.hpp>
 #include <boost/unordered/detail/foa/reentrancy_check.hpp>
 #include <boost/unordered/detail/foa/rw_spinlock.hpp>
 #include <boost/unordered/detail/foa/tuple_rotate_right.hpp>
@@ -31,11 +33,13 @@
 #include <boost/unordered/detail/static_assert.hpp>
 #include <boost/unordered/detail/type_traits.hpp>
 #include <cstddef>
+#include <cstring>
 #include <functional>
 #include <initializer_list>
 #include <iterator>
 #include <memory>
 #include <new>
+#include <thread>
 #include <type_traits>
 #include <tuple>
 #include <utility>
@@ -52,8 +56,37 @@
 #include <execution>
 #endif
 
+#if defined(BOOST_UNORDERED_ENABLE_FUTEX_LOCKS)
+#include <boost/unordered/detail/foa/futex_rw_spinlock.hpp>
+#endif
+
+/* Optimistic reads copy elements concurrently with writers and validate the
+ * copy afterwards (seqlock protocol), which ThreadSanitizer rightly reports
+ * as a data race: they're disabled in TSan builds.
+ */
+
+#if defined(BOOST_UNORDERED_ENABLE_OPTIMISTIC_READS)&& \
+    !defined(BOOST_UNORDERED_THREAD_SANITIZER)
+#define BOOST_UNORDERED_OPTIMISTIC_READS
+#endif
+
+#if defined(BOOST_UNORDERED_ENABLE_STATS)
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <vector>
+#endif
+
 namespace boost{
 namespace unordered{
+
+/* Result of non-blocking operations on concurrent containers (try_visit
+ * etc.): whether the element was found (and the operation performed), not
+ * found, or the operation couldn't proceed without waiting on a lock.
+ */
+
+enum class try_result{done,not_found,would_block};
+
 namespace detail{
 
 #if defined(BOOST_UNORDERED_PARALLEL_ALGORITHMS)
@@ -76,6 +109,14 @@ namespace foa{
 
 static constexpr std::size_t cacheline_size=64;
 
+#if !defined(BOOST_UNORDERED_CONCURRENT_MAX_MUTEXES)
+#define BOOST_UNORDERED_CONCURRENT_MAX_MUTEXES 128
+#endif
+
+#if !defined(BOOST_UNORDERED_CONCURRENT_GROUP_ACCESS_LAYOUT)
+#define BOOST_UNORDERED_CONCURRENT_GROUP_ACCESS_LAYOUT 0
+#endif
+
 template<typename T,std::size_t N>
 class cache_aligned_array
 {
@@ -104,25 +145,137 @@ private:
   unsigned char buf[element_offset*N+cacheline_size-1];
 };
 
+/* Array of up to N mutexes of which only the first size() ones, a power of
+ * two determined at construction time from the number of hardware threads,
+ * are used, so that locking the whole array on small machines does not walk
+ * more cache lines than needed.
+ */
+
 template<typename Mutex,std::size_t N>
 class multimutex
 {
+  BOOST_UNORDERED_STATIC_ASSERT(N>0&&(N&(N-1))==0);
+
 public:
-  constexpr std::size_t size()const noexcept{return N;}
+  multimutex()noexcept:n(default_size()){}
+
+  std::size_t size()const noexcept{return n;}
 
   Mutex& operator[](std::size_t pos)noexcept
   {
-    BOOST_ASSERT(pos<N);
+    BOOST_ASSERT(pos<n);
     return mutexes[pos];
   }
 
-  void lock()noexcept{for(std::size_t n=0;n<N;)mutexes[n++].lock();}
-  void unlock()noexcept{for(auto n=N;n>0;)mutexes[--n].unlock();}
+  /* mutex assigned to a slot id as returned by thread_slot::id() */
+  Mutex& slot(std::size_t id)noexcept{return mutexes[id&(n-1)];}
+
+  void lock()noexcept{for(std::size_t i=0;i<n;)mutexes[i++].lock();}
+
+  template<typename Waiter>
+  void lock(Waiter& w)noexcept{for(std::size_t i=0;i<n;)mutexes[i++].lock(w);}
+  void unlock()noexcept{for(auto i=n;i>0;)mutexes[--i].unlock();}
 
 private:
+  static std::size_t default_size()noexcept
+  {
+    static const std::size_t res=[]{
+      std::size_t hc=std::thread::hardware_concurrency();
+      if(hc==0||hc>=N)return N;
+      std::size_t m=1;
+      while(m<hc)m*=2;
+      return m;
+    }();
+    return res;
+  }
+
+  std::size_t                  n;
   cache_aligned_array<Mutex,N> mutexes;
 };
 
+/* rw mutex used for group and container-level locking. With
+ * BOOST_UNORDERED_ENABLE_FUTEX_LOCKS, on platforms supporting it (Linux),
+ * waiters are parked on a futex after a bounded spin instead of yielding
+ * and eventually sleeping, which wastes less CPU when there are more
+ * threads than cores.
+ */
+
+#if defined(BOOST_UNORDERED_ENABLE_FUTEX_LOCKS)&&\
+    defined(BOOST_UNORDERED_HAS_FUTEX_RW_SPINLOCK)
+using concurrent_rw_mutex=futex_rw_spinlock;
+#else
+using concurrent_rw_mutex=rw_spinlock;
+#endif
+
+/* concurrent_rw_mutex plus a counter of size credits (see
+ * concurrent_table::reserve_size) sharing its cache line in a multimutex.
+ */
+
+struct credited_rw_spinlock:concurrent_rw_mutex
+{
+  std::atomic<std::size_t> size_credits{0};
+};
+
+/* Process-wide slot ids for threads, used to pick a mutex of a multimutex.
+ * Ids are reused after their threads exit, so that live threads get the
+ * lowest ids available and thus don't collide on the same mutex as long as
+ * there are no more of them than mutexes in the multimutex.
+ */
+
+class thread_slot
+{
+public:
+  static std::size_t id()noexcept
+  {
+    static thread_local thread_slot s;
+    return s.n;
+  }
+
+private:
+  static constexpr std::size_t word_bits=64;
+  static constexpr std::size_t num_words=16;
+
+  thread_slot()noexcept:n(acquire()){}
+  ~thread_slot(){release(n);}
+  thread_slot(const thread_slot&)=delete;
+  thread_slot& operator=(const thread_slot&)=delete;
+
+  static std::atomic<boost::uint64_t>* words()noexcept
+  {
+    static std::atomic<boost::uint64_t> w[num_words];
+    return w;
+  }
+
+  static std::size_t acquire()noexcept
+  {
+    for(std::size_t i=0;i<num_words;++i){
+      auto& w=words()[i];
+      auto  x=w.load(std::memory_order_relaxed);
+      while(~x){
+        auto b=static_cast<std::size_t>(boost::core::countr_zero(~x));
+        if(w.compare_exchange_weak(
+          x,x|(boost::uint64_t(1)<<b),std::memory_order_relaxed)){
+          return i*word_bits+b;
+        }
+      }
+    }
+
+    /* all ids taken, share them from now on */
+    static std::atomic<std::size_t> overflow_counter{0};
+    return num_words*word_bits+(overflow_counter++);
+  }
+
+  static void release(std::size_t n)noexcept
+  {
+    if(n<num_words*word_bits){
+      words()[n/word_bits].fetch_and(
+        ~(boost::uint64_t(1)<<(n%word_bits)),std::memory_order_relaxed);
+    }
+  }
+
+  std::size_t n;
+};
+
 /* std::shared_lock is C++14 */
 
 template<typename Mutex>
@@ -130,6 +283,10 @@ class shared_lock
 {
 public:
   shared_lock(Mutex& m_)noexcept:m(m_){m.lock_shared();}
+
+  /* w is informed of the waits incurred in locking (see rw_spinlock) */
+  template<typename Waiter>
+  shared_lock(Mutex& m_,Waiter&& w)noexcept:m(m_){m.lock_shared(w);}
   ~shared_lock()noexcept{if(owns)m.unlock_shared();}
 
   /* not used but VS in pre-C++17 mode needs to see it for RVO */
@@ -152,6 +309,9 @@ class lock_guard
 {
 public:
   lock_guard(Mutex& m_)noexcept:m(m_){m.lock();}
+
+  template<typename Waiter>
+  lock_guard(Mutex& m_,Waiter&& w)noexcept:m(m_){m.lock(w);}
   ~lock_guard()noexcept{m.unlock();}
 
   /* not used but VS in pre-C++17 mode needs to see it for RVO */
@@ -161,6 +321,120 @@ private:
   Mutex &m;
 };
 
+/* Non-blocking counterparts of shared_lock and lock_guard: the lock is
+ * attempted only once and owns_lock() tells whether it was acquired.
+ */
+
+template<typename Mutex>
+class try_shared_lock
+{
+public:
+  try_shared_lock(Mutex& m_)noexcept:m(m_),owns{m.try_lock_shared()}{}
+  ~try_shared_lock()noexcept{if(owns)m.unlock_shared();}
+
+  /* not used but VS in pre-C++17 mode needs to see it for RVO */
+  try_shared_lock(const try_shared_lock&);
+
+  bool owns_lock()const noexcept{return owns;}
+
+private:
+  Mutex &m;
+  bool  owns;
+};
+
+template<typename Mutex>
+class try_lock_guard
+{
+public:
+  try_lock_guard(Mutex& m_)noexcept:m(m_),owns{m.try_lock()}{}
+  ~try_lock_guard()noexcept{if(owns)m.unlock();}
+
+  /* not used but VS in pre-C++17 mode needs to see it for RVO */
+  try_lock_guard(const try_lock_guard&);
+
+  bool owns_lock()const noexcept{return owns;}
+
+private:
+  Mutex &m;
+  bool  owns;
+};
+
+#if defined(BOOST_UNORDERED_OPTIMISTIC_READS)
+/* Exclusive lock guard bumping a version counter to an odd value upon
+ * locking and back to an even value before unlocking, so that optimistic
+ * readers can detect they raced with a writer (seqlock protocol).
+ */
+
+template<typename Mutex,typename Version>
+class versioned_lock_guard
+{
+public:
+  versioned_lock_guard(Mutex& m_,Version& v_)noexcept:m(m_),v(v_)
+  {
+    m.lock();
+    start_writing();
+  }
+
+  template<typename Waiter>
+  versioned_lock_guard(Mutex& m_,Version& v_,Waiter&& w)noexcept:m(m_),v(v_)
+  {
+    m.lock(w);
+    start_writing();
+  }
+
+  ~versioned_lock_guard()noexcept
+  {
+    v.store(v.load(std::memory_order_relaxed)+1,std::memory_order_release);
+    m.unlock();
+  }
+
+  /* not used but VS in pre-C++17 mode needs to see it for RVO */
+  versioned_lock_guard(const versioned_lock_guard&);
+
+private:
+  void start_writing()noexcept
+  {
+    v.store(v.load(std::memory_order_relaxed)+1,std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+  }
+
+  Mutex   &m;
+  Version &v;
+};
+
+template<typename Mutex,typename Version>
+class try_versioned_lock_guard
+{
+public:
+  try_versioned_lock_guard(Mutex& m_,Version& v_)noexcept:
+    m(m_),v(v_),owns{m.try_lock()}
+  {
+    if(owns){
+      v.store(v.load(std::memory_order_relaxed)+1,std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_release);
+    }
+  }
+
+  ~try_versioned_lock_guard()noexcept
+  {
+    if(owns){
+      v.store(v.load(std::memory_order_relaxed)+1,std::memory_order_release);
+      m.unlock();
+    }
+  }
+
+  /* not used but VS in pre-C++17 mode needs to see it for RVO */
+  try_versioned_lock_guard(const try_versioned_lock_guard&);
+
+  bool owns_lock()const noexcept{return owns;}
+
+private:
+  Mutex   &m;
+  Version &v;
+  bool    owns;
+};
+#endif
+
 /* inspired by boost/multi_index/detail/scoped_bilock.hpp */
 
 template<typename Mutex>
@@ -195,6 +469,67 @@ private:
   Mutex *pm1,*pm2;
 };
 
+/* Container-level write locking reclaims the size credits held by the
+ * slots of the multimutex back into the size control, so that its size
+ * is exact while the lock is held.
+ */
+
+template<typename Multimutex,typename SizeControl>
+void reclaim_size_credits(Multimutex& m,SizeControl& sc)noexcept
+{
+  std::size_t n=0;
+  for(std::size_t i=0;i<m.size();++i){
+    n+=m[i].size_credits.exchange(0,std::memory_order_relaxed);
+  }
+  if(n)sc.size-=n;
+}
+
+template<typename Multimutex,typename SizeControl>
+class reclaiming_lock_guard
+{
+public:
+  reclaiming_lock_guard(Multimutex& m_,SizeControl& sc)noexcept:m(m_)
+  {
+    m.lock();
+    reclaim_size_credits(m,sc);
+  }
+
+  template<typename Waiter>
+  reclaiming_lock_guard(Multimutex& m_,SizeControl& sc,Waiter&& w)noexcept:
+    m(m_)
+  {
+    m.lock(w);
+    reclaim_size_credits(m,sc);
+  }
+
+  ~reclaiming_lock_guard()noexcept{m.unlock();}
+
+  /* not used but VS in pre-C++17 mode needs to see it for RVO */
+  reclaiming_lock_guard(const reclaiming_lock_guard&);
+
+private:
+  Multimutex &m;
+};
+
+template<typename Multimutex,typename SizeControl>
+class reclaiming_bilock
+{
+public:
+  reclaiming_bilock(
+    Multimutex& m1,Multimutex& m2,SizeControl& sc1,SizeControl& sc2)noexcept:
+    lck{m1,m2}
+  {
+    reclaim_size_credits(m1,sc1);
+    if(&m1!=&m2)reclaim_size_credits(m2,sc2);
+  }
+
+  /* not used but VS in pre-C++17 mode needs to see it for RVO */
+  reclaiming_bilock(const reclaiming_bilock&);
+
+private:
+  scoped_bilock<Multimutex> lck;
+};
+
 /* use atomics for group metadata storage */
 
 template<typename Integral>
@@ -215,35 +550,143 @@ struct atomic_integral
 
 /* Group-level concurrency protection. It provides a rw mutex plus an
  * atomic insertion counter for optimistic insertion (see
- * unprotected_norehash_emplace_and_visit).
+ * unprotected_norehash_emplace_and_visit) and, if optimistic reads are
+ * enabled, a version counter updated on every exclusive access (see
+ * unprotected_optimistic_copy).
  */
 
 struct group_access
 {    
-  using mutex_type=rw_spinlock;
+  using mutex_type=concurrent_rw_mutex;
   using shared_lock_guard=shared_lock<mutex_type>;
-  using exclusive_lock_guard=lock_guard<mutex_type>;
+  using try_shared_lock_guard=try_shared_lock<mutex_type>;
   using insert_counter_type=std::atomic<boost::uint32_t>;
+#if defined(BOOST_UNORDERED_OPTIMISTIC_READS)
+  using version_type=std::atomic<boost::uint32_t>;
+  using exclusive_lock_guard=versioned_lock_guard<mutex_type,version_type>;
+  using try_exclusive_lock_guard=
+    try_versioned_lock_guard<mutex_type,version_type>;
+
+  exclusive_lock_guard exclusive_access(){return exclusive_lock_guard{m,ver};}
+
+  try_exclusive_lock_guard try_exclusive_access()
+  {
+    return try_exclusive_lock_guard{m,ver};
+  }
+
+  template<typename Waiter>
+  exclusive_lock_guard exclusive_access(Waiter&& w)
+  {
+    return exclusive_lock_guard{m,ver,std::forward<Waiter>(w)};
+  }
+
+  version_type&        version(){return ver;}
+#else
+  using exclusive_lock_guard=lock_guard<mutex_type>;
+  using try_exclusive_lock_guard=try_lock_guard<mutex_type>;
 
-  shared_lock_guard    shared_access(){return shared_lock_guard{m};}
   exclusive_lock_guard exclusive_access(){return exclusive_lock_guard{m};}
+
+  try_exclusive_lock_guard try_exclusive_access()
+  {
+    return try_exclusive_lock_guard{m};
+  }
+
+  template<typename Waiter>
+  exclusive_lock_guard exclusive_access(Waiter&& w)
+  {
+    return exclusive_lock_guard{m,std::forward<Waiter>(w)};
+  }
+#endif
+
+  shared_lock_guard    shared_access(){return shared_lock_guard{m};}
+
+  try_shared_lock_guard try_shared_access(){return try_shared_lock_guard{m};}
+
+  template<typename Waiter>
+  shared_lock_guard shared_access(Waiter&& w)
+  {
+    return shared_lock_guard{m,std::forward<Waiter>(w)};
+  }
+
   insert_counter_type& insert_counter(){return cnt;}
 
 private:
   mutex_type          m;
   insert_counter_type cnt{0};
+#if defined(BOOST_UNORDERED_OPTIMISTIC_READS)
+  version_type        ver{0};
+#endif
+};
+
+/* group_access taking up a whole cache line */
+
+struct cacheline_group_access:group_access
+{
+  unsigned char pad[cacheline_size-sizeof(group_access)];
+};
+
+/* Layout of the group_access array as selected by
+ * BOOST_UNORDERED_CONCURRENT_GROUP_ACCESS_LAYOUT:
+ *   0: one group_access per group, packed, so that several groups share
+ *      the cache line of their locks and writers on unrelated groups may
+ *      false-share.
+ *   1: one group_access per group, each on its own cache line.
+ *   2: one group_access per cache line of group metadata, shared by all
+ *      the groups in the line and on its own cache line. Writers on groups
+ *      in the same metadata line already contend on it, so sharing the
+ *      lock costs little and saves memory with respect to 1. The group
+ *      array is only aligned to sizeof(Group), so slots are mapped from
+ *      the actual address of the group and one more slot is allocated for
+ *      the line straddled at the end (see
+ *      concurrent_table_arrays::group_access_for).
+ * Aligned layouts allocate one extra slot to align the array at runtime
+ * (see concurrent_table_arrays::group_accesses).
+ *
+ * The layout changes the size of the group_access array, so the macro must
+ * be defined with the same value in all translation units.
+ */
+
+template<
+  typename Group,int Layout=BOOST_UNORDERED_CONCURRENT_GROUP_ACCESS_LAYOUT
+>
+struct group_access_layout
+{
+  BOOST_UNORDERED_STATIC_ASSERT(Layout==0);
+
+  using slot_type=group_access;
+  static constexpr std::size_t groups_per_slot=1;
+  static constexpr bool        cacheline_aligned=false;
+};
+
+template<typename Group>
+struct group_access_layout<Group,1>
+{
+  using slot_type=cacheline_group_access;
+  static constexpr std::size_t groups_per_slot=1;
+  static constexpr bool        cacheline_aligned=true;
+};
+
+template<typename Group>
+struct group_access_layout<Group,2>
+{
+  using slot_type=cacheline_group_access;
+  static constexpr std::size_t groups_per_slot=
+    sizeof(Group)<cacheline_size?cacheline_size/sizeof(Group):1;
+  static constexpr bool        cacheline_aligned=true;
 };
 
-template<std::size_t Size>
-group_access* dummy_group_accesses()
+template<typename Slot,std::size_t Size>
+Slot* dummy_group_accesses()
 {
   /* Default group_access array to provide to empty containers without
    * incurring dynamic allocation. Mutexes won't actually ever be used,
    * (no successful reduced hash match) and insertion counters won't ever
-   * be incremented (insertions won't succeed as capacity()==0).
+   * be incremented (insertions won't succeed as capacity()==0). One extra
+   * slot is provided for runtime alignment.
    */
 
-  static group_access accesses[Size];
+  static Slot accesses[Size+1];
 
   return accesses;
 }
@@ -253,8 +696,10 @@ group_access* dummy_group_accesses()
 template<typename Value,typename Group,typename SizePolicy,typename Allocator>
 struct concurrent_table_arrays:table_arrays<Value,Group,SizePolicy,Allocator>
 {
+  using group_access_layout_type=group_access_layout<Group>;
+  using group_access_slot=typename group_access_layout_type::slot_type;
   using group_access_allocator_type=
-    typename boost::allocator_rebind<Allocator,group_access>::type;
+    typename boost::allocator_rebind<Allocator,group_access_slot>::type;
   using group_access_pointer=
     typename boost::allocator_pointer<group_access_allocator_type>::type;
 
@@ -264,8 +709,55 @@ struct concurrent_table_arrays:table_arrays<Value,Group,SizePolicy,Allocator>
   concurrent_table_arrays(const super& arrays,group_access_pointer pga):
     super{arrays},group_accesses_{pga}{}
 
-  group_access* group_accesses()const noexcept{
-    return boost::to_address(group_accesses_);
+  group_access_slot* group_accesses()const noexcept{
+    return align_group_accesses(
+      boost::to_address(group_accesses_),
+      std::integral_constant<
+        bool,group_access_layout_type::cacheline_aligned>{});
+  }
+
+  group_access& group_access_for(std::size_t pos)const noexcept
+  {
+    return group_accesses()[group_access_index(
+      pos,
+      std::integral_constant<
+        bool,(group_access_layout_type::groups_per_slot>1)>{})];
+  }
+
+  std::size_t group_access_index(
+    std::size_t pos,std::false_type /* one group per slot */)const noexcept
+  {
+    return pos;
+  }
+
+  std::size_t group_access_index(
+    std::size_t pos,std::true_type /* one cache line per slot */)const noexcept
+  {
+    return
+      (reinterpret_cast<uintptr_t>(this->groups())%cacheline_size+
+       pos*sizeof(Group))/cacheline_size;
+  }
+
+  static std::size_t group_accesses_size(std::size_t groups_size)noexcept
+  {
+    constexpr std::size_t gps=group_access_layout_type::groups_per_slot;
+    return (groups_size+gps-1)/gps+
+      (gps>1?1:0)+ /* group array not aligned to cache lines */
+      (group_access_layout_type::cacheline_aligned?1:0);
+  }
+
+  static group_access_slot* align_group_accesses(
+    group_access_slot* p,std::false_type /* packed */)noexcept
+  {
+    return p;
+  }
+
+  static group_access_slot* align_group_accesses(
+    group_access_slot* p,std::true_type /* cache line aligned */)noexcept
+  {
+    return reinterpret_cast<group_access_slot*>(
+      (reinterpret_cast<uintptr_t>(p)+cacheline_size-1)/
+        cacheline_size*cacheline_size);
   }
 
   static concurrent_table_arrays new_(allocator_type al,std::size_t n)
@@ -285,7 +777,7 @@ struct concurrent_table_arrays:table_arrays<Value,Group,SizePolicy,Allocator>
     group_access_allocator_type al,concurrent_table_arrays& arrays)
   {
     set_group_access(
-      al,arrays,std::is_same<group_access*,group_access_pointer>{});
+      al,arrays,std::is_same<group_access_slot*,group_access_pointer>{});
   }
 
   static void set_group_access(
@@ -293,12 +785,14 @@ struct concurrent_table_arrays:table_arrays<Value,Group,SizePolicy,Allocator>
     concurrent_table_arrays& arrays,
     std::false_type /* fancy pointers */)
   {
-    arrays.group_accesses_=
-        boost::allocator_allocate(al,arrays.groups_size_mask+1);
+    auto size=group_accesses_size(arrays.groups_size_mask+1);
+    arrays.group_accesses_=boost::allocator_allocate(al,size);
 
-      for(std::size_t i=0;i<arrays.groups_size_mask+1;++i){
-        ::new (arrays.group_accesses()+i) group_access();
-      }
+    /* the extra slot of aligned layouts is not constructed */
+    if(group_access_layout_type::cacheline_aligned)--size;
+    for(std::size_t i=0;i<size;++i){
+      ::new (arrays.group_accesses()+i) group_access_slot();
+    }
   }
 
   static void set_group_access(
@@ -308,7 +802,7 @@ struct concurrent_table_arrays:table_arrays<Value,Group,SizePolicy,Allocator>
   {
     if(!arrays.elements()){
       arrays.group_accesses_=
-        dummy_group_accesses<SizePolicy::min_size()>();
+        dummy_group_accesses<group_access_slot,SizePolicy::min_size()>();
     } else {
       set_group_access(al,arrays,std::false_type{});
     }
@@ -333,7 +827,8 @@ struct concurrent_table_arrays:table_arrays<Value,Group,SizePolicy,Allocator>
   {
     if(arrays.elements()){
       boost::allocator_deallocate(
-        al,arrays.group_accesses_,arrays.groups_size_mask+1);
+        al,arrays.group_accesses_,
+        group_accesses_size(arrays.groups_size_mask+1));
     }
   }
 
@@ -374,41 +869,156 @@ inline void swap(atomic_size_control& x,atomic_size_control& y)
   swap_atomic_size_t(x.size,y.size);
 }
 
-/* foa::concurrent_table serves as the foundation for end-user concurrent
- * hash containers.
- * 
- * The exposed interface (completed by the wrapping containers) is not that
- * of a regular container (in fact, it does not model Container as understood
- * by the C++ standard):
- * 
- *   - Iterators are not provided as they are not suitable for concurrent
- *     scenarios.
- *   - As a consequence, composite operations with regular containers
- *     (like, for instance, looking up an element and modifying it), must
- *     be provided natively without any intervening iterator/accesor.
- *     Visitation is a core concept in this design, either on its own (eg.
- *     visit(k) locates the element with key k *and* accesses it) or as part
- *     of a native composite operation (eg. try_emplace_or_visit). Visitation
- *     is constant or mutating depending on whether the used table function is
- *     const or not.
- *   - The API provides member functions for all the meaningful composite
- *     operations of the form "X (and|or) Y", where X, Y are one of the
- *     primitives FIND, ACCESS, INSERT or ERASE.
- *   - Parallel versions of [c]visit_all(f) and erase_if(f) are provided based
- *     on C++17 stdlib parallel algorithms.
- * 
- * Consult boost::concurrent_(flat|node)_(map|set) docs for the full API
- * reference. Heterogeneous lookup is suported by default, that is, without
- * checking for any ::is_transparent typedefs --this checking is done by the
- * wrapping containers.
- *
- * Thread-safe concurrency is implemented using a two-level lock system:
- * 
- *   - A first container-level lock is implemented with an array of
- *     rw spinlocks acting as a single rw mutex with very little
- *     cache-coherence traffic on read (each thread is assigned a different
- *     spinlock in the array). Container-level write locking is only used for
- *     rehashing and other container-wide operations (assignment, swap, etc.)
+#if defined(BOOST_UNORDERED_ENABLE_STATS)
+/* Contention stats. Lock waits are only recorded for contended
+ * acquisitions, i.e. those incurring at least one spin (busy wait, yield)
+ * or sleep (either a timed sleep or a futex wait, see
+ * BOOST_UNORDERED_ENABLE_FUTEX_LOCKS).
+ */
+
+struct concurrent_table_lock_stats
+{
+  std::size_t            count;
+  sequence_stats_summary spins;
+  sequence_stats_summary sleeps;
+};
+
+struct concurrent_table_rehash_time_stats
+{
+  std::size_t            count;
+  sequence_stats_summary duration; /* seconds */
+};
+
+struct concurrent_table_hot_group
+{
+  std::size_t position;
+  std::size_t count; /* upper bound of contended acquisitions */
+};
+
+struct concurrent_table_contention_stats
+{
+  concurrent_table_lock_stats             group_lock,
+                                          container_lock;
+  std::size_t                             insertion_rollbacks;
+  concurrent_table_rehash_time_stats      rehash_time;
+  std::vector<concurrent_table_hot_group> hot_groups;
+};
+
+struct concurrent_table_stats:table_core_stats
+{
+  concurrent_table_contention_stats contention;
+};
+
+/* Approximate top-k of the most contended group positions using the
+ * space-saving algorithm: an untracked position replaces the entry with the
+ * smallest count and inherits it, so counts are upper bounds and any
+ * position contended more than 1/size of the time is guaranteed to be
+ * listed. Positions are relative to the current bucket array, hence the
+ * sampler is reset on rehash.
+ */
+
+class hot_group_sampler
+{
+  using lock_guard=std::lock_guard<rw_spinlock>;
+
+public:
+  static constexpr std::size_t size=8;
+
+  void reset()noexcept
+  {
+    lock_guard lck{mut};
+    n=0;
+  }
+
+  void add(std::size_t pos)noexcept
+  {
+    lock_guard lck{mut};
+    std::size_t imin=0;
+    for(std::size_t i=0;i<n;++i){
+      if(entries[i].position==pos){
+        ++entries[i].count;
+        return;
+      }
+      if(entries[i].count<entries[imin].count)imin=i;
+    }
+    if(n<size)entries[n++]={pos,1};
+    else entries[imin]={pos,entries[imin].count+1};
+  }
+
+  std::vector<concurrent_table_hot_group> get()const
+  {
+    std::vector<concurrent_table_hot_group> res;
+    {
+      lock_guard lck{mut};
+      res.assign(entries,entries+n);
+    }
+    std::sort(
+      res.begin(),res.end(),
+      [](const concurrent_table_hot_group& x,
+         const concurrent_table_hot_group& y){return x.count>y.count;});
+    return res;
+  }
+
+private:
+  mutable rw_spinlock        mut;
+  std::size_t                n=0;
+  concurrent_table_hot_group entries[size];
+};
+
+struct concurrent_table_cumulative_stats
+{
+  void reset()noexcept
+  {
+    group_lock.reset();
+    container_lock.reset();
+    insertion_rollback.reset();
+    rehash_time.reset();
+    hot_groups.reset();
+  }
+
+  concurrent_cumulative_stats<2> group_lock,
+                                 container_lock;
+  concurrent_cumulative_stats<0> insertion_rollback;
+  concurrent_cumulative_stats<1> rehash_time;
+  hot_group_sampler              hot_groups;
+};
+#endif
+
+/* foa::concurrent_table serves as the foundation for end-user concurrent
+ * hash containers.
+ * 
+ * The exposed interface (completed by the wrapping containers) is not that
+ * of a regular container (in fact, it does not model Container as understood
+ * by the C++ standard):
+ * 
+ *   - Iterators are not provided as they are not suitable for concurrent
+ *     scenarios.
+ *   - As a consequence, composite operations with regular containers
+ *     (like, for instance, looking up an element and modifying it), must
+ *     be provided natively without any intervening iterator/accesor.
+ *     Visitation is a core concept in this design, either on its own (eg.
+ *     visit(k) locates the element with key k *and* accesses it) or as part
+ *     of a native composite operation (eg. try_emplace_or_visit). Visitation
+ *     is constant or mutating depending on whether the used table function is
+ *     const or not.
+ *   - The API provides member functions for all the meaningful composite
+ *     operations of the form "X (and|or) Y", where X, Y are one of the
+ *     primitives FIND, ACCESS, INSERT or ERASE.
+ *   - Parallel versions of [c]visit_all(f) and erase_if(f) are provided based
+ *     on C++17 stdlib parallel algorithms.
+ * 
+ * Consult boost::concurrent_(flat|node)_(map|set) docs for the full API
+ * reference. Heterogeneous lookup is suported by default, that is, without
+ * checking for any ::is_transparent typedefs --this checking is done by the
+ * wrapping containers.
+ *
+ * Thread-safe concurrency is implemented using a two-level lock system:
+ * 
+ *   - A first container-level lock is implemented with an array of
+ *     rw spinlocks acting as a single rw mutex with very little
+ *     cache-coherence traffic on read (each thread is assigned a different
+ *     spinlock in the array). Container-level write locking is only used for
+ *     rehashing and other container-wide operations (assignment, swap, etc.)
  *   - Each group of slots has an associated rw spinlock. A thread holds
  *     at most one group lock at any given time. Lookup is implemented in
  *     a (groupwise) lock-free manner until a reduced hash match is found, in
@@ -427,14 +1037,95 @@ inline void swap(atomic_size_control& x,atomic_size_control& y)
  *       whole operation (which is checked by comparing with c0), then we're
  *       good to go and complete the insertion, otherwise we roll back and
  *       start over.
+ *
+ * Growth takes container-level write locking, so all other operations are
+ * stalled until every element has been moved to the new arrays. With
+ * BOOST_UNORDERED_ENABLE_COOPERATIVE_REHASH, growth only installs the new
+ * arrays and the old ones are kept around while their elements are migrated
+ * by inserting threads, which claim chunks of old groups (see
+ * help_cooperative_rehash):
+ *
+ *   - An element is moved to the new arrays under the locks of its old and
+ *     new groups (always acquired in this order) and only then removed from
+ *     the old arrays, whose overflow bits are left untouched.
+ *   - Hence, lookup forwards to the new arrays what it can't find in the old
+ *     ones, locking old groups before reading their metadata so as to
+ *     synchronize with the migration of their elements.
+ *   - Insertion goes to the new arrays after unsuccessful lookup as usual.
+ *   - Full-table traversal waits for the migration to complete.
+ *   - Container-level write locking operations finish off any pending
+ *     migration first.
+ *
+ * Insert-only type policies (see insert_only_types) never have elements
+ * erased or modified. When the group layout is regular (the metadata of
+ * slot n is the n-th byte of the group), insertion then claims an available
+ * slot by CAS'ing its metadata from available to reserved (the sentinel
+ * value, which no reduced hash takes), constructs the element and publishes
+ * it by release-storing the reduced hash. Lookup and traversal don't lock
+ * groups, but acquire-load the metadata of a slot before accessing its
+ * element, and skip reserved slots. Insertion's own lookup
+ * waits for reserved slots in the groups it probes to be published or
+ * released, as they may be taken by equivalent elements. Rehashing is still
+ * done under container-level write locking.
+ *
+ * visit_range traverses the table in slices of home groups, releasing the
+ * container-level lock between calls. The resumption point is kept as a
+ * hash value rather than an array position, so that it survives rehashing
+ * (see for_range_elements).
+ *
+ * Any table can be frozen (see freeze) after it's been populated: freeze
+ * waits for all ongoing operations under container-level write locking and
+ * sets a flag after which lookup and traversal skip both container-level
+ * and group locking. Modifications are not allowed until the table is
+ * thawed, and freeze and thaw themselves act as synchronization points.
  */
 
 template<typename,typename,typename,typename>
 class table; /* concurrent/non-concurrent interop */
 
+template<typename,typename,typename,typename>
+class concurrent_cache_table;
+
+/* Marks TypePolicy as insert-only (see concurrent_table). */
+
+template<typename TypePolicy>
+struct insert_only_types:TypePolicy{};
+
+template<typename TypePolicy>
+struct is_insert_only:std::false_type{};
+
+template<typename TypePolicy>
+struct is_insert_only<insert_only_types<TypePolicy>>:std::true_type{};
+
+/* Tables with a bounded number of elements (see concurrent_cache_table)
+ * specialize this for their type policies. They're reserved with enough
+ * room on construction, so reaching the maximum load can only be due to
+ * anti-drift.
+ */
+
+template<typename TypePolicy>
+struct is_bounded:std::false_type{};
+
+/* Resumption point of concurrent_table::visit_range. */
+
+class concurrent_cursor
+{
+public:
+  concurrent_cursor()=default;
+
+  bool done()const noexcept{return done_;}
+
+private:
+  template<typename,typename,typename,typename>
+  friend class concurrent_table;
+
+  std::size_t next=0; /* lowest hash value not visited yet */
+  bool        done_=false;
+};
+
 template <typename TypePolicy,typename Hash,typename Pred,typename Allocator>
 using concurrent_table_core_impl=table_core<
-  TypePolicy,group15<atomic_integral>,concurrent_table_arrays,
+  TypePolicy,default_group<atomic_integral>,concurrent_table_arrays,
   atomic_size_control,Hash,Pred,Allocator>;
 
 #include <boost/unordered/detail/foa/ignore_wshadow.hpp>
@@ -467,13 +1158,32 @@ public:
   using key_equal=typename super::key_equal;
   using allocator_type=typename super::allocator_type;
   using size_type=typename super::size_type;
-  static constexpr std::size_t bulk_visit_size=16;
+  using super::bulk_visit_size;
+  using cursor=concurrent_cursor;
 
 #if defined(BOOST_UNORDERED_ENABLE_STATS)
-  using stats=typename super::stats;
+  using stats=concurrent_table_stats;
 #endif
 
 private:
+  /* Generic (non-regular) group layouts fall back to locking. */
+  using lockfree_insert_only=std::integral_constant<
+    bool,is_insert_only<TypePolicy>::value&&group_type::regular_layout>;
+
+#if defined(BOOST_UNORDERED_ENABLE_COOPERATIVE_REHASH)
+  /* Elements are moved out of the old arrays while other threads access
+   * them, so this can't throw (except for hashing, see
+   * help_cooperative_rehash); otherwise, growth is blocking.
+   */
+  static constexpr bool cooperative_rehash=
+    (std::is_nothrow_move_constructible<init_type>::value||
+     !std::is_same<element_type,value_type>::value)&&
+    !lockfree_insert_only::value&&!is_bounded<TypePolicy>::value;
+
+  /* groups of the old arrays claimed at a time by helping threads */
+  static constexpr std::size_t cooperative_rehash_groups=8;
+#endif
+
   template<typename Value,typename T>
   using enable_if_is_value_type=typename std::enable_if<
     !std::is_same<init_type,value_type>::value&&
@@ -517,15 +1227,22 @@ public:
     BOOST_UNORDERED_SWAP_STATS(this->cstats,x.cstats);
   }
 
+  /* x's arrays are taken over as they are, so any pending incremental
+   * rehash must be completed beforehand.
+   */
   concurrent_table(compatible_nonconcurrent_table&& x):
-    concurrent_table(std::move(x),x.make_empty_arrays())
+    concurrent_table(
+      (x.finish_incremental_rehash(),std::move(x)),x.make_empty_arrays())
   {}
 
-  ~concurrent_table()=default;
+  ~concurrent_table(){discard_cooperative_rehash();}
 
   concurrent_table& operator=(const concurrent_table& x)
   {
     auto lck=exclusive_access(*this,x);
+    BOOST_ASSERT(!is_frozen());
+    x.finish_cooperative_rehash();
+    if(this!=std::addressof(x))discard_cooperative_rehash();
     super::operator=(x);
     return *this;
   }
@@ -533,13 +1250,28 @@ public:
   concurrent_table& operator=(concurrent_table&& x)noexcept(
     noexcept(std::declval<super&>() = std::declval<super&&>()))
   {
+    static constexpr auto pocma=
+      boost::allocator_propagate_on_container_move_assignment<
+        Allocator>::type::value;
+
     auto lck=exclusive_access(*this,x);
-    super::operator=(std::move(x));
+    BOOST_ASSERT(!is_frozen()&&!x.is_frozen());
+    if(this!=std::addressof(x)){
+      /* x's pending migration goes along with its arrays if these are taken
+       * over, otherwise elements are moved one by one (and this can throw).
+       */
+      if(!pocma&&!(this->al()==x.al()))x.finish_cooperative_rehash();
+      discard_cooperative_rehash();
+      super::operator=(std::move(x));
+      swap_cooperative_rehash_state(x);
+    }
     return *this;
   }
 
   concurrent_table& operator=(std::initializer_list<value_type> il) {
     auto lck=exclusive_access();
+    BOOST_ASSERT(!is_frozen());
+    discard_cooperative_rehash();
     super::clear();
     super::noshrink_reserve(il.size());
     for (auto const& v : il) {
@@ -572,6 +1304,27 @@ public:
     return visit(x,std::forward<F>(f));
   }
 
+  template<typename Key,typename F>
+  BOOST_FORCEINLINE std::size_t visit(
+    const Key& x,precomputed_hash hash,F&& f)
+  {
+    return visit_impl(group_exclusive{},x,hash,std::forward<F>(f));
+  }
+
+  template<typename Key,typename F>
+  BOOST_FORCEINLINE std::size_t visit(
+    const Key& x,precomputed_hash hash,F&& f)const
+  {
+    return visit_impl(group_shared{},x,hash,std::forward<F>(f));
+  }
+
+  template<typename Key,typename F>
+  BOOST_FORCEINLINE std::size_t cvisit(
+    const Key& x,precomputed_hash hash,F&& f)const
+  {
+    return visit(x,hash,std::forward<F>(f));
+  }
+
   template<typename FwdIterator,typename F>
   BOOST_FORCEINLINE
   std::size_t visit(FwdIterator first,FwdIterator last,F&& f)
@@ -672,6 +1425,25 @@ public:
   }
 #endif
 
+  template<typename F>
+  cursor visit_range(cursor c,std::size_t max_groups,F&& f)
+  {
+    return visit_range_impl(
+      group_exclusive{},c,max_groups,std::forward<F>(f));
+  }
+
+  template<typename F>
+  cursor visit_range(cursor c,std::size_t max_groups,F&& f)const
+  {
+    return visit_range_impl(group_shared{},c,max_groups,std::forward<F>(f));
+  }
+
+  template<typename F>
+  cursor cvisit_range(cursor c,std::size_t max_groups,F&& f)const
+  {
+    return visit_range(c,max_groups,std::forward<F>(f));
+  }
+
   bool empty()const noexcept{return size()==0;}
   
   std::size_t size()const noexcept
@@ -771,6 +1543,29 @@ public:
       try_emplace_args_t{},std::forward<Key>(x),std::forward<Args>(args)...);
   }
 
+  /* Inserts an element with key x and mapped value factory() unless an
+   * equivalent element exists, in which case f is invoked on it. factory
+   * runs with no lock held, while concurrent callers for an equivalent key
+   * wait for it to finish rather than compute the value again (see
+   * pending_registry).
+   */
+
+  template<typename Key,typename Factory,typename F>
+  bool compute_if_absent_or_visit(Key&& x,Factory&& factory,F&& f)
+  {
+    return compute_if_absent_impl(
+      group_exclusive{},std::forward<Key>(x),
+      std::forward<Factory>(factory),std::forward<F>(f));
+  }
+
+  template<typename Key,typename Factory,typename F>
+  bool compute_if_absent_or_cvisit(Key&& x,Factory&& factory,F&& f)
+  {
+    return compute_if_absent_impl(
+      group_shared{},std::forward<Key>(x),
+      std::forward<Factory>(factory),std::forward<F>(f));
+  }
+
   template<typename... Args>
   BOOST_FORCEINLINE bool emplace_or_visit(Args&&... args)
   {
@@ -902,12 +1697,73 @@ public:
       group_shared{},std::forward<F1>(f1),std::forward<F2>(f2),std::move(x));
   }
 
+  /* Range insertion: when the range is a forward one of value_type or
+   * init_type objects, elements are hashed and their groups prefetched
+   * bulk_visit_size at a time, and the container is locked just once
+   * unless growth is needed (see insert_range_and_visit). Return the number
+   * of elements processed.
+   */
+
+  template<typename InputIterator>
+  std::size_t insert(InputIterator first,InputIterator last)
+  {
+    return insert_range_and_visit(
+      group_shared{},first,last,
+      [](const value_type&){},[](const value_type&){});
+  }
+
+  template<typename InputIterator,typename F>
+  std::size_t insert_or_visit(InputIterator first,InputIterator last,F&& f)
+  {
+    return insert_range_and_visit(
+      group_exclusive{},first,last,[](const value_type&){},std::forward<F>(f));
+  }
+
+  template<typename InputIterator,typename F>
+  std::size_t insert_or_cvisit(InputIterator first,InputIterator last,F&& f)
+  {
+    return insert_range_and_visit(
+      group_shared{},first,last,[](const value_type&){},std::forward<F>(f));
+  }
+
+  template<typename InputIterator,typename F1,typename F2>
+  std::size_t insert_and_visit(
+    InputIterator first,InputIterator last,F1&& f1,F2&& f2)
+  {
+    return insert_range_and_visit(
+      group_exclusive{},first,last,std::forward<F1>(f1),std::forward<F2>(f2));
+  }
+
+  template<typename InputIterator,typename F1,typename F2>
+  std::size_t insert_and_cvisit(
+    InputIterator first,InputIterator last,F1&& f1,F2&& f2)
+  {
+    return insert_range_and_visit(
+      group_shared{},first,last,std::forward<F1>(f1),std::forward<F2>(f2));
+  }
+
   template<typename Key>
   BOOST_FORCEINLINE std::size_t erase(const Key& x)
   {
     return erase_if(x,[](const value_type&){return true;});
   }
 
+  template<typename Key>
+  BOOST_FORCEINLINE std::size_t erase(const Key& x,precomputed_hash hash)
+  {
+    auto        lck=shared_access();
+    auto        hash_=this->hash_for(x,hash);
+    std::size_t res=0;
+    unprotected_internal_visit(
+      group_exclusive{},x,this->position_for(hash_),hash_,
+      [&,this](group_type* pg,unsigned int n,element_type* p)
+      {
+        unprotected_erase(pg,n,p);
+        res=1;
+      });
+    return res;
+  }
+
   template<typename Key,typename F>
   BOOST_FORCEINLINE auto erase_if(const Key& x,F&& f)->typename std::enable_if<
     !is_execution_policy<Key>::value,std::size_t>::type
@@ -920,13 +1776,71 @@ public:
       [&,this](group_type* pg,unsigned int n,element_type* p)
       {
         if(f(cast_for(group_exclusive{},type_policy::value_from(*p)))){
-          super::erase(pg,n,p);
+          unprotected_erase(pg,n,p);
           res=1;
         }
       });
     return res;
   }
 
+  /* Non-blocking versions of visit, try_emplace_or_[c]visit and erase for
+   * threads that can't afford to wait: container-level and group mutexes
+   * are acquired with try_lock[_shared], and try_result::would_block is
+   * returned if any is not available, if a cooperative rehash is in progress
+   * (only blocking operations complete it) or if insertion needs the table to
+   * grow. try_[c]visit_or_emplace returns
+   * try_result::done if f was invoked on an existing element and
+   * try_result::not_found if a new one was inserted.
+   */
+
+  template<typename Key,typename F>
+  BOOST_FORCEINLINE try_result try_visit(const Key& x,F&& f)
+  {
+    return try_visit_impl(group_exclusive{},x,std::forward<F>(f));
+  }
+
+  template<typename Key,typename F>
+  BOOST_FORCEINLINE try_result try_visit(const Key& x,F&& f)const
+  {
+    return try_visit_impl(group_shared{},x,std::forward<F>(f));
+  }
+
+  template<typename Key,typename F>
+  BOOST_FORCEINLINE try_result try_cvisit(const Key& x,F&& f)const
+  {
+    return try_visit(x,std::forward<F>(f));
+  }
+
+  template<typename Key,typename... Args>
+  BOOST_FORCEINLINE try_result try_visit_or_emplace(Key&& x,Args&&... args)
+  {
+    return try_visit_or_emplace_flast(
+      group_exclusive{},
+      try_emplace_args_t{},std::forward<Key>(x),std::forward<Args>(args)...);
+  }
+
+  template<typename Key,typename... Args>
+  BOOST_FORCEINLINE try_result try_cvisit_or_emplace(Key&& x,Args&&... args)
+  {
+    return try_visit_or_emplace_flast(
+      group_shared{},
+      try_emplace_args_t{},std::forward<Key>(x),std::forward<Args>(args)...);
+  }
+
+  template<typename Key>
+  BOOST_FORCEINLINE try_result try_erase(const Key& x)
+  {
+    auto lck=try_shared_access();
+    if(!lck.lck.owns_lock()||cooperative_rehash_in_progress()){
+      return try_result::would_block;
+    }
+    auto hash=this->hash_for(x);
+    return unprotected_try_internal_visit(
+      group_exclusive{},x,this->position_for(hash),hash,
+      [&,this](group_type* pg,unsigned int n,element_type* p)
+        {unprotected_erase(pg,n,p);});
+  }
+
   template<typename F>
   std::size_t erase_if(F&& f)
   {
@@ -936,7 +1850,7 @@ public:
       group_exclusive{},
       [&,this](group_type* pg,unsigned int n,element_type* p){
         if(f(cast_for(group_exclusive{},type_policy::value_from(*p)))){
-          super::erase(pg,n,p);
+          unprotected_erase(pg,n,p);
           ++res;
         }
       });
@@ -953,7 +1867,7 @@ public:
       group_exclusive{},std::forward<ExecutionPolicy>(policy),
       [&,this](group_type* pg,unsigned int n,element_type* p){
         if(f(cast_for(group_exclusive{},type_policy::value_from(*p)))){
-          super::erase(pg,n,p);
+          unprotected_erase(pg,n,p);
         }
       });
   }
@@ -963,12 +1877,16 @@ public:
     noexcept(noexcept(std::declval<super&>().swap(std::declval<super&>())))
   {
     auto lck=exclusive_access(*this,x);
+    BOOST_ASSERT(!is_frozen()&&!x.is_frozen());
     super::swap(x);
+    swap_cooperative_rehash_state(x);
   }
 
   void clear()noexcept
   {
     auto lck=exclusive_access();
+    BOOST_ASSERT(!is_frozen());
+    discard_cooperative_rehash();
     super::clear();
   }
 
@@ -990,7 +1908,7 @@ public:
       {
         if(f(cast_for(group_exclusive{},type_policy::value_from(*p)))){
           ext(std::move(*p),this->al());
-          super::erase(pg,n,p);
+          unprotected_erase(pg,n,p);
         }
       });
   }
@@ -1006,6 +1924,9 @@ public:
     boost::ignore_unused<super2>();
 
     auto      lck=exclusive_access(*this,x);
+    BOOST_ASSERT(!is_frozen()&&!x.is_frozen());
+    x.finish_cooperative_rehash();
+    finish_cooperative_rehash();
     size_type s=super::size();
     x.super2::for_all_elements( /* super2::for_all_elements -> unprotected */
       [&,this](group_type* pg,unsigned int n,element_type* p){
@@ -1030,6 +1951,13 @@ public:
     return super::key_eq();
   }
 
+  template<typename Key>
+  precomputed_hash hash_function_mixed(const Key& x)const
+  {
+    auto lck=shared_access();
+    return super::hash_function_mixed(x);
+  }
+
   template<typename Key>
   BOOST_FORCEINLINE std::size_t count(Key&& x)const
   {
@@ -1067,20 +1995,75 @@ public:
   void rehash(std::size_t n)
   {
     auto lck=exclusive_access();
-    super::rehash(n);
+    BOOST_ASSERT(!is_frozen());
+    finish_cooperative_rehash();
+    timed_rehash([&]{super::rehash(n);});
   }
 
   void reserve(std::size_t n)
   {
     auto lck=exclusive_access();
-    super::reserve(n);
+    BOOST_ASSERT(!is_frozen());
+    finish_cooperative_rehash();
+    timed_rehash([&]{super::reserve(n);});
+  }
+
+  void freeze()
+  {
+    auto lck=exclusive_access();
+    finish_cooperative_rehash();
+    frozen.store(true,std::memory_order_release);
+  }
+
+  /* Operations started while frozen must have completed. */
+
+  void thaw()
+  {
+    auto lck=exclusive_access();
+    frozen.store(false,std::memory_order_relaxed);
+  }
+
+  bool is_frozen()const noexcept
+  {
+    return frozen.load(std::memory_order_acquire);
   }
 
 #if defined(BOOST_UNORDERED_ENABLE_STATS)
   /* already thread safe */
 
-  using super::get_stats;
-  using super::reset_stats;
+  stats get_stats()const
+  {
+    stats res;
+    static_cast<table_core_stats&>(res)=super::get_stats();
+    auto group_lock=contention_cstats.group_lock.get_summary();
+    auto container_lock=contention_cstats.container_lock.get_summary();
+    auto rehash_time=contention_cstats.rehash_time.get_summary();
+    res.contention={
+      {
+        group_lock.count,
+        group_lock.sequence_summary[0],
+        group_lock.sequence_summary[1]
+      },
+      {
+        container_lock.count,
+        container_lock.sequence_summary[0],
+        container_lock.sequence_summary[1]
+      },
+      contention_cstats.insertion_rollback.get_summary().count,
+      {
+        rehash_time.count,
+        rehash_time.sequence_summary[0]
+      },
+      contention_cstats.hot_groups.get()
+    };
+    return res;
+  }
+
+  void reset_stats()noexcept
+  {
+    super::reset_stats();
+    contention_cstats.reset();
+  }
 #endif
 
   template<typename Predicate>
@@ -1092,6 +2075,8 @@ public:
   friend bool operator==(const concurrent_table& x,const concurrent_table& y)
   {
     auto lck=exclusive_access(x,y);
+    x.finish_cooperative_rehash();
+    y.finish_cooperative_rehash();
     return static_cast<const super&>(x)==static_cast<const super&>(y);
   }
 
@@ -1102,44 +2087,134 @@ public:
 
 private:
   template<typename,typename,typename,typename> friend class concurrent_table;
+  template<typename,typename,typename,typename>
+  friend class concurrent_cache_table;
 
-  using mutex_type=rw_spinlock;
-  using multimutex_type=multimutex<mutex_type,128>; // TODO: adapt 128 to the machine
+  using mutex_type=credited_rw_spinlock;
+  using multimutex_type=
+    multimutex<mutex_type,BOOST_UNORDERED_CONCURRENT_MAX_MUTEXES>;
   using shared_lock_guard=reentrancy_checked<shared_lock<mutex_type>>;
-  using exclusive_lock_guard=reentrancy_checked<lock_guard<multimutex_type>>;
-  using exclusive_bilock_guard=
-    reentrancy_bichecked<scoped_bilock<multimutex_type>>;
+  using try_shared_lock_guard=reentrancy_checked<try_shared_lock<mutex_type>>;
+  using exclusive_lock_guard=reentrancy_checked<
+    reclaiming_lock_guard<multimutex_type,size_ctrl_type>>;
+  using exclusive_bilock_guard=reentrancy_bichecked<
+    reclaiming_bilock<multimutex_type,size_ctrl_type>>;
   using group_shared_lock_guard=typename group_access::shared_lock_guard;
   using group_exclusive_lock_guard=typename group_access::exclusive_lock_guard;
+  using group_try_shared_lock_guard=
+    typename group_access::try_shared_lock_guard;
+  using group_try_exclusive_lock_guard=
+    typename group_access::try_exclusive_lock_guard;
   using group_insert_counter_type=typename group_access::insert_counter_type;
 
+  /* x's pending migration, if any, is finished off before copying or moving
+   * elements from it, or otherwise taken over along with x's arrays.
+   */
+
   concurrent_table(const concurrent_table& x,exclusive_lock_guard):
-    super{x}{}
+    super{(x.finish_cooperative_rehash(),x)}{}
   concurrent_table(concurrent_table&& x,exclusive_lock_guard):
-    super{std::move(x)}{}
+    super{std::move(x)}
+  {
+    BOOST_ASSERT(!x.is_frozen());
+    swap_cooperative_rehash_state(x);
+  }
   concurrent_table(
     const concurrent_table& x,const Allocator& al_,exclusive_lock_guard):
-    super{x,al_}{}
+    super{(x.finish_cooperative_rehash(),x),al_}{}
   concurrent_table(
     concurrent_table&& x,const Allocator& al_,exclusive_lock_guard):
-    super{std::move(x),al_}{}
+    super{(x.finish_cooperative_rehash(),std::move(x)),al_}
+  {
+    BOOST_ASSERT(!x.is_frozen());
+  }
+
+#if defined(BOOST_UNORDERED_ENABLE_STATS)
+  /* Waiters passed to lock acquisition (see rw_spinlock) counting spins and
+   * sleeps. The count is recorded on destruction, i.e. once the enclosing
+   * full expression has acquired the lock, and only if there was contention.
+   */
+
+  struct lock_waits
+  {
+    void spin()noexcept{++spins;}
+    void sleep()noexcept{++sleeps;}
+
+    std::size_t spins=0,sleeps=0;
+  };
+
+  struct container_lock_waits:lock_waits
+  {
+    container_lock_waits(const concurrent_table* x_):x{x_}{}
+
+    ~container_lock_waits()
+    {
+      if(this->spins||this->sleeps){
+        BOOST_UNORDERED_ADD_STATS(
+          x->contention_cstats.container_lock,(this->spins,this->sleeps));
+      }
+    }
+
+    const concurrent_table* x;
+  };
+
+  struct group_lock_waits:lock_waits
+  {
+    group_lock_waits(
+      const concurrent_table* x_,const arrays_type& arrays_,std::size_t pos_):
+      x{x_},current{&arrays_==&x_->arrays},pos{pos_}{}
+
+    ~group_lock_waits()
+    {
+      if(this->spins||this->sleeps){
+        BOOST_UNORDERED_ADD_STATS(
+          x->contention_cstats.group_lock,(this->spins,this->sleeps));
+        if(current)x->contention_cstats.hot_groups.add(pos);
+      }
+    }
+
+    const concurrent_table* x;
+    bool                    current; /* not a lock on old arrays */
+    std::size_t             pos;
+  };
 
   inline shared_lock_guard shared_access()const
   {
-    thread_local auto id=(++thread_counter)%mutexes.size();
+    return shared_lock_guard{
+      this,mutexes.slot(thread_slot::id()),container_lock_waits{this}};
+  }
 
-    return shared_lock_guard{this,mutexes[id]};
+  inline exclusive_lock_guard exclusive_access()const
+  {
+    return exclusive_lock_guard{
+      this,mutexes,const_cast<size_ctrl_type&>(this->size_ctrl),
+      container_lock_waits{this}};
+  }
+#else
+  inline shared_lock_guard shared_access()const
+  {
+    return shared_lock_guard{this,mutexes.slot(thread_slot::id())};
   }
 
   inline exclusive_lock_guard exclusive_access()const
   {
-    return exclusive_lock_guard{this,mutexes};
+    return exclusive_lock_guard{
+      this,mutexes,const_cast<size_ctrl_type&>(this->size_ctrl)};
+  }
+#endif
+
+  inline try_shared_lock_guard try_shared_access()const
+  {
+    return try_shared_lock_guard{this,mutexes.slot(thread_slot::id())};
   }
 
   static inline exclusive_bilock_guard exclusive_access(
     const concurrent_table& x,const concurrent_table& y)
   {
-    return {&x,&y,x.mutexes,y.mutexes};
+    return {
+      &x,&y,x.mutexes,y.mutexes,
+      const_cast<size_ctrl_type&>(x.size_ctrl),
+      const_cast<size_ctrl_type&>(y.size_ctrl)};
   }
 
   template<typename Hash2,typename Pred2>
@@ -1147,7 +2222,10 @@ private:
     const concurrent_table& x,
     const concurrent_table<TypePolicy,Hash2,Pred2,Allocator>& y)
   {
-    return {&x,&y,x.mutexes,y.mutexes};
+    return {
+      &x,&y,x.mutexes,y.mutexes,
+      const_cast<size_ctrl_type&>(x.size_ctrl),
+      const_cast<size_ctrl_type&>(y.size_ctrl)};
   }
 
   /* Tag-dispatched shared/exclusive group access */
@@ -1157,18 +2235,54 @@ private:
 
   inline group_shared_lock_guard access(group_shared,std::size_t pos)const
   {
-    return this->arrays.group_accesses()[pos].shared_access();
+    return access(group_shared{},this->arrays,pos);
   }
 
   inline group_exclusive_lock_guard access(
     group_exclusive,std::size_t pos)const
   {
-    return this->arrays.group_accesses()[pos].exclusive_access();
+    return access(group_exclusive{},this->arrays,pos);
+  }
+
+  inline group_shared_lock_guard access(
+    group_shared,const arrays_type& arrays_,std::size_t pos)const
+  {
+#if defined(BOOST_UNORDERED_ENABLE_STATS)
+    return arrays_.group_access_for(pos).shared_access(
+      group_lock_waits{this,arrays_,pos});
+#else
+    return arrays_.group_access_for(pos).shared_access();
+#endif
+  }
+
+  inline group_exclusive_lock_guard access(
+    group_exclusive,const arrays_type& arrays_,std::size_t pos)const
+  {
+    BOOST_ASSERT(!is_frozen());
+#if defined(BOOST_UNORDERED_ENABLE_STATS)
+    return arrays_.group_access_for(pos).exclusive_access(
+      group_lock_waits{this,arrays_,pos});
+#else
+    return arrays_.group_access_for(pos).exclusive_access();
+#endif
+  }
+
+  inline group_try_shared_lock_guard try_access(
+    group_shared,std::size_t pos)const
+  {
+    return this->arrays.group_access_for(pos).try_shared_access();
+  }
+
+  inline group_try_exclusive_lock_guard try_access(
+    group_exclusive,std::size_t pos)const
+  {
+    BOOST_ASSERT(!is_frozen());
+    return this->arrays.group_access_for(pos).try_exclusive_access();
   }
 
   inline group_insert_counter_type& insert_counter(std::size_t pos)const
   {
-    return this->arrays.group_accesses()[pos].insert_counter();
+    return this->arrays.group_access_for(pos).insert_counter();
   }
 
   /* Const casts value_type& according to the level of group access for
@@ -1176,9 +2290,236 @@ private:
    * access is always const regardless of group access.
    */
 
+#if defined(BOOST_UNORDERED_OPTIMISTIC_READS)
+  /* Lookups with shared group access on flat containers with trivially
+   * copyable elements don't lock the group: the element is copied out and
+   * the copy is visited if the group version didn't change meanwhile.
+   */
+
+  struct group_optimistic{};
+
+  using optimistic_reads=std::integral_constant<
+    bool,
+    std::is_same<element_type,value_type>::value&&
+    is_trivially_copy_constructible<element_type>::value&&
+    std::is_trivially_destructible<element_type>::value
+  >;
+
+  static inline typename std::conditional<
+    optimistic_reads::value,group_optimistic,group_shared>::type
+  lookup_access(group_shared){return {};}
+
+  static inline group_exclusive lookup_access(group_exclusive){return {};}
+#endif
+
+  /* Lock-free group access for insert-only tables (see
+   * lockfree_insert_only): group_unlocked is used by lookup and traversal,
+   * group_unlocked_sync by the lookup preceding insertion.
+   */
+
+  struct group_unlocked{};
+  struct group_unlocked_sync:group_unlocked{};
+
+  struct unlocked_guard
+  {
+    ~unlocked_guard(){} /* not a trivial object for -Wunused */
+  };
+
+  /* Access to frozen tables, no locking nor synchronization needed. */
+
+  struct group_frozen{};
+
+  static constexpr unsigned char available_slot=0,
+                                 reserved_slot=1; /* sentinel value */
+
+  static inline typename std::conditional<
+    lockfree_insert_only::value,group_unlocked,group_shared>::type
+  unlocked_access(group_shared){return {};}
+
+  static inline group_exclusive unlocked_access(group_exclusive){return {};}
+  static inline group_frozen unlocked_access(group_frozen){return {};}
+
+#if defined(BOOST_UNORDERED_OPTIMISTIC_READS)
+  static inline group_unlocked lookup_access(group_unlocked){return {};}
+  static inline group_frozen lookup_access(group_frozen){return {};}
+#endif
+
+  /* synchronization with insertion is done per slot, see is_occupied */
+
+  inline unlocked_guard access(group_unlocked,std::size_t)const{return {};}
+
+  inline unlocked_guard access(
+    group_unlocked,const arrays_type&,std::size_t pos)const
+  {
+    return access(group_unlocked{},pos);
+  }
+
+  inline unlocked_guard access(group_frozen,std::size_t)const{return {};}
+
+  inline unlocked_guard access(
+    group_frozen,const arrays_type&,std::size_t)const{return {};}
+
+  template<typename GroupAccessMode>
+  inline shared_lock_guard shared_access(GroupAccessMode)const
+  {
+    return shared_access();
+  }
+
+  inline unlocked_guard shared_access(group_frozen)const{return {};}
+
+  /* Whether a lookup/traversal with access_mode is to be done as
+   * group_frozen.
+   */
+
+  inline bool frozen_for(group_shared)const{return is_frozen();}
+
+  inline bool frozen_for(group_exclusive)const
+  {
+    BOOST_ASSERT(!is_frozen());
+    return false;
+  }
+
+  static inline bool frozen_for(group_frozen){return false;}
+
+  /* Access mode used when frozen_for(access_mode): group_exclusive maps to
+   * itself so that the frozen branch of modifying operations, never taken,
+   * still compiles with visitation functions accepting non-const values.
+   */
+
+  static inline group_frozen frozen_access(group_shared){return {};}
+  static inline group_exclusive frozen_access(group_exclusive){return {};}
+  static inline group_frozen frozen_access(group_frozen){return {};}
+
+  static inline std::atomic<unsigned char>&
+  slot_metadata(group_type* pg,std::size_t n)
+  {
+    return reinterpret_cast<atomic_integral<unsigned char>*>(pg)[n].n;
+  }
+
+  /* Occupied slots (the sentinel excluded) that are reserved or, if
+   * reserved==false, published. Reserved slots are marked with the sentinel
+   * value, so regular layouts can tell them apart with a single SIMD read.
+   */
+
+  static inline int match_reserved(
+    group_type* pg,group_type* last,bool reserved=true)
+  {
+    auto occupied=super::match_really_occupied(pg,last);
+    auto sentinel=pg->match_sentinel();
+    return occupied&(reserved?sentinel:~sentinel);
+  }
+
+  template<typename GroupAccessMode>
+  static inline int match_really_occupied(
+    GroupAccessMode,group_type* pg,group_type* last)
+  {
+    return super::match_really_occupied(pg,last);
+  }
+
+  static inline int match_really_occupied(
+    group_unlocked,group_type* pg,group_type* last)
+  {
+    auto mask=match_reserved(pg,last,false);
+    for(auto m=mask;m;m&=m-1){
+      auto n=unchecked_countr_zero(m);
+      if(!is_occupied(group_unlocked{},pg,n))mask&=~(1<<n);
+    }
+    return mask;
+  }
+
+  /* Lock-free access reads the metadata of slot n with acquire semantics
+   * before touching the element, which pairs with the release store in
+   * claimed_slot::publish.
+   */
+
+  template<typename GroupAccessMode>
+  static inline bool is_occupied(
+    GroupAccessMode,group_type* pg,std::size_t n)
+  {
+    return is_occupied_impl(
+      std::is_base_of<group_unlocked,GroupAccessMode>{},pg,n);
+  }
+
+  static inline bool is_occupied_impl(
+    std::false_type,group_type* pg,std::size_t n)
+  {
+    return pg->is_occupied(n);
+  }
+
+  static inline bool is_occupied_impl(
+    std::true_type,group_type* pg,std::size_t n)
+  {
+    auto c=slot_metadata(pg,n).load(std::memory_order_acquire);
+    return c!=available_slot&&c!=reserved_slot;
+  }
+
+  template<typename GroupAccessMode>
+  static inline int match_for_lookup(
+    GroupAccessMode,const arrays_type&,group_type* pg,std::size_t hash)
+  {
+    return pg->match(hash);
+  }
+
+  static inline int match_for_lookup(
+    group_unlocked_sync,const arrays_type& arrays_,
+    group_type* pg,std::size_t hash)
+  {
+    /* dummy groups have sentinels of their own */
+    if(!arrays_.elements())return 0;
+
+    auto last=arrays_.groups()+arrays_.groups_size_mask+1;
+    for(unsigned k=0;match_reserved(pg,last);++k){
+      if(k<16)boost::core::sp_thread_pause();
+      else    boost::core::sp_thread_yield();
+    }
+    return pg->match(hash);
+  }
+
+  /* Returns N if no available slot could be claimed. */
+
+  static inline std::size_t claim_available_slot(group_type* pg)
+  {
+    for(auto mask=pg->match_available();mask;mask&=mask-1){
+      auto          n=unchecked_countr_zero(mask);
+      unsigned char c=available_slot;
+      if(slot_metadata(pg,n).compare_exchange_strong(
+        c,reserved_slot,std::memory_order_relaxed)){
+        return n;
+      }
+    }
+    return N;
+  }
+
+  struct claimed_slot
+  {
+    ~claimed_slot()
+    {
+      if(!commit_){
+        slot_metadata(pg,pos).store(available_slot,std::memory_order_relaxed);
+      }
+    }
+
+    void publish(std::size_t hash)
+    {
+      slot_metadata(pg,pos).store(
+        group_type::reduced_hash(hash),std::memory_order_release);
+      commit_=true;
+    }
+
+    group_type  *pg;
+    std::size_t pos;
+    bool        commit_=false;
+  };
+
   static inline const value_type&
   cast_for(group_shared,value_type& x){return x;}
 
+  static inline const value_type&
+  cast_for(group_unlocked,value_type& x){return x;}
+
+  static inline const value_type&
+  cast_for(group_frozen,value_type& x){return x;}
+
   static inline typename std::conditional<
     std::is_same<key_type,value_type>::value,
     const value_type&,
@@ -1207,23 +2548,88 @@ private:
   BOOST_FORCEINLINE std::size_t visit_impl(
     GroupAccessMode access_mode,const Key& x,F&& f)const
   {
+    if(frozen_for(access_mode)){
+      auto hash=this->hash_for(x);
+      return unprotected_visit(
+        frozen_access(access_mode),x,this->position_for(hash),hash,
+        std::forward<F>(f));
+    }
     auto lck=shared_access();
     auto hash=this->hash_for(x);
     return unprotected_visit(
       access_mode,x,this->position_for(hash),hash,std::forward<F>(f));
   }
 
+  template<typename GroupAccessMode,typename Key,typename F>
+  BOOST_FORCEINLINE std::size_t visit_impl(
+    GroupAccessMode access_mode,
+    const Key& x,precomputed_hash hash,F&& f)const
+  {
+    if(frozen_for(access_mode)){
+      auto hash_=this->hash_for(x,hash);
+      return unprotected_visit(
+        frozen_access(access_mode),x,this->position_for(hash_),hash_,
+        std::forward<F>(f));
+    }
+    auto lck=shared_access();
+    auto hash_=this->hash_for(x,hash);
+    return unprotected_visit(
+      access_mode,x,this->position_for(hash_),hash_,std::forward<F>(f));
+  }
+
+  template<typename GroupAccessMode,typename Key,typename F>
+  BOOST_FORCEINLINE try_result try_visit_impl(
+    GroupAccessMode access_mode,const Key& x,F&& f)const
+  {
+    if(frozen_for(access_mode)){
+      return visit_impl(access_mode,x,std::forward<F>(f))?
+        try_result::done:try_result::not_found;
+    }
+    auto lck=try_shared_access();
+    if(!lck.lck.owns_lock()||cooperative_rehash_in_progress()){
+      return try_result::would_block;
+    }
+    auto hash=this->hash_for(x);
+    return unprotected_try_visit(
+      access_mode,x,this->position_for(hash),hash,std::forward<F>(f));
+  }
+
+  template<typename GroupAccessMode,typename FwdIterator,typename F>
+  BOOST_FORCEINLINE
+  std::size_t bulk_visit_impl(
+    GroupAccessMode access_mode,FwdIterator first,FwdIterator last,F&& f)const
+  {
+    if(frozen_for(access_mode)){
+      return unprotected_bulk_visit(
+        frozen_access(access_mode),first,last,std::forward<F>(f));
+    }
+    auto lck=shared_access();
+    return unprotected_bulk_visit(
+      access_mode,first,last,std::forward<F>(f));
+  }
+
   template<typename GroupAccessMode,typename FwdIterator,typename F>
   BOOST_FORCEINLINE
-  std::size_t bulk_visit_impl(
+  std::size_t unprotected_bulk_visit(
     GroupAccessMode access_mode,FwdIterator first,FwdIterator last,F&& f)const
   {
-    auto        lck=shared_access();
     std::size_t res=0;
+#if defined(BOOST_UNORDERED_ENABLE_COOPERATIVE_REHASH)
+    if(BOOST_UNLIKELY(cooperative_rehash_in_progress())){
+      /* lookups must be forwarded to the new arrays one by one */
+      for(;first!=last;++first){
+        auto hash=this->hash_for(*first);
+        res+=unprotected_visit(
+          access_mode,*first,this->position_for(hash),hash,f);
+      }
+      return res;
+    }
+#endif
     auto        n=static_cast<std::size_t>(std::distance(first,last));
     while(n){
       auto m=n<2*bulk_visit_size?n:bulk_visit_size;
-      res+=unprotected_bulk_visit(access_mode,first,m,std::forward<F>(f));
+      res+=unprotected_bulk_visit(
+        unlocked_access(access_mode),first,m,std::forward<F>(f));
       n-=m;
       std::advance(
         first,
@@ -1236,9 +2642,12 @@ private:
   template<typename GroupAccessMode,typename F>
   std::size_t visit_all_impl(GroupAccessMode access_mode,F&& f)const
   {
-    auto lck=shared_access();
+    if(frozen_for(access_mode)){
+      return visit_all_impl(frozen_access(access_mode),std::forward<F>(f));
+    }
+    auto lck=shared_access(access_mode);
     std::size_t res=0;
-    for_all_elements(access_mode,[&](element_type* p){
+    for_all_elements(unlocked_access(access_mode),[&](element_type* p){
       f(cast_for(access_mode,type_policy::value_from(*p)));
       ++res;
     });
@@ -1250,9 +2659,15 @@ private:
   void visit_all_impl(
     GroupAccessMode access_mode,ExecutionPolicy&& policy,F&& f)const
   {
-    auto lck=shared_access();
+    if(frozen_for(access_mode)){
+      visit_all_impl(
+        frozen_access(access_mode),
+        std::forward<ExecutionPolicy>(policy),std::forward<F>(f));
+      return;
+    }
+    auto lck=shared_access(access_mode);
     for_all_elements(
-      access_mode,std::forward<ExecutionPolicy>(policy),
+      unlocked_access(access_mode),std::forward<ExecutionPolicy>(policy),
       [&](element_type* p){
         f(cast_for(access_mode,type_policy::value_from(*p)));
       });
@@ -1262,10 +2677,14 @@ private:
   template<typename GroupAccessMode,typename F>
   bool visit_while_impl(GroupAccessMode access_mode,F&& f)const
   {
-    auto lck=shared_access();
-    return for_all_elements_while(access_mode,[&](element_type* p){
-      return f(cast_for(access_mode,type_policy::value_from(*p)));
-    });
+    if(frozen_for(access_mode)){
+      return visit_while_impl(frozen_access(access_mode),std::forward<F>(f));
+    }
+    auto lck=shared_access(access_mode);
+    return for_all_elements_while(
+      unlocked_access(access_mode),[&](element_type* p){
+        return f(cast_for(access_mode,type_policy::value_from(*p)));
+      });
   }
 
 #if defined(BOOST_UNORDERED_PARALLEL_ALGORITHMS)
@@ -1273,21 +2692,59 @@ private:
   bool visit_while_impl(
     GroupAccessMode access_mode,ExecutionPolicy&& policy,F&& f)const
   {
-    auto lck=shared_access();
+    if(frozen_for(access_mode)){
+      return visit_while_impl(
+        frozen_access(access_mode),
+        std::forward<ExecutionPolicy>(policy),std::forward<F>(f));
+    }
+    auto lck=shared_access(access_mode);
     return for_all_elements_while(
-      access_mode,std::forward<ExecutionPolicy>(policy),
+      unlocked_access(access_mode),std::forward<ExecutionPolicy>(policy),
       [&](element_type* p){
         return f(cast_for(access_mode,type_policy::value_from(*p)));
       });
   }
 #endif
 
+  template<typename GroupAccessMode,typename F>
+  cursor visit_range_impl(
+    GroupAccessMode access_mode,cursor c,std::size_t max_groups,F&& f)const
+  {
+    BOOST_ASSERT(max_groups>0);
+    if(c.done_)return c;
+    if(frozen_for(access_mode)){
+      return visit_range_impl(
+        frozen_access(access_mode),c,max_groups,std::forward<F>(f));
+    }
+    auto lck=shared_access(access_mode);
+    return for_range_elements(
+      unlocked_access(access_mode),c,max_groups,[&](element_type* p){
+        f(cast_for(access_mode,type_policy::value_from(*p)));
+      });
+  }
+
   template<typename GroupAccessMode,typename Key,typename F>
   BOOST_FORCEINLINE std::size_t unprotected_visit(
     GroupAccessMode access_mode,
     const Key& x,std::size_t pos0,std::size_t hash,F&& f)const
   {
     return unprotected_internal_visit(
+#if defined(BOOST_UNORDERED_OPTIMISTIC_READS)
+      lookup_access(unlocked_access(access_mode)),
+#else
+      unlocked_access(access_mode),
+#endif
+      x,pos0,hash,
+      [&](group_type*,unsigned int,element_type* p)
+        {f(cast_for(access_mode,type_policy::value_from(*p)));});
+  }
+
+  template<typename GroupAccessMode,typename Key,typename F>
+  BOOST_FORCEINLINE try_result unprotected_try_visit(
+    GroupAccessMode access_mode,
+    const Key& x,std::size_t pos0,std::size_t hash,F&& f)const
+  {
+    return unprotected_try_internal_visit(
       access_mode,x,pos0,hash,
       [&](group_type*,unsigned int,element_type* p)
         {f(cast_for(access_mode,type_policy::value_from(*p)));});
@@ -1303,7 +2760,128 @@ private:
   BOOST_FORCEINLINE std::size_t unprotected_internal_visit(
     GroupAccessMode access_mode,
     const Key& x,std::size_t pos0,std::size_t hash,F&& f)const
+  {
+#if defined(BOOST_UNORDERED_ENABLE_COOPERATIVE_REHASH)
+    if(BOOST_UNLIKELY(cooperative_rehash_in_progress())&&
+       unprotected_old_arrays_visit(access_mode,x,hash,f)){
+      return 1;
+    }
+#endif
+
+    return unprotected_internal_visit(
+      access_mode,this->arrays,x,pos0,hash,std::forward<F>(f));
+  }
+
+#if defined(BOOST_UNORDERED_ENABLE_COOPERATIVE_REHASH)
+  /* Lookup in the old arrays locks each group before reading its metadata:
+   * if the element has already been migrated, acquiring the lock
+   * synchronizes with migrate_old_group and the element is then visible in
+   * the new arrays.
+   */
+
+  template<typename GroupAccessMode,typename Key,typename F>
+  BOOST_FORCEINLINE std::size_t unprotected_old_arrays_visit(
+    GroupAccessMode access_mode,const Key& x,std::size_t hash,F&& f)const
+  {
+    BOOST_UNORDERED_STATS_COUNTER(num_cmps);
+    prober pb(this->position_for(hash,old_arrays));
+    do{
+      auto pos=pb.get();
+      auto pg=old_arrays.groups()+pos;
+      auto lck=access(old_arrays_access(access_mode),old_arrays,pos);
+      auto mask=pg->match(hash);
+      if(mask){
+        auto p=old_arrays.elements()+pos*N;
+        do{
+          auto n=unchecked_countr_zero(mask);
+          BOOST_UNORDERED_INCREMENT_STATS_COUNTER(num_cmps);
+          if(BOOST_LIKELY(bool(this->pred()(x,this->key_from(p[n]))))){
+            f(pg,n,p+n);
+            BOOST_UNORDERED_ADD_STATS(
+              this->cstats.successful_lookup,(pb.length(),num_cmps));
+            return 1;
+          }
+          mask&=mask-1;
+        }while(mask);
+      }
+      if(BOOST_LIKELY(pg->is_not_overflowed(hash))){
+        BOOST_UNORDERED_ADD_STATS(
+          this->cstats.unsuccessful_lookup,(pb.length(),num_cmps));
+        return 0;
+      }
+    }
+    while(BOOST_LIKELY(pb.next(old_arrays.groups_size_mask)));
+    BOOST_UNORDERED_ADD_STATS(
+      this->cstats.unsuccessful_lookup,(pb.length(),num_cmps));
+    return 0;
+  }
+
+  /* Optimistic lookups lock old groups too. Lock-free insert-only and
+   * frozen tables don't rehash cooperatively.
+   */
+
+  template<typename GroupAccessMode>
+  static inline GroupAccessMode old_arrays_access(GroupAccessMode)
+  {
+    return {};
+  }
+
+#if defined(BOOST_UNORDERED_OPTIMISTIC_READS)
+  static inline group_shared old_arrays_access(group_optimistic){return {};}
+#endif
+#endif
+
+  template<typename GroupAccessMode,typename Key,typename F>
+  BOOST_FORCEINLINE std::size_t unprotected_internal_visit(
+    GroupAccessMode access_mode,const arrays_type& arrays_,
+    const Key& x,std::size_t pos0,std::size_t hash,F&& f)const
   {    
+    BOOST_UNORDERED_STATS_COUNTER(num_cmps);
+    prober pb(pos0);
+    do{
+      auto pos=pb.get();
+      auto pg=arrays_.groups()+pos;
+      auto mask=match_for_lookup(access_mode,arrays_,pg,hash);
+      if(mask){
+        auto p=arrays_.elements()+pos*N;
+        BOOST_UNORDERED_PREFETCH_ELEMENTS(p,N);
+        auto lck=access(access_mode,arrays_,pos);
+        do{
+          auto n=unchecked_countr_zero(mask);
+          if(BOOST_LIKELY(is_occupied(access_mode,pg,n))){
+            BOOST_UNORDERED_INCREMENT_STATS_COUNTER(num_cmps);
+            if(BOOST_LIKELY(bool(this->pred()(x,this->key_from(p[n]))))){
+              f(pg,n,p+n);
+              BOOST_UNORDERED_ADD_STATS(
+                this->cstats.successful_lookup,(pb.length(),num_cmps));
+              return 1;
+            }
+          }
+          mask&=mask-1;
+        }while(mask);
+      }
+      if(BOOST_LIKELY(pg->is_not_overflowed(hash))){
+        BOOST_UNORDERED_ADD_STATS(
+          this->cstats.unsuccessful_lookup,(pb.length(),num_cmps));
+        return 0;
+      }
+    }
+    while(BOOST_LIKELY(pb.next(arrays_.groups_size_mask)));
+    BOOST_UNORDERED_ADD_STATS(
+      this->cstats.unsuccessful_lookup,(pb.length(),num_cmps));
+    return 0;
+  }
+
+  /* Same as above with try_lock group access, on the current arrays only
+   * (callers bail out on cooperative rehashing) and bypassing optimistic
+   * reads, which may spin on concurrent writers.
+   */
+
+  template<typename GroupAccessMode,typename Key,typename F>
+  BOOST_FORCEINLINE try_result unprotected_try_internal_visit(
+    GroupAccessMode access_mode,
+    const Key& x,std::size_t pos0,std::size_t hash,F&& f)const
+  {
     BOOST_UNORDERED_STATS_COUNTER(num_cmps);
     prober pb(pos0);
     do{
@@ -1313,13 +2891,58 @@ private:
       if(mask){
         auto p=this->arrays.elements()+pos*N;
         BOOST_UNORDERED_PREFETCH_ELEMENTS(p,N);
-        auto lck=access(access_mode,pos);
+        auto lck=try_access(access_mode,pos);
+        if(BOOST_UNLIKELY(!lck.owns_lock()))return try_result::would_block;
         do{
           auto n=unchecked_countr_zero(mask);
           if(BOOST_LIKELY(pg->is_occupied(n))){
             BOOST_UNORDERED_INCREMENT_STATS_COUNTER(num_cmps);
             if(BOOST_LIKELY(bool(this->pred()(x,this->key_from(p[n]))))){
               f(pg,n,p+n);
+              BOOST_UNORDERED_ADD_STATS(
+                this->cstats.successful_lookup,(pb.length(),num_cmps));
+              return try_result::done;
+            }
+          }
+          mask&=mask-1;
+        }while(mask);
+      }
+      if(BOOST_LIKELY(pg->is_not_overflowed(hash))){
+        BOOST_UNORDERED_ADD_STATS(
+          this->cstats.unsuccessful_lookup,(pb.length(),num_cmps));
+        return try_result::not_found;
+      }
+    }
+    while(BOOST_LIKELY(pb.next(this->arrays.groups_size_mask)));
+    BOOST_UNORDERED_ADD_STATS(
+      this->cstats.unsuccessful_lookup,(pb.length(),num_cmps));
+    return try_result::not_found;
+  }
+
+#if defined(BOOST_UNORDERED_OPTIMISTIC_READS)
+  template<typename Key,typename F>
+  BOOST_FORCEINLINE std::size_t unprotected_internal_visit(
+    group_optimistic,const arrays_type& arrays_,
+    const Key& x,std::size_t pos0,std::size_t hash,F&& f)const
+  {    
+    BOOST_UNORDERED_STATS_COUNTER(num_cmps);
+    prober pb(pos0);
+    do{
+      auto pos=pb.get();
+      auto pg=arrays_.groups()+pos;
+      auto mask=pg->match(hash);
+      if(mask){
+        auto p=arrays_.elements()+pos*N;
+        BOOST_UNORDERED_PREFETCH_ELEMENTS(p,N);
+        auto& ver=arrays_.group_access_for(pos).version();
+        do{
+          auto n=unchecked_countr_zero(mask);
+          alignas(element_type) unsigned char buf[sizeof(element_type)];
+          auto pc=reinterpret_cast<element_type*>(buf);
+          if(BOOST_LIKELY(unprotected_optimistic_copy(ver,pg,n,p+n,pc))){
+            BOOST_UNORDERED_INCREMENT_STATS_COUNTER(num_cmps);
+            if(BOOST_LIKELY(bool(this->pred()(x,this->key_from(*pc))))){
+              f(pg,n,pc);
               BOOST_UNORDERED_ADD_STATS(
                 this->cstats.successful_lookup,(pb.length(),num_cmps));
               return 1;
@@ -1334,12 +2957,42 @@ private:
         return 0;
       }
     }
-    while(BOOST_LIKELY(pb.next(this->arrays.groups_size_mask)));
+    while(BOOST_LIKELY(pb.next(arrays_.groups_size_mask)));
     BOOST_UNORDERED_ADD_STATS(
       this->cstats.unsuccessful_lookup,(pb.length(),num_cmps));
     return 0;
   }
 
+  /* Copies the element at slot n of *pg into *pc unless the slot is not
+   * occupied, retrying until no exclusive group access overlaps with the
+   * copy. Writers bump the version with a release fence before modifying
+   * the group and release-store it when done, so an unchanged version
+   * after the acquire fence means the copy is not torn.
+   */
+
+  static BOOST_FORCEINLINE bool unprotected_optimistic_copy(
+    typename group_access::version_type& ver,
+    group_type* pg,unsigned int n,const element_type* p,element_type* pc)
+  {
+    for(;;){
+      auto v=ver.load(std::memory_order_acquire);
+      if(BOOST_LIKELY(!(v&1))){
+        if(!pg->is_occupied(n))return false;
+
+        /* reinterpret_cast: GCC may complain about element_type not being
+         * trivially copy-assignable.
+         */
+        std::memcpy(
+          reinterpret_cast<unsigned char*>(pc),
+          reinterpret_cast<const unsigned char*>(p),sizeof(element_type));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if(BOOST_LIKELY(ver.load(std::memory_order_relaxed)==v))return true;
+      }
+      boost::core::sp_thread_pause();
+    }
+  }
+#endif
+
  template<typename GroupAccessMode,typename FwdIterator,typename F>
   BOOST_FORCEINLINE std::size_t unprotected_bulk_visit(
     GroupAccessMode access_mode,FwdIterator first,std::size_t m,F&& f)const
@@ -1363,7 +3016,7 @@ private:
       auto pos=positions[i];
       auto mask=masks[i]=(this->arrays.groups()+pos)->match(hash);
       if(mask){
-        BOOST_UNORDERED_PREFETCH(this->arrays.group_accesses()+pos);
+        BOOST_UNORDERED_PREFETCH(&this->arrays.group_access_for(pos));
         BOOST_UNORDERED_PREFETCH(
           this->arrays.elements()+pos*N+unchecked_countr_zero(mask));
       }
@@ -1384,7 +3037,7 @@ private:
           auto lck=access(access_mode,pos);
           do{
             auto n=unchecked_countr_zero(mask);
-            if(BOOST_LIKELY(pg->is_occupied(n))){
+            if(BOOST_LIKELY(is_occupied(access_mode,pg,n))){
               BOOST_UNORDERED_INCREMENT_STATS_COUNTER(num_cmps);
               if(bool(this->pred()(*it,this->key_from(p[n])))){
                 f(cast_for(access_mode,type_policy::value_from(p[n])));
@@ -1423,8 +3076,13 @@ private:
 
   std::size_t unprotected_size()const
   {
+    std::size_t c=0;
+    for(std::size_t i=0;i<mutexes.size();++i){
+      c+=mutexes[i].size_credits.load(std::memory_order_relaxed);
+    }
     std::size_t m=this->size_ctrl.ml;
     std::size_t s=this->size_ctrl.size;
+    s=s>c?s-c:0;
     return s<=m?s:m;
   }
 
@@ -1504,7 +3162,15 @@ private:
     int res=unprotected_norehash_emplace_and_visit(
       access_mode,std::forward<F1>(f1),std::forward<F2>(f2),
       type_policy::move(x.value()));
-    if(BOOST_LIKELY(res>=0))return res!=0;
+    if(BOOST_LIKELY(res>=0)){
+#if defined(BOOST_UNORDERED_ENABLE_COOPERATIVE_REHASH)
+      if(BOOST_UNLIKELY(release_due.load(std::memory_order_relaxed))){
+        lck.unlock();
+        release_cooperative_rehash();
+      }
+#endif
+      return res!=0;
+    }
 
     lck.unlock();
 
@@ -1514,6 +3180,32 @@ private:
       type_policy::move(x.value()));
   }
 
+  template<
+    typename GroupAccessMode,typename Key,typename Factory,typename F
+  >
+  bool compute_if_absent_impl(
+    GroupAccessMode access_mode,Key&& x,Factory&& factory,F&& f)
+  {
+    if(visit_impl(access_mode,x,f))return false;
+
+    auto hash=this->hash_for(x);
+    for(;;){
+      auto reg=pending_registry::instance().try_register(this,hash);
+      if(!reg){ /* waited for an equivalent computation */
+        if(visit_impl(access_mode,x,f))return false;
+        continue;
+      }
+
+      /* x may have been inserted before registration */
+      if(visit_impl(access_mode,x,f))return false;
+      auto&& v=factory();
+      return emplace_or_visit_impl(
+        access_mode,std::forward<F>(f),
+        try_emplace_args_t{},std::forward<Key>(x),
+        std::forward<decltype(v)>(v));
+    }
+  }
+
   template<typename... Args>
   BOOST_FORCEINLINE bool emplace_impl(Args&&... args)
   {
@@ -1594,20 +3286,217 @@ private:
       std::forward<Args>(args)...);
   }
 
-  template<typename GroupAccessMode,typename F1,typename F2,typename... Args>
-  BOOST_FORCEINLINE bool emplace_and_visit_impl(
-    GroupAccessMode access_mode,F1&& f1,F2&& f2,Args&&... args)
-  {
-    for(;;){
-      {
-        auto lck=shared_access();
-        int res=unprotected_norehash_emplace_and_visit(
-          access_mode,std::forward<F1>(f1),std::forward<F2>(f2),
-          std::forward<Args>(args)...);
-        if(BOOST_LIKELY(res>=0))return res!=0;
+  template<typename GroupAccessMode,typename F1,typename F2,typename... Args>
+  BOOST_FORCEINLINE bool emplace_and_visit_impl(
+    GroupAccessMode access_mode,F1&& f1,F2&& f2,Args&&... args)
+  {
+    for(;;){
+      {
+        auto lck=shared_access();
+        int res=unprotected_norehash_emplace_and_visit(
+          access_mode,std::forward<F1>(f1),std::forward<F2>(f2),
+          std::forward<Args>(args)...);
+        if(BOOST_LIKELY(res>=0)){
+#if defined(BOOST_UNORDERED_ENABLE_COOPERATIVE_REHASH)
+          if(BOOST_UNLIKELY(release_due.load(std::memory_order_relaxed))){
+            lck.unlock();
+            release_cooperative_rehash();
+          }
+#endif
+          return res!=0;
+        }
+      }
+      rehash_if_full();
+    }
+  }
+
+  struct call_try_visit_or_emplace_impl
+  {
+    template<typename... Args>
+    BOOST_FORCEINLINE try_result operator()(
+      concurrent_table* this_,Args&&... args)const
+    {
+      return this_->try_visit_or_emplace_impl(std::forward<Args>(args)...);
+    }
+  };
+
+  template<typename GroupAccessMode,typename... Args>
+  BOOST_FORCEINLINE try_result try_visit_or_emplace_flast(
+    GroupAccessMode access_mode,Args&&... args)
+  {
+    return mp11::tuple_apply(
+      call_try_visit_or_emplace_impl{},
+      std::tuple_cat(
+        std::make_tuple(this,access_mode),
+        tuple_rotate_right(std::forward_as_tuple(std::forward<Args>(args)...))
+      )
+    );
+  }
+
+  /* As norehash_emplace_and_visit_at (locked version) with no waiting:
+   * rather than rehashing, helping a cooperative rehash or blocking on a
+   * busy group, try_result::would_block is returned.
+   */
+
+  template<typename GroupAccessMode,typename F,typename... Args>
+  try_result try_visit_or_emplace_impl(
+    GroupAccessMode access_mode,F&& f,Args&&... args)
+  {
+    auto lck=try_shared_access();
+    if(!lck.lck.owns_lock()||cooperative_rehash_in_progress()){
+      return try_result::would_block;
+    }
+
+    const auto &k=this->key_from(std::forward<Args>(args)...);
+    auto        hash=this->hash_for(k);
+    auto        pos0=this->position_for(hash);
+
+    for(;;){
+    startover:
+      boost::uint32_t counter=insert_counter(pos0);
+      auto            res=unprotected_try_visit(
+        access_mode,k,pos0,hash,std::forward<F>(f));
+      if(res!=try_result::not_found)return res;
+
+      reserve_size rsize(*this);
+      if(BOOST_UNLIKELY(!rsize.succeeded()))return try_result::would_block;
+      for(prober pb(pos0);;pb.next(this->arrays.groups_size_mask)){
+        auto pos=pb.get();
+        auto pg=this->arrays.groups()+pos;
+        auto glck=try_access(group_exclusive{},pos);
+        if(BOOST_UNLIKELY(!glck.owns_lock()))return try_result::would_block;
+        auto mask=pg->match_available();
+        if(BOOST_LIKELY(mask!=0)){
+          auto n=unchecked_countr_zero(mask);
+          reserve_slot rslot{pg,n,hash};
+          if(BOOST_UNLIKELY(insert_counter(pos0)++!=counter)){
+            /* other thread inserted from pos0, need to start over */
+            BOOST_UNORDERED_ADD_STATS(
+              this->contention_cstats.insertion_rollback,());
+            goto startover;
+          }
+          auto p=this->arrays.elements()+pos*N+n;
+          this->construct_element(p,std::forward<Args>(args)...);
+          rslot.commit();
+          rsize.commit();
+          BOOST_UNORDERED_ADD_STATS(this->cstats.insertion,(pb.length()));
+          return try_result::not_found;
+        }
+        pg->mark_overflow(hash);
+      }
+    }
+  }
+
+  template<typename InputIterator>
+  using is_bulk_insertable=std::integral_constant<
+    bool,
+    std::is_base_of<
+      std::forward_iterator_tag,
+      typename std::iterator_traits<InputIterator>::iterator_category
+    >::value&&(
+      std::is_same<
+        typename std::iterator_traits<InputIterator>::value_type,
+        value_type>::value||
+      std::is_same<
+        typename std::iterator_traits<InputIterator>::value_type,
+        init_type>::value)
+  >;
+
+  template<
+    typename GroupAccessMode,typename InputIterator,typename F1,typename F2
+  >
+  std::size_t insert_range_and_visit(
+    GroupAccessMode access_mode,InputIterator first,InputIterator last,
+    F1&& f1,F2&& f2)
+  {
+    return insert_range_and_visit(
+      access_mode,first,last,f1,f2,is_bulk_insertable<InputIterator>{});
+  }
+
+  template<
+    typename GroupAccessMode,typename InputIterator,typename F1,typename F2
+  >
+  std::size_t insert_range_and_visit(
+    GroupAccessMode access_mode,InputIterator first,InputIterator last,
+    F1& f1,F2& f2,std::false_type /* element by element */)
+  {
+    std::size_t res=0;
+    for(;first!=last;++first,++res){
+      construct_and_emplace_and_visit(access_mode,f1,f2,*first);
+    }
+    return res;
+  }
+
+  template<
+    typename GroupAccessMode,typename FwdIterator,typename F1,typename F2
+  >
+  std::size_t insert_range_and_visit(
+    GroupAccessMode access_mode,FwdIterator first,FwdIterator last,
+    F1& f1,F2& f2,std::true_type /* bulk */)
+  {
+    std::size_t res=0;
+    std::size_t hashes[bulk_visit_size];
+    std::size_t i=0,m=0;
+    while(first!=last){
+      bool full;
+      {
+        auto lck=shared_access();
+        full=unprotected_bulk_insert_and_visit(
+          access_mode,first,last,hashes,i,m,res,f1,f2);
+      }
+#if defined(BOOST_UNORDERED_ENABLE_COOPERATIVE_REHASH)
+      if(BOOST_UNLIKELY(release_due.load(std::memory_order_relaxed))){
+        release_cooperative_rehash();
+      }
+#endif
+      if(full)rehash_if_full();
+    }
+    return res;
+  }
+
+  /* Inserts from [first,last) bulk_visit_size elements at a time, advancing
+   * first and res. hashes[i,m) hold the hash values of the elements
+   * starting at first, which are kept across calls so that a window
+   * interrupted by a rehash is not hashed again. Stops and returns true if
+   * the container is full, and also stops if a cooperative rehash is to be
+   * released.
+   */
+
+  template<
+    typename GroupAccessMode,typename FwdIterator,typename F1,typename F2
+  >
+  BOOST_FORCEINLINE bool unprotected_bulk_insert_and_visit(
+    GroupAccessMode access_mode,FwdIterator& first,FwdIterator last,
+    std::size_t (&hashes)[bulk_visit_size],std::size_t& i,std::size_t& m,
+    std::size_t& res,F1& f1,F2& f2)
+  {
+    do{
+#if defined(BOOST_UNORDERED_ENABLE_COOPERATIVE_REHASH)
+      if(BOOST_UNLIKELY(cooperative_rehash_in_progress())){
+        help_cooperative_rehash();
+      }
+#endif
+
+      if(i==m){
+        i=m=0;
+        for(auto it=first;m<bulk_visit_size&&it!=last;++m,++it){
+          auto hash=hashes[m]=this->hash_for(this->key_from(*it));
+          BOOST_UNORDERED_PREFETCH(
+            this->arrays.groups()+this->position_for(hash));
+        }
+      }
+      for(;i<m;++i,++first,++res){
+        if(BOOST_UNLIKELY(unprotected_norehash_emplace_and_visit_at(
+          access_mode,hashes[i],f1,f2,*first)<0))return true;
+      }
+
+#if defined(BOOST_UNORDERED_ENABLE_COOPERATIVE_REHASH)
+      if(BOOST_UNLIKELY(release_due.load(std::memory_order_relaxed))){
+        return false;
       }
-      rehash_if_full();
-    }
+#endif
+    }while(first!=last);
+    return false;
   }
 
   template<typename... Args>
@@ -1638,27 +3527,101 @@ private:
       std::forward<F>(f),std::forward<Args>(args)...);
   }
 
+  /* Size credits: so as not to have all insertions and erasures contend on
+   * size_ctrl.size, units of size are reserved in chunks and kept as credits
+   * in the multimutex slot of the thread (sharing the cache line of the
+   * slot's mutex), to be used by subsequent insertions and replenished by
+   * erasures from threads assigned to the same slot. size_ctrl.size thus
+   * overcounts the number of elements by the credits outstanding, which are
+   * reclaimed on container-level write locking (see reclaiming_lock_guard).
+   * Chunks are only reserved when far from the maximum load, so close to
+   * growth insertion reverts to reserving one unit at a time and growth is
+   * triggered at exactly the same size as without credits.
+   */
+
+  static constexpr std::size_t size_credit_chunk=16;
+
+  std::atomic<std::size_t>& size_credits()const noexcept
+  {
+    return mutexes.slot(thread_slot::id()).size_credits;
+  }
+
+  bool size_credit_chunk_allowed()const noexcept
+  {
+    std::size_t m=this->size_ctrl.ml;
+    std::size_t s=this->size_ctrl.size;
+    return m>s&&m-s>=2*size_credit_chunk*mutexes.size();
+  }
+
   struct reserve_size
   {
-    reserve_size(concurrent_table& x_):x(x_)
+    reserve_size(concurrent_table& x_):x(x_),credits(x.size_credits())
     {
-      size_=++x.size_ctrl.size;
+      auto c=credits.load(std::memory_order_relaxed);
+      while(c){
+        if(credits.compare_exchange_weak(c,c-1,std::memory_order_relaxed)){
+          succeeded_=true;
+          return;
+        }
+      }
+
+      if(x.size_credit_chunk_allowed()){
+        std::size_t s=(x.size_ctrl.size+=size_credit_chunk);
+        if(BOOST_LIKELY(s<=x.size_ctrl.ml)){
+          credits.fetch_add(size_credit_chunk-1,std::memory_order_relaxed);
+          succeeded_=true;
+          return;
+        }
+        x.size_ctrl.size-=size_credit_chunk;
+      }
+
+      succeeded_=++x.size_ctrl.size<=x.size_ctrl.ml;
     }
 
     ~reserve_size()
     {
-      if(!commit_)--x.size_ctrl.size;
+      if(!commit_){
+        /* a successfully reserved unit can be kept as a credit */
+        if(succeeded_)credits.fetch_add(1,std::memory_order_relaxed);
+        else          --x.size_ctrl.size;
+      }
     }
 
-    bool succeeded()const{return size_<=x.size_ctrl.ml;}
+    bool succeeded()const{return succeeded_;}
 
     void commit(){commit_=true;}
 
-    concurrent_table &x;
-    std::size_t       size_;
-    bool              commit_=false;
+    concurrent_table         &x;
+    std::atomic<std::size_t> &credits;
+    bool                      succeeded_=false;
+    bool                      commit_=false;
   };
 
+  /* Same as super::erase, but the size unit freed is kept as a credit unless
+   * the maximum load is to be decreased along (see recover_slot), so that
+   * size_ctrl.size does not go over size_ctrl.ml. Requires container-level
+   * read locking.
+   */
+  void unprotected_erase(group_type* pg,unsigned int pos,element_type* p)
+  {
+    this->destroy_element(p);
+    auto pc=reinterpret_cast<unsigned char*>(pg)+pos;
+    if(group_type::maybe_caused_overflow(pc)){
+      this->recover_slot(pc);
+      return;
+    }
+
+    group_type::reset(pc);
+    auto& credits=size_credits();
+    auto  c=credits.fetch_add(1,std::memory_order_relaxed)+1;
+    if(c>=3*size_credit_chunk&&
+       credits.compare_exchange_strong(
+         c,c-2*size_credit_chunk,std::memory_order_relaxed)){
+      /* give excess credits back */
+      this->size_ctrl.size-=2*size_credit_chunk;
+    }
+  }
+
   struct reserve_slot
   {
     reserve_slot(group_type* pg_,std::size_t pos_,std::size_t hash):
@@ -1684,8 +3647,36 @@ private:
   unprotected_norehash_emplace_and_visit(
     GroupAccessMode access_mode,F1&& f1,F2&& f2,Args&&... args)
   {
+#if defined(BOOST_UNORDERED_ENABLE_COOPERATIVE_REHASH)
+    if(BOOST_UNLIKELY(cooperative_rehash_in_progress())){
+      help_cooperative_rehash();
+    }
+#endif
+
+    return unprotected_norehash_emplace_and_visit_at(
+      access_mode,this->hash_for(this->key_from(std::forward<Args>(args)...)),
+      std::forward<F1>(f1),std::forward<F2>(f2),std::forward<Args>(args)...);
+  }
+
+  template<typename GroupAccessMode,typename F1,typename F2,typename... Args>
+  BOOST_FORCEINLINE int
+  unprotected_norehash_emplace_and_visit_at(
+    GroupAccessMode access_mode,std::size_t hash,
+    F1&& f1,F2&& f2,Args&&... args)
+  {
+    BOOST_ASSERT(!is_frozen());
+    return norehash_emplace_and_visit_at(
+      lockfree_insert_only{},access_mode,hash,
+      std::forward<F1>(f1),std::forward<F2>(f2),std::forward<Args>(args)...);
+  }
+
+  template<typename GroupAccessMode,typename F1,typename F2,typename... Args>
+  BOOST_FORCEINLINE int
+  norehash_emplace_and_visit_at(
+    std::false_type /* locked */,GroupAccessMode access_mode,std::size_t hash,
+    F1&& f1,F2&& f2,Args&&... args)
+  {
     const auto &k=this->key_from(std::forward<Args>(args)...);
-    auto        hash=this->hash_for(k);
     auto        pos0=this->position_for(hash);
 
     for(;;){
@@ -1706,6 +3697,8 @@ private:
             reserve_slot rslot{pg,n,hash};
             if(BOOST_UNLIKELY(insert_counter(pos0)++!=counter)){
               /* other thread inserted from pos0, need to start over */
+              BOOST_UNORDERED_ADD_STATS(
+                this->contention_cstats.insertion_rollback,());
               goto startover;
             }
             auto p=this->arrays.elements()+pos*N+n;
@@ -1723,14 +3716,355 @@ private:
     }
   }
 
+  /* Insert-only tables don't allow modification of their elements, so both
+   * f1 and f2 are given const access.
+   */
+
+  template<typename GroupAccessMode,typename F1,typename F2,typename... Args>
+  BOOST_FORCEINLINE int
+  norehash_emplace_and_visit_at(
+    std::true_type /* lock-free */,GroupAccessMode,std::size_t hash,
+    F1&& f1,F2&& f2,Args&&... args)
+  {
+    const auto &k=this->key_from(std::forward<Args>(args)...);
+    auto        pos0=this->position_for(hash);
+
+    for(;;){
+    startover:
+      boost::uint32_t counter=insert_counter(pos0);
+      if(unprotected_internal_visit(
+        group_unlocked_sync{},k,pos0,hash,
+        [&](group_type*,unsigned int,element_type* p)
+          {f2(cast_for(group_unlocked{},type_policy::value_from(*p)));})){
+        return 0;
+      }
+
+      reserve_size rsize(*this);
+      if(BOOST_LIKELY(rsize.succeeded())){
+        for(prober pb(pos0);;pb.next(this->arrays.groups_size_mask)){
+          auto pos=pb.get();
+          auto pg=this->arrays.groups()+pos;
+          auto n=claim_available_slot(pg);
+          if(BOOST_LIKELY(n!=N)){
+            claimed_slot cslot{pg,n};
+            if(BOOST_UNLIKELY(insert_counter(pos0)++!=counter)){
+              /* other thread inserted from pos0, need to start over */
+              BOOST_UNORDERED_ADD_STATS(
+                this->contention_cstats.insertion_rollback,());
+              goto startover;
+            }
+            auto p=this->arrays.elements()+pos*N+n;
+            this->construct_element(p,std::forward<Args>(args)...);
+            cslot.publish(hash);
+            rsize.commit();
+            f1(cast_for(group_unlocked{},type_policy::value_from(*p)));
+            BOOST_UNORDERED_ADD_STATS(this->cstats.insertion,(pb.length()));
+            return 1;
+          }
+          pg->mark_overflow(hash);
+        }
+      }
+      else return -1;
+    }
+  }
+
+  /* Calls f, a rehash operation, and records its duration if the bucket
+   * array changed.
+   */
+
+  template<typename F>
+  void timed_rehash(F f)
+  {
+#if defined(BOOST_UNORDERED_ENABLE_STATS)
+    auto groups0=this->arrays.groups();
+    auto t0=std::chrono::steady_clock::now();
+    f();
+    if(this->arrays.groups()!=groups0){
+      std::chrono::duration<double> d=std::chrono::steady_clock::now()-t0;
+      BOOST_UNORDERED_ADD_STATS(contention_cstats.rehash_time,(d.count()));
+      contention_cstats.hot_groups.reset();
+    }
+#else
+    f();
+#endif
+  }
+
   void rehash_if_full()
   {
+#if defined(BOOST_UNORDERED_ENABLE_COOPERATIVE_REHASH)
+    if(cooperative_rehash){
+      cooperative_rehash_if_full();
+      return;
+    }
+#endif
+
     auto lck=exclusive_access();
     if(this->size_ctrl.size==this->size_ctrl.ml){
-      this->unchecked_rehash_for_growth();
+      if(is_bounded<TypePolicy>::value&&
+         this->size_ctrl.size<this->initial_max_load()){
+        /* bounded tables only need anti-drift to be undone */
+        this->unchecked_recalculate_overflow();
+      }
+      else timed_rehash([this]{this->unchecked_rehash_for_growth();});
+    }
+  }
+
+  bool cooperative_rehash_in_progress()const noexcept
+  {
+#if defined(BOOST_UNORDERED_ENABLE_COOPERATIVE_REHASH)
+    return old_arrays.elements()!=nullptr;
+#else
+    return false;
+#endif
+  }
+
+  /* The functions below require container-level write locking: the
+   * const ones are called on tables being copied or compared and are
+   * logically const.
+   */
+
+  void finish_cooperative_rehash()const
+  {
+#if defined(BOOST_UNORDERED_ENABLE_COOPERATIVE_REHASH)
+    if(cooperative_rehash_in_progress()){
+      const_cast<concurrent_table*>(this)->unprotected_finish_cooperative_rehash();
+    }
+#endif
+  }
+
+  void discard_cooperative_rehash()noexcept
+  {
+#if defined(BOOST_UNORDERED_ENABLE_COOPERATIVE_REHASH)
+    if(cooperative_rehash_in_progress()){
+      super::for_all_elements(old_arrays,[this](element_type* p){
+        this->destroy_element(p);
+        --this->size_ctrl.size;
+      });
+      release_old_arrays();
+    }
+#endif
+  }
+
+  void swap_cooperative_rehash_state(concurrent_table& x)noexcept
+  {
+#if defined(BOOST_UNORDERED_ENABLE_COOPERATIVE_REHASH)
+    std::swap(old_arrays,x.old_arrays);
+    swap_atomic(claimed_groups,x.claimed_groups);
+    swap_atomic(migrated_groups,x.migrated_groups);
+    swap_atomic(migration_failed,x.migration_failed);
+    swap_atomic(release_due,x.release_due);
+#else
+    (void)x;
+#endif
+  }
+
+#if defined(BOOST_UNORDERED_ENABLE_COOPERATIVE_REHASH)
+  template<typename T>
+  static void swap_atomic(std::atomic<T>& x,std::atomic<T>& y)noexcept
+  {
+    T tmp=x;
+    x=static_cast<T>(y);
+    y=tmp;
+  }
+
+  BOOST_NOINLINE void cooperative_rehash_if_full()
+  {
+    /* Only one thread at a time prepares the new arrays, others retry
+     * insertion till these are installed.
+     */
+    if(growth_pending.exchange(true)){
+      boost::core::sp_thread_yield();
+      return;
+    }
+
+    struct clear_pending_on_exit
+    {
+      ~clear_pending_on_exit(){x.growth_pending=false;}
+
+      concurrent_table &x;
+    } c{*this};
+    (void)c; /* unused var warning */
+
+    /* The new arrays are allocated and initialized, which may take a while,
+     * with lookups and visitation still going on.
+     */
+    auto lck=shared_access();
+    if(this->size_ctrl.size<this->size_ctrl.ml)return;
+
+    /* If the table is not really full but there are size credits outstanding,
+     * write locking reclaims them and no growth takes place.
+     */
+    if(cooperative_rehash_in_progress()||!super::size()||
+       unprotected_size()<this->size_ctrl.ml||
+       this->growth_fits_in_place()){
+      lck.unlock();
+      auto xlck=exclusive_access();
+      if(this->size_ctrl.size==this->size_ctrl.ml){
+        finish_cooperative_rehash();
+        timed_rehash([this]{this->unchecked_rehash_for_growth();});
+      }
+      return;
+    }
+
+    Allocator   al_=this->al();
+    auto        elements0=this->arrays.elements();
+    auto        new_arrays_=this->new_arrays_for_growth();
+    std::size_t new_capacity=(new_arrays_.groups_size_mask+1)*N-1;
+    lck.unlock();
+
+    auto xlck=exclusive_access();
+    if(this->size_ctrl.size!=this->size_ctrl.ml||
+       this->arrays.elements()!=elements0||
+       cooperative_rehash_in_progress()||
+       this->capacity_for(this->slots_for_growth())!=new_capacity){
+      /* table changed (maybe swapped) in the meantime */
+      arrays_type::delete_(
+        typename arrays_type::allocator_type(al_),new_arrays_);
+      if(this->size_ctrl.size==this->size_ctrl.ml){
+        finish_cooperative_rehash();
+        timed_rehash([this]{this->unchecked_rehash_for_growth();});
+      }
+      return;
+    }
+
+    old_arrays=this->arrays;
+    this->arrays=new_arrays_;
+    this->size_ctrl.ml=this->initial_max_load();
+    BOOST_UNORDERED_ADD_STATS(this->cstats.rehash,());
+#if defined(BOOST_UNORDERED_ENABLE_STATS)
+    contention_cstats.hot_groups.reset();
+#endif
+  }
+
+  bool cooperative_rehash_leftovers()const noexcept
+  {
+    return
+      cooperative_rehash_in_progress()&&
+      migration_failed.load(std::memory_order_relaxed);
+  }
+
+  /* Migrates the next unclaimed chunk of old groups, if any. Element transfer
+   * does not throw, but hashing might: in this case the element is left in
+   * the old arrays, lookup can still reach it, and migration_failed tells
+   * that there are leftovers to be taken care of in
+   * finish_cooperative_rehash.
+   */
+
+  BOOST_NOINLINE void help_cooperative_rehash()
+  {
+    auto groups_size=old_arrays.groups_size_mask+1;
+    auto first=claimed_groups.fetch_add(
+      cooperative_rehash_groups,std::memory_order_relaxed);
+    if(first>=groups_size)return;
+
+    auto last=(std::min)(first+cooperative_rehash_groups,groups_size);
+    BOOST_TRY{
+      for(auto pos=first;pos!=last;++pos)migrate_old_group(pos);
+    }
+    BOOST_CATCH(...){
+      migration_failed=true;
+      migrated_groups+=last-first;
+      BOOST_RETHROW
+    }
+    BOOST_CATCH_END
+    if((migrated_groups+=last-first)==groups_size&&!migration_failed){
+      /* old arrays freed by the next insertion after unlocking */
+      release_due=true;
+    }
+  }
+
+  /* Full traversals need all elements to stay in place. */
+
+  void complete_cooperative_rehash()const
+  {
+    if(BOOST_UNLIKELY(cooperative_rehash_in_progress())){
+      auto groups_size=old_arrays.groups_size_mask+1;
+      while(claimed_groups.load(std::memory_order_relaxed)<groups_size){
+        const_cast<concurrent_table*>(this)->help_cooperative_rehash();
+      }
+      while(migrated_groups<groups_size)boost::core::sp_thread_yield();
+    }
+  }
+
+  void migrate_old_group(std::size_t pos)
+  {
+    auto pg=old_arrays.groups()+pos;
+    auto p=old_arrays.elements()+pos*N;
+    auto lck=access(group_exclusive{},old_arrays,pos);
+    auto mask=super::match_really_occupied(
+      pg,old_arrays.groups()+old_arrays.groups_size_mask+1);
+    while(mask){
+      auto n=unchecked_countr_zero(mask);
+      migrate_element(p+n);
+      pg->reset(n);
+      mask&=mask-1;
+    }
+  }
+
+  void migrate_element(element_type* p)
+  {
+    auto hash=this->hash_for(this->key_from(*p));
+    for(prober pb(this->position_for(hash));;
+        pb.next(this->arrays.groups_size_mask)){
+      auto pos=pb.get();
+      auto pg=this->arrays.groups()+pos;
+      auto lck=access(group_exclusive{},pos);
+      auto mask=pg->match_available();
+      if(BOOST_LIKELY(mask!=0)){
+        auto n=unchecked_countr_zero(mask);
+        auto p1=this->arrays.elements()+pos*N+n;
+        this->construct_element(p1,type_policy::move(*p));
+        this->destroy_element(p);
+        pg->set(n,hash);
+        return;
+      }
+      pg->mark_overflow(hash);
+    }
+  }
+
+  void unprotected_finish_cooperative_rehash()
+  {
+    /* no helping threads around: resume after claimed groups or, if there
+     * are leftovers, sweep the old arrays
+     */
+    auto groups_size=old_arrays.groups_size_mask+1;
+    auto pos=migration_failed?
+      0:(std::min)(std::size_t(claimed_groups),groups_size);
+    BOOST_TRY{
+      for(;pos!=groups_size;++pos)migrate_old_group(pos);
+    }
+    BOOST_CATCH(...){
+      migration_failed=true;
+      claimed_groups=groups_size;
+      migrated_groups=groups_size;
+      BOOST_RETHROW
+    }
+    BOOST_CATCH_END
+    release_old_arrays();
+  }
+
+  BOOST_NOINLINE void release_cooperative_rehash()
+  {
+    if(!release_due.exchange(false))return;
+
+    auto lck=exclusive_access();
+    if(cooperative_rehash_in_progress()&&
+       migrated_groups==old_arrays.groups_size_mask+1&&!migration_failed){
+      release_old_arrays();
     }
   }
 
+  void release_old_arrays()noexcept
+  {
+    this->delete_arrays(old_arrays);
+    old_arrays=arrays_type{{0,0,nullptr,nullptr},nullptr};
+    claimed_groups=0;
+    migrated_groups=0;
+    migration_failed=false;
+    release_due=false;
+  }
+#endif
+
   template<typename GroupAccessMode,typename F>
   auto for_all_elements(GroupAccessMode access_mode,F f)const
     ->decltype(f(nullptr),void())
@@ -1760,12 +4094,26 @@ private:
   auto for_all_elements_while(GroupAccessMode access_mode,F f)const
     ->decltype(f(nullptr,0,nullptr),bool())
   {
-    auto p=this->arrays.elements();
+#if defined(BOOST_UNORDERED_ENABLE_COOPERATIVE_REHASH)
+    complete_cooperative_rehash();
+    if(BOOST_UNLIKELY(cooperative_rehash_leftovers())&&
+       !for_all_elements_while_in(old_arrays,access_mode,f))return false;
+#endif
+
+    return for_all_elements_while_in(this->arrays,access_mode,f);
+  }
+
+  template<typename GroupAccessMode,typename F>
+  bool for_all_elements_while_in(
+    const arrays_type& arrays_,GroupAccessMode access_mode,F& f)const
+  {
+    auto p=arrays_.elements();
     if(p){
-      for(auto pg=this->arrays.groups(),last=pg+this->arrays.groups_size_mask+1;
+      for(auto pg=arrays_.groups(),last=pg+arrays_.groups_size_mask+1;
           pg!=last;++pg,p+=N){
-        auto lck=access(access_mode,(std::size_t)(pg-this->arrays.groups()));
-        auto mask=this->match_really_occupied(pg,last);
+        auto lck=access(
+          access_mode,arrays_,(std::size_t)(pg-arrays_.groups()));
+        auto mask=match_really_occupied(access_mode,pg,last);
         while(mask){
           auto n=unchecked_countr_zero(mask);
           if(!f(pg,n,p+n))return false;
@@ -1776,6 +4124,81 @@ private:
     return true;
   }
 
+  /* Visits the elements with hash values in [c.next,res.next), res being the
+   * returned cursor, which spans max_groups home groups of the current arrays
+   * (fewer at the end). Cursors are positions in hash value space, and
+   * home positions grow with hash values (see pow2_size_policy::position),
+   * so slices don't depend on the arrays they were computed on: elements
+   * present during a whole sequence of calls are visited exactly once even
+   * if the table is rehashed in between.
+   */
+
+  template<typename GroupAccessMode,typename F>
+  cursor for_range_elements(
+    GroupAccessMode access_mode,cursor c,std::size_t max_groups,F f)const
+  {
+    cursor res;
+    res.done_=true;
+    if(!this->arrays.elements())return res;
+
+    auto groups_size=this->arrays.groups_size_mask+1,
+         first=this->position_for(c.next),
+         last=first+(std::min)(max_groups,groups_size-first);
+    if(last!=groups_size){
+      res.next=last<<this->arrays.groups_size_index;
+      res.done_=false;
+    }
+
+#if defined(BOOST_UNORDERED_ENABLE_COOPERATIVE_REHASH)
+    complete_cooperative_rehash();
+    if(BOOST_UNLIKELY(cooperative_rehash_leftovers())){
+      for_range_elements_in(old_arrays,access_mode,c,res,f);
+    }
+#endif
+
+    for_range_elements_in(this->arrays,access_mode,c,res,f);
+    return res;
+  }
+
+  /* Elements with home positions in the range are reached by probing from
+   * each home group as long as overflow bits tell there may be more.
+   */
+
+  template<typename GroupAccessMode,typename F>
+  void for_range_elements_in(
+    const arrays_type& arrays_,GroupAccessMode access_mode,
+    cursor c,cursor res,F& f)const
+  {
+    auto groups_size=arrays_.groups_size_mask+1,
+         first=super::position_for(c.next,arrays_),
+         last=res.done_?
+           groups_size:super::position_for(res.next-1,arrays_)+1;
+    auto pgl=arrays_.groups()+groups_size;
+    for(auto pos0=first;pos0!=last;++pos0){
+      unsigned int ovf=0xFFu;
+      prober       pb(pos0);
+      do{
+        auto pos=pb.get();
+        auto pg=arrays_.groups()+pos;
+        auto p=arrays_.elements()+pos*N;
+        auto lck=access(access_mode,arrays_,pos);
+        auto mask=match_really_occupied(access_mode,pg,pgl);
+        while(mask){
+          auto n=unchecked_countr_zero(mask);
+          auto hash=this->hash_for(this->key_from(p[n]));
+          if(super::position_for(hash,arrays_)==pos0&&hash>=c.next&&
+             (res.done_||hash<res.next)){
+            f(p+n);
+          }
+          mask&=mask-1;
+        }
+        for(std::size_t i=0;i<8;++i){
+          if(pg->is_not_overflowed(i))ovf&=~(1u<<i);
+        }
+      }while(ovf&&pb.next(arrays_.groups_size_mask));
+    }
+  }
+
 #if defined(BOOST_UNORDERED_PARALLEL_ALGORITHMS)
   template<typename GroupAccessMode,typename ExecutionPolicy,typename F>
   auto for_all_elements(
@@ -1792,15 +4215,30 @@ private:
     GroupAccessMode access_mode,ExecutionPolicy&& policy,F f)const
     ->decltype(f(nullptr,0,nullptr),void())
   {
-    if(!this->arrays.elements())return;
-    auto first=this->arrays.groups(),
-         last=first+this->arrays.groups_size_mask+1;
-    std::for_each(std::forward<ExecutionPolicy>(policy),first,last,
+#if defined(BOOST_UNORDERED_ENABLE_COOPERATIVE_REHASH)
+    complete_cooperative_rehash();
+    if(BOOST_UNLIKELY(cooperative_rehash_leftovers())){
+      for_all_elements_in(old_arrays,access_mode,policy,f);
+    }
+#endif
+
+    for_all_elements_in(this->arrays,access_mode,policy,f);
+  }
+
+  template<typename GroupAccessMode,typename ExecutionPolicy,typename F>
+  void for_all_elements_in(
+    const arrays_type& arrays_,GroupAccessMode access_mode,
+    ExecutionPolicy& policy,F& f)const
+  {
+    if(!arrays_.elements())return;
+    auto first=arrays_.groups(),
+         last=first+arrays_.groups_size_mask+1;
+    std::for_each(policy,first,last,
       [&,this](group_type& g){
         auto pos=static_cast<std::size_t>(&g-first);
-        auto p=this->arrays.elements()+pos*N;
-        auto lck=access(access_mode,pos);
-        auto mask=this->match_really_occupied(&g,last);
+        auto p=arrays_.elements()+pos*N;
+        auto lck=access(access_mode,arrays_,pos);
+        auto mask=match_really_occupied(access_mode,&g,last);
         while(mask){
           auto n=unchecked_countr_zero(mask);
           f(&g,n,p+n);
@@ -1814,15 +4252,31 @@ private:
   bool for_all_elements_while(
     GroupAccessMode access_mode,ExecutionPolicy&& policy,F f)const
   {
-    if(!this->arrays.elements())return true;
-    auto first=this->arrays.groups(),
-         last=first+this->arrays.groups_size_mask+1;
-    return std::all_of(std::forward<ExecutionPolicy>(policy),first,last,
+#if defined(BOOST_UNORDERED_ENABLE_COOPERATIVE_REHASH)
+    complete_cooperative_rehash();
+    if(BOOST_UNLIKELY(cooperative_rehash_leftovers())&&
+       !for_all_elements_while_in(old_arrays,access_mode,policy,f)){
+      return false;
+    }
+#endif
+
+    return for_all_elements_while_in(this->arrays,access_mode,policy,f);
+  }
+
+  template<typename GroupAccessMode,typename ExecutionPolicy,typename F>
+  bool for_all_elements_while_in(
+    const arrays_type& arrays_,GroupAccessMode access_mode,
+    ExecutionPolicy& policy,F& f)const
+  {
+    if(!arrays_.elements())return true;
+    auto first=arrays_.groups(),
+         last=first+arrays_.groups_size_mask+1;
+    return std::all_of(policy,first,last,
       [&,this](group_type& g){
         auto pos=static_cast<std::size_t>(&g-first);
-        auto p=this->arrays.elements()+pos*N;
-        auto lck=access(access_mode,pos);
-        auto mask=this->match_really_occupied(&g,last);
+        auto p=arrays_.elements()+pos*N;
+        auto lck=access(access_mode,arrays_,pos);
+        auto mask=match_really_occupied(access_mode,&g,last);
         while(mask){
           auto n=unchecked_countr_zero(mask);
           if(!f(p+n))return false;
@@ -1854,6 +4308,7 @@ private:
   void save(Archive& ar,unsigned int,std::true_type /* set */)const
   {
     auto                                    lck=exclusive_access();
+    finish_cooperative_rehash();
     const std::size_t                       s=super::size();
     const serialization_version<value_type> value_version;
 
@@ -1875,6 +4330,7 @@ private:
       typename TypePolicy::mapped_type>::type;
 
     auto                                         lck=exclusive_access();
+    finish_cooperative_rehash();
     const std::size_t                            s=super::size();
     const serialization_version<raw_key_type>    key_version;
     const serialization_version<raw_mapped_type> mapped_version;
@@ -1912,6 +4368,7 @@ private:
   void load(Archive& ar,unsigned int,std::true_type /* set */)
   {
     auto                              lck=exclusive_access();
+    discard_cooperative_rehash();
     std::size_t                       s;
     serialization_version<value_type> value_version;
 
@@ -1942,6 +4399,7 @@ private:
       typename type_policy::mapped_type>::type;
 
     auto                                   lck=exclusive_access();
+    discard_cooperative_rehash();
     std::size_t                            s;
     serialization_version<raw_key_type>    key_version;
     serialization_version<raw_mapped_type> mapped_version;
@@ -1972,12 +4430,29 @@ private:
     }
   }
 
-  static std::atomic<std::size_t> thread_counter;
-  mutable multimutex_type         mutexes;
-};
+  mutable multimutex_type mutexes;
+  std::atomic<bool>       frozen{false}; /* not transferred, see freeze */
+
+#if defined(BOOST_UNORDERED_ENABLE_STATS)
+  /* not transferred on copy, move or swap: contention is a property of the
+   * threads accessing this very object
+   */
+  mutable concurrent_table_cumulative_stats contention_cstats;
+#endif
 
-template<typename T,typename H,typename P,typename A>
-std::atomic<std::size_t> concurrent_table<T,H,P,A>::thread_counter={};
+#if defined(BOOST_UNORDERED_ENABLE_COOPERATIVE_REHASH)
+  /* Cooperative rehash state: elements of old_arrays are being migrated, groups
+   * [0,claimed_groups) have been claimed by helping threads and
+   * migrated_groups of them are done with.
+   */
+  arrays_type                      old_arrays{{0,0,nullptr,nullptr},nullptr};
+  mutable std::atomic<std::size_t> claimed_groups{0};
+  mutable std::atomic<std::size_t> migrated_groups{0};
+  mutable std::atomic<bool>        migration_failed{false};
+  mutable std::atomic<bool>        release_due{false};
+  std::atomic<bool>                growth_pending{false};
+#endif
+};
 
 #if defined(BOOST_MSVC)
 #pragma warning(pop) /* C4714 */
@@ -60,7 +60,22 @@
 #endif
 #endif
 
-#if defined(BOOST_UNORDERED_SSE2)
+#if !defined(BOOST_UNORDERED_DISABLE_AVX2)&&defined(BOOST_UNORDERED_SSE2)
+#if defined(BOOST_UNORDERED_ENABLE_AVX2)||defined(__AVX2__)
+#define BOOST_UNORDERED_AVX2
+#endif
+#endif
+
+#if defined(BOOST_UNORDERED_ENABLE_RUNTIME_DISPATCH)&& \
+    defined(BOOST_UNORDERED_SSE2)&& \
+    (defined(BOOST_GCC)||defined(BOOST_CLANG))&& \
+    (defined(__x86_64__)||defined(__i386__))
+#define BOOST_UNORDERED_RUNTIME_DISPATCH
+#endif
+
+#if defined(BOOST_UNORDERED_AVX2)||defined(BOOST_UNORDERED_RUNTIME_DISPATCH)
+#include <immintrin.h>
+#elif defined(BOOST_UNORDERED_SSE2)
 #include <emmintrin.h>
 #elif defined(BOOST_UNORDERED_LITTLE_ENDIAN_NEON)
 #include <arm_neon.h>
@@ -167,6 +182,8 @@ static constexpr std::size_t default_bucket_count=0;
  *     values and overflow information. Reduced hash values are used to
  *     accelerate lookup within the group by using 128-bit SIMD or 64-bit word
  *     operations.
+ *   - Optionally, on AVX2 platforms, groups of size N=31 with 32B metadata
+ *     words can be used instead (see group32).
  */
 
 /* group15 controls metadata information of a group of N=15 element slots.
@@ -284,6 +301,11 @@ struct group15
     overflow()|=static_cast<unsigned char>(1<<(hash%8));
   }
 
+  inline void reset_overflow()
+  {
+    overflow()=0;
+  }
+
   static inline bool maybe_caused_overflow(unsigned char* pc)
   {
     std::size_t pos=reinterpret_cast<uintptr_t>(pc)%sizeof(group15);
@@ -313,6 +335,12 @@ struct group15
     return (~match_available())&0x7FFF;
   }
 
+  inline int match_sentinel()const
+  {
+    return _mm_movemask_epi8(
+      _mm_cmpeq_epi8(load_metadata(),_mm_set1_epi8(sentinel_)))&0x7FFF;
+  }
+
 private:
   using slot_type=IntegralWrapper<unsigned char>;
   BOOST_UNORDERED_STATIC_ASSERT(sizeof(slot_type)==1);
@@ -389,11 +417,15 @@ private:
     return (int)word[narrow_cast<unsigned char>(hash)];
   }
 
+public:
+  /* metadata value of slots holding elements with the given hash */
+
   inline static unsigned char reduced_hash(std::size_t hash)
   {
     return narrow_cast<unsigned char>(match_word(hash));
   }
 
+private:
   inline slot_type& at(std::size_t pos)
   {
     return m[pos];
@@ -486,6 +518,11 @@ struct group15
     overflow()|=static_cast<unsigned char>(1<<(hash%8));
   }
 
+  inline void reset_overflow()
+  {
+    overflow()=0;
+  }
+
   static inline bool maybe_caused_overflow(unsigned char* pc)
   {
     std::size_t pos=reinterpret_cast<uintptr_t>(pc)%sizeof(group15);
@@ -516,6 +553,12 @@ struct group15
       load_metadata(),vdupq_n_u8(0)))&0x7FFF;
   }
 
+  inline int match_sentinel()const
+  {
+    return simde_mm_movemask_epi8(vceqq_u8(
+      load_metadata(),vdupq_n_u8(sentinel_)))&0x7FFF;
+  }
+
 private:
   using slot_type=IntegralWrapper<unsigned char>;
   BOOST_UNORDERED_STATIC_ASSERT(sizeof(slot_type)==1);
@@ -539,6 +582,9 @@ private:
 #endif
   }
 
+public:
+  /* metadata value of slots holding elements with the given hash */
+
   inline static unsigned char reduced_hash(std::size_t hash)
   {
     static constexpr unsigned char table[]={
@@ -563,6 +609,7 @@ private:
     return table[(unsigned char)hash];
   }
 
+private:
   /* Copied from 
    * https://github.com/simd-everywhere/simde/blob/master/simde/x86/
    * sse2.h#L3763
@@ -677,6 +724,12 @@ struct group15
     reinterpret_cast<boost::uint16_t*>(m)[hash%8]|=0x8000u;
   }
 
+  inline void reset_overflow()
+  {
+    m[0]&=~boost::uint64_t(0x8000800080008000ull);
+    m[1]&=~boost::uint64_t(0x8000800080008000ull);
+  }
+
   static inline bool maybe_caused_overflow(unsigned char* pc)
   {
     std::size_t     pos=reinterpret_cast<uintptr_t>(pc)%sizeof(group15);
@@ -716,6 +769,9 @@ private:
   static constexpr unsigned char available_=0,
                                  sentinel_=1;
 
+public:
+  /* metadata value of slots holding elements with the given hash */
+
   inline static unsigned char reduced_hash(std::size_t hash)
   {
     static constexpr unsigned char table[]={
@@ -740,6 +796,7 @@ private:
     return table[narrow_cast<unsigned char>(hash)];
   }
 
+private:
   inline void set_impl(std::size_t pos,std::size_t n)
   {
     BOOST_ASSERT(n<256);
@@ -798,6 +855,233 @@ private:
 
 #endif
 
+/* group32 is an AVX2-only alternative to group15 holding N=31 element slots
+ * with a 32B metadata word:
+ *
+ *   +---+---+---+---+-   -+---+---+---+
+ *   |ofw|h30|h29|h28| ... |h02|h01|h00|
+ *   +---+---+---+---+-   -+---+---+---+
+ *
+ * Reduced hash values and the overflow byte have the same semantics as in
+ * group15 (in particular, reduction is invariant under modulo 8 so that
+ * maybe_caused_overflow works), and matching is done with one 256-bit
+ * compare. Doubling the number of slots per group halves the number of groups
+ * for a given capacity, so probe sequences are shorter at high loads and
+ * unsuccessful lookups touch fewer groups, at the expense of more reduced-hash
+ * false positives per group probed (31/254 rather than 15/254 on average).
+ *
+ * group32 is used by foa::table and foa::concurrent_table instead of group15
+ * only if BOOST_UNORDERED_ENABLE_GROUP32 is defined and AVX2 is available
+ * (see default_group).
+ */
+
+#if defined(BOOST_UNORDERED_AVX2)
+
+template<template<typename> class IntegralWrapper>
+struct group32
+{
+  static constexpr std::size_t N=31;
+  static constexpr bool        regular_layout=true;
+
+  struct dummy_group_type
+  {
+    alignas(32) unsigned char storage[N+1]=
+    {
+      0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+      0,0,0,0,0,0,0,0,0,0,0,0,0,0,1,0
+    };
+  };
+
+  inline void initialize()
+  {
+    _mm256_store_si256(
+      reinterpret_cast<__m256i*>(m),_mm256_setzero_si256());
+  }
+
+  inline void set(std::size_t pos,std::size_t hash)
+  {
+    BOOST_ASSERT(pos<N);
+    at(pos)=reduced_hash(hash);
+  }
+
+  inline void set_sentinel()
+  {
+    at(N-1)=sentinel_;
+  }
+
+  inline bool is_sentinel(std::size_t pos)const
+  {
+    BOOST_ASSERT(pos<N);
+    return at(pos)==sentinel_;
+  }
+
+  static inline bool is_sentinel(unsigned char* pc)noexcept
+  {
+    return *pc==sentinel_;
+  }
+
+  inline void reset(std::size_t pos)
+  {
+    BOOST_ASSERT(pos<N);
+    at(pos)=available_;
+  }
+
+  static inline void reset(unsigned char* pc)
+  {
+    *reinterpret_cast<slot_type*>(pc)=available_;
+  }
+
+  inline int match(std::size_t hash)const
+  {
+    return _mm256_movemask_epi8(
+      _mm256_cmpeq_epi8(
+        load_metadata(),
+        _mm256_set1_epi8(static_cast<char>(reduced_hash(hash)))))&0x7FFFFFFF;
+  }
+
+  inline bool is_not_overflowed(std::size_t hash)const
+  {
+    static constexpr unsigned char shift[]={1,2,4,8,16,32,64,128};
+
+    return !(overflow()&shift[hash%8]);
+  }
+
+  inline void mark_overflow(std::size_t hash)
+  {
+    overflow()|=static_cast<unsigned char>(1<<(hash%8));
+  }
+
+  inline void reset_overflow()
+  {
+    overflow()=0;
+  }
+
+  static inline bool maybe_caused_overflow(unsigned char* pc)
+  {
+    std::size_t pos=reinterpret_cast<uintptr_t>(pc)%sizeof(group32);
+    group32    *pg=reinterpret_cast<group32*>(pc-pos);
+    return !pg->is_not_overflowed(*pc);
+  }
+
+  inline int match_available()const
+  {
+    return _mm256_movemask_epi8(
+      _mm256_cmpeq_epi8(load_metadata(),_mm256_setzero_si256()))&0x7FFFFFFF;
+  }
+
+  inline bool is_occupied(std::size_t pos)const
+  {
+    BOOST_ASSERT(pos<N);
+    return at(pos)!=available_;
+  }
+
+  static inline bool is_occupied(unsigned char* pc)noexcept
+  {
+    return *reinterpret_cast<slot_type*>(pc)!=available_;
+  }
+
+  inline int match_occupied()const
+  {
+    return (~match_available())&0x7FFFFFFF;
+  }
+
+  inline int match_sentinel()const
+  {
+    return _mm256_movemask_epi8(
+      _mm256_cmpeq_epi8(load_metadata(),_mm256_set1_epi8(sentinel_)))&
+      0x7FFFFFFF;
+  }
+
+private:
+  using slot_type=IntegralWrapper<unsigned char>;
+  BOOST_UNORDERED_STATIC_ASSERT(sizeof(slot_type)==1);
+
+  static constexpr unsigned char available_=0,
+                                 sentinel_=1;
+
+  inline __m256i load_metadata()const
+  {
+#if defined(BOOST_UNORDERED_THREAD_SANITIZER)
+    /* ThreadSanitizer complains on 1-byte atomic writes combined with
+     * 32-byte atomic reads.
+     */
+
+    alignas(32) unsigned char buf[N+1];
+    for(std::size_t i=0;i<N+1;++i)buf[i]=m[i];
+    return _mm256_load_si256(reinterpret_cast<const __m256i*>(buf));
+#else
+    return _mm256_load_si256(reinterpret_cast<const __m256i*>(m));
+#endif
+  }
+
+public:
+  /* metadata value of slots holding elements with the given hash */
+
+  inline static unsigned char reduced_hash(std::size_t hash)
+  {
+    /* same as group15: 0 and 1 are mapped to 8 and 9 */
+
+    static constexpr unsigned char table[]={
+      8,9,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+      16,17,18,19,20,21,22,23,24,25,26,27,28,29,30,31,
+      32,33,34,35,36,37,38,39,40,41,42,43,44,45,46,47,
+      48,49,50,51,52,53,54,55,56,57,58,59,60,61,62,63,
+      64,65,66,67,68,69,70,71,72,73,74,75,76,77,78,79,
+      80,81,82,83,84,85,86,87,88,89,90,91,92,93,94,95,
+      96,97,98,99,100,101,102,103,104,105,106,107,108,109,110,111,
+      112,113,114,115,116,117,118,119,120,121,122,123,124,125,126,127,
+      128,129,130,131,132,133,134,135,136,137,138,139,140,141,142,143,
+      144,145,146,147,148,149,150,151,152,153,154,155,156,157,158,159,
+      160,161,162,163,164,165,166,167,168,169,170,171,172,173,174,175,
+      176,177,178,179,180,181,182,183,184,185,186,187,188,189,190,191,
+      192,193,194,195,196,197,198,199,200,201,202,203,204,205,206,207,
+      208,209,210,211,212,213,214,215,216,217,218,219,220,221,222,223,
+      224,225,226,227,228,229,230,231,232,233,234,235,236,237,238,239,
+      240,241,242,243,244,245,246,247,248,249,250,251,252,253,254,255,
+    };
+
+    return table[narrow_cast<unsigned char>(hash)];
+  }
+
+private:
+  inline slot_type& at(std::size_t pos)
+  {
+    return m[pos];
+  }
+
+  inline const slot_type& at(std::size_t pos)const
+  {
+    return m[pos];
+  }
+
+  inline slot_type& overflow()
+  {
+    return at(N);
+  }
+
+  inline const slot_type& overflow()const
+  {
+    return at(N);
+  }
+
+  alignas(32) slot_type m[32];
+};
+
+#endif
+
+/* Group type used by foa::table and foa::concurrent_table. All translation
+ * units in a program must agree on BOOST_UNORDERED_ENABLE_GROUP32, as it
+ * changes the memory layout of the containers.
+ */
+
+#if defined(BOOST_UNORDERED_ENABLE_GROUP32)&&defined(BOOST_UNORDERED_AVX2)
+template<template<typename> class IntegralWrapper>
+using default_group=group32<IntegralWrapper>;
+#else
+template<template<typename> class IntegralWrapper>
+using default_group=group15<IntegralWrapper>;
+#endif
+
 /* foa::table_core uses a size policy to obtain the permissible sizes of the
  * group array (and, by implication, the element array) and to do the
  * hash->group mapping.
@@ -887,6 +1171,64 @@ private:
   std::size_t pos,step=0;
 };
 
+/* Variation of pow2_quadratic_prober for group32: groups are considered in
+ * pairs {2i,2i+1} sharing a 64B cache line (see group_traits), and each pair
+ * is fully probed before jumping to the next one along a triangular sequence
+ * over pair indices. As the number of pairs is also a power of two, the whole
+ * array is eventually traversed.
+ */
+
+struct pow2_paired_quadratic_prober
+{
+  pow2_paired_quadratic_prober(std::size_t pos_):pos{pos_}{}
+
+  inline std::size_t get()const{return pos;}
+  inline std::size_t length()const{return step+1;}
+
+  inline bool next(std::size_t mask)
+  {
+    step+=1;
+    if(step%2){ /* buddy group within the same pair */
+      pos^=1;
+    }
+    else{
+      /* pos is the buddy of the pair's initial group, so the parity of the
+       * latter is recovered as (pos%2)^1.
+       */
+
+      pos=((pos&~std::size_t(1))+step+((pos%2)^1))&mask;
+    }
+    return step<=mask;
+  }
+
+private:
+  std::size_t pos,step=0;
+};
+
+/* Group-dependent tuning for table_arrays and table_core:
+ *
+ *   - prober: probing policy.
+ *   - array_alignment: alignment of the group array, which must be a multiple
+ *     of sizeof(Group) (see table_iterator).
+ */
+
+template<typename Group>
+struct group_traits
+{
+  using prober=pow2_quadratic_prober;
+  static constexpr std::size_t array_alignment=sizeof(Group);
+};
+
+#if defined(BOOST_UNORDERED_AVX2)
+template<template<typename> class IntegralWrapper>
+struct group_traits<group32<IntegralWrapper>>
+{
+  using prober=pow2_paired_quadratic_prober;
+  static constexpr std::size_t array_alignment=
+    2*sizeof(group32<IntegralWrapper>);
+};
+#endif
+
 /* Mixing policies: no_mix is the identity function, and mulx_mix
  * uses the mulx function from <boost/unordered/detail/mulx.hpp>.
  *
@@ -929,6 +1271,58 @@ inline unsigned int unchecked_countr_zero(int x)
 #endif
 }
 
+/* Runtime CPU dispatch (opt-in via BOOST_UNORDERED_ENABLE_RUNTIME_DISPATCH).
+ * Binaries built for baseline x86-64 are stuck with SSE2 group15 matching.
+ * Per-group kernels (match, match_available, match_occupied) operate on a
+ * single 16B metadata word and are already one SSE2 compare, so there's
+ * nothing to gain from wider instructions there, whereas dispatching them
+ * through a function pointer would preclude inlining in the lookup hot path.
+ * Where AVX2 does pay off is when skipping runs of empty groups during
+ * full-table traversal, as two metadata words can be checked with one
+ * 256-bit compare: this skip is resolved at start-up via CPUID.
+ * cpu_features::avx2 is zero-initialized before dynamic initialization, so
+ * any call made before that takes the baseline path.
+ */
+
+#if defined(BOOST_UNORDERED_RUNTIME_DISPATCH)
+template<typename=void>
+struct cpu_features
+{
+  static bool avx2;
+
+private:
+  static bool detect_avx2()
+  {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+  }
+};
+
+template<typename T>
+bool cpu_features<T>::avx2=cpu_features<T>::detect_avx2();
+
+/* Skips 16B metadata words in [p,last) two at a time until finding one with
+ * some byte other than the overflow byte set (i.e. the group has some
+ * occupied slot or the sentinel), which is returned. If fewer than two words
+ * are left, returns the position reached.
+ */
+
+__attribute__((target("avx2")))
+inline const unsigned char* skip_empty_groups16_avx2(
+  const unsigned char* p,const unsigned char* last)
+{
+  const __m256i zero=_mm256_setzero_si256();
+  for(;last-p>=32;p+=32){
+    unsigned int mask=~static_cast<unsigned int>(_mm256_movemask_epi8(
+      _mm256_cmpeq_epi8(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)),zero)))&
+      0x7FFF7FFFu;
+    if(mask)return (mask&0x7FFFu)?p:p+16;
+  }
+  return p;
+}
+#endif
+
 /* table_arrays controls allocation, initialization and deallocation of
  * paired arrays of groups and element slots. Only one chunk of memory is
  * allocated to place both arrays: this is not done for efficiency reasons,
@@ -1002,6 +1396,24 @@ private:
   bool      released_=false;
 };
 
+/* Allocators may tell that allocate(n) returns zeroed memory (for instance,
+ * pages freshly mapped from the OS) through an allocates_zeroed(n) member
+ * function, in which case initialization of the group array can be skipped.
+ */
+
+template<typename Allocator>
+auto allocates_zeroed(const Allocator& al,std::size_t n,int)
+  ->decltype(static_cast<bool>(al.allocates_zeroed(n)))
+{
+  return static_cast<bool>(al.allocates_zeroed(n));
+}
+
+template<typename Allocator>
+bool allocates_zeroed(const Allocator&,std::size_t,...)
+{
+  return false;
+}
+
 template<typename Value,typename Group,typename SizePolicy,typename Allocator>
 struct table_arrays
 {
@@ -1010,6 +1422,8 @@ struct table_arrays
   using value_type=Value;
   using group_type=Group;
   static constexpr auto N=group_type::N;
+  static constexpr std::size_t group_alignment=
+    group_traits<group_type>::array_alignment;
   using size_policy=SizePolicy;
   using value_type_pointer=
     typename boost::allocator_pointer<allocator_type>::type;
@@ -1046,21 +1460,25 @@ struct table_arrays
     auto groups_size=size_policy::size(groups_size_index);
 
     auto sal=allocator_type(al);
+    auto zeroed=allocates_zeroed(sal,buffer_size(groups_size),0);
     arrays.elements_=storage_traits::allocate(sal,buffer_size(groups_size));
-    
-    /* Align arrays.groups to sizeof(group_type). table_iterator critically
-      * depends on such alignment for its increment operation.
+
+    /* Align arrays.groups to group_alignment (a multiple of
+      * sizeof(group_type)). table_iterator critically depends on such
+      * alignment for its increment operation.
       */
 
     auto p=reinterpret_cast<unsigned char*>(arrays.elements()+groups_size*N-1);
-    p+=(uintptr_t(sizeof(group_type))-
-        reinterpret_cast<uintptr_t>(p))%sizeof(group_type);
+    p+=(uintptr_t(group_alignment)-
+        reinterpret_cast<uintptr_t>(p))%group_alignment;
     arrays.groups_=
       group_type_pointer_traits::pointer_to(*reinterpret_cast<group_type*>(p));
 
-    initialize_groups(
-      arrays.groups(),groups_size,
-      is_trivially_default_constructible<group_type>{});
+    if(!zeroed||!is_trivially_default_constructible<group_type>::value){
+      initialize_groups(
+        arrays.groups(),groups_size,
+        is_trivially_default_constructible<group_type>{});
+    }
     arrays.groups()[groups_size-1].set_sentinel();
   }
 
@@ -1105,7 +1523,7 @@ struct table_arrays
       /* space for elements (we subtract 1 because of the sentinel) */
       sizeof(value_type)*(groups_size*N-1)+
       /* space for groups + padding for group alignment */
-      sizeof(group_type)*(groups_size+1)-1;
+      sizeof(group_type)*groups_size+group_alignment-1;
 
     /* ceil(buffer_bytes/sizeof(value_type)) */
     return (buffer_bytes+sizeof(value_type)-1)/sizeof(value_type);
@@ -1144,6 +1562,9 @@ struct table_core_cumulative_stats
   concurrent_cumulative_stats<1> insertion;
   concurrent_cumulative_stats<2> successful_lookup,
                                  unsuccessful_lookup;
+  concurrent_cumulative_stats<0> rehash,
+                                 in_place_rehash,
+                                 shrink;
 };
 
 struct table_core_insertion_stats
@@ -1159,11 +1580,19 @@ struct table_core_lookup_stats
   sequence_stats_summary num_comparisons;
 };
 
+struct table_core_rehash_stats
+{
+  std::size_t count;
+  std::size_t in_place_count;
+  std::size_t shrink_count;
+};
+
 struct table_core_stats
 {
   table_core_insertion_stats insertion;
   table_core_lookup_stats    successful_lookup,
                              unsuccessful_lookup;
+  table_core_rehash_stats    rehash;
 };
 
 #define BOOST_UNORDERED_ADD_STATS(stats,args) stats.add args
@@ -1255,7 +1684,19 @@ _STL_RESTORE_DEPRECATED_WARNING
  * needing to pull it from an instantiated class template such as the table
  * class.
  */
-static constexpr float mlf=0.875f;
+static constexpr float mlf=0.875f;
+
+#if defined(BOOST_UNORDERED_ENABLE_AUTO_SHRINK)
+#if !defined(BOOST_UNORDERED_AUTO_SHRINK_LOAD_FACTOR)
+#define BOOST_UNORDERED_AUTO_SHRINK_LOAD_FACTOR 0.25f
+#endif
+
+/* Tables shrink when their size falls below this fraction of the maximum
+ * load. Must be < 0.5 so that a halved table is not full right away.
+ */
+static constexpr float auto_shrink_lf=BOOST_UNORDERED_AUTO_SHRINK_LOAD_FACTOR;
+BOOST_UNORDERED_STATIC_ASSERT(auto_shrink_lf>0.0f&&auto_shrink_lf<0.5f);
+#endif
 
 template<typename Group,typename Element>
 struct table_locator
@@ -1407,6 +1848,9 @@ using is_emplace_kv_able = std::integral_constant<bool,
 #pragma warning(disable:4702)
 #endif
 
+template<typename,typename,typename,typename>
+class concurrent_table; /* accesses growth internals for cooperative rehash */
+
 template<
   typename TypePolicy,typename Group,template<typename...> class Arrays,
   typename SizeControl,typename Hash,typename Pred,typename Allocator
@@ -1424,7 +1868,7 @@ public:
   using group_type=Group;
   static constexpr auto N=group_type::N;
   using size_policy=pow2_size_policy;
-  using prober=pow2_quadratic_prober;
+  using prober=typename group_traits<group_type>::prober;
   using mix_policy=typename std::conditional<
     hash_is_avalanching<Hash>::value,
     no_mix,
@@ -1453,6 +1897,29 @@ public:
   using difference_type=std::ptrdiff_t;
   using locator=table_locator<group_type,element_type>;
   using arrays_holder_type=arrays_holder<arrays_type,Allocator>;
+  using plain_arrays_type=
+    table_arrays<element_type,group_type,size_policy,Allocator>;
+  static constexpr std::size_t bulk_visit_size=16;
+
+#if defined(BOOST_UNORDERED_ENABLE_INCREMENTAL_REHASH)
+  /* Incremental rehash (see unchecked_emplace_with_rehash) is only enabled
+   * for non-concurrent tables: concurrent_table arrays are never left in an
+   * intermediate state.
+   */
+  static constexpr bool incremental_rehash=
+    std::is_same<arrays_type,plain_arrays_type>::value;
+
+  /* groups of the old arrays migrated on each insertion */
+  static constexpr std::size_t incremental_rehash_groups=4;
+#endif
+
+#if defined(BOOST_UNORDERED_ENABLE_AUTO_SHRINK)
+  /* Automatic shrinking (see recover_slot) is not available for concurrent
+   * tables, as erasure can't lower ml safely without exclusive access.
+   */
+  static constexpr bool auto_shrink=
+    std::is_same<arrays_type,plain_arrays_type>::value;
+#endif
 
 #if defined(BOOST_UNORDERED_ENABLE_STATS)
   using cumulative_stats=table_core_cumulative_stats;
@@ -1503,6 +1970,9 @@ public:
     x.size_ctrl.ml=x.initial_max_load();
     x.size_ctrl.size=0;
     BOOST_UNORDERED_SWAP_STATS(cstats,x.cstats);
+#if defined(BOOST_UNORDERED_ENABLE_INCREMENTAL_REHASH)
+    swap_incremental_rehash_state(x);
+#endif
   }
 
   table_core(table_core&& x)
@@ -1529,6 +1999,9 @@ public:
       swap(arrays,x.arrays);
       swap(size_ctrl,x.size_ctrl);
       BOOST_UNORDERED_SWAP_STATS(cstats,x.cstats);
+#if defined(BOOST_UNORDERED_ENABLE_INCREMENTAL_REHASH)
+      swap_incremental_rehash_state(x);
+#endif
     }
     else{
       reserve(x.size());
@@ -1551,6 +2024,9 @@ public:
       destroy_element(p);
     });
     delete_arrays(arrays);
+#if defined(BOOST_UNORDERED_ENABLE_INCREMENTAL_REHASH)
+    release_old_arrays();
+#endif
   }
 
   std::size_t initial_max_load()const
@@ -1655,6 +2131,9 @@ public:
         x.size_ctrl.ml=x.initial_max_load();
         x.size_ctrl.size=0;
         BOOST_UNORDERED_RESET_STATS_OF(x);
+#if defined(BOOST_UNORDERED_ENABLE_INCREMENTAL_REHASH)
+        swap_incremental_rehash_state(x);
+#endif
       }
       else{
         swap(h(),x.h());
@@ -1717,15 +2196,31 @@ public:
   template<typename Key>
   BOOST_FORCEINLINE locator find(
     const Key& x,std::size_t pos0,std::size_t hash)const
+  {
+#if defined(BOOST_UNORDERED_ENABLE_INCREMENTAL_REHASH)
+    auto loc=find(arrays,x,pos0,hash);
+    if(BOOST_UNLIKELY(!loc&&rehash_in_progress())){
+      loc=find(old_arrays,x,position_for(hash,old_arrays),hash);
+    }
+    return loc;
+#else
+    return find(arrays,x,pos0,hash);
+#endif
+  }
+
+  template<typename Key>
+  BOOST_FORCEINLINE locator find(
+    const plain_arrays_type& arrays_,
+    const Key& x,std::size_t pos0,std::size_t hash)const
   {    
     BOOST_UNORDERED_STATS_COUNTER(num_cmps);
     prober pb(pos0);
     do{
       auto pos=pb.get();
-      auto pg=arrays.groups()+pos;
+      auto pg=arrays_.groups()+pos;
       auto mask=pg->match(hash);
       if(mask){
-        auto elements=arrays.elements();
+        auto elements=arrays_.elements();
         BOOST_UNORDERED_ASSUME(elements!=nullptr);
         auto p=elements+pos*N;
         BOOST_UNORDERED_PREFETCH_ELEMENTS(p,N);
@@ -1746,12 +2241,40 @@ public:
         return {};
       }
     }
-    while(BOOST_LIKELY(pb.next(arrays.groups_size_mask)));
+    while(BOOST_LIKELY(pb.next(arrays_.groups_size_mask)));
     BOOST_UNORDERED_ADD_STATS(
       cstats.unsuccessful_lookup,(pb.length(),num_cmps));
     return {};
   }
 
+  /* Pipelined lookup of [first,last): keys are processed in chunks of
+   * bulk_visit_size so that the memory fetches for different keys overlap.
+   * f(it,loc) is invoked for each it in [first,last) in sequence order, with
+   * an empty loc if *it is not found.
+   */
+
+  template<typename FwdIterator,typename F>
+  BOOST_FORCEINLINE void bulk_find(FwdIterator first,FwdIterator last,F&& f)const
+  {
+#if defined(BOOST_UNORDERED_ENABLE_INCREMENTAL_REHASH)
+    if(BOOST_UNLIKELY(rehash_in_progress())){
+      for(;first!=last;++first)f(first,find(*first));
+      return;
+    }
+#endif
+
+    auto n=static_cast<std::size_t>(std::distance(first,last));
+    while(n){
+      auto m=n<2*bulk_visit_size?n:bulk_visit_size;
+      unchecked_bulk_find(first,m,f);
+      n-=m;
+      std::advance(
+        first,
+        static_cast<
+          typename std::iterator_traits<FwdIterator>::difference_type>(m));
+    }
+  }
+
 #if defined(BOOST_MSVC)
 #pragma warning(pop) /* C4800 */
 #endif
@@ -1779,10 +2302,22 @@ public:
     swap(pred(),x.pred());
     swap(arrays,x.arrays);
     swap(size_ctrl,x.size_ctrl);
+#if defined(BOOST_UNORDERED_ENABLE_INCREMENTAL_REHASH)
+    swap_incremental_rehash_state(x);
+#endif
   }
 
   void clear()noexcept
   {
+#if defined(BOOST_UNORDERED_ENABLE_INCREMENTAL_REHASH)
+    if(rehash_in_progress()){
+      for_all_elements(old_arrays,[this](element_type* p){
+        destroy_element(p);
+      });
+      release_old_arrays();
+    }
+#endif
+
     auto p=arrays.elements();
     if(p){
       for(auto pg=arrays.groups(),last=pg+arrays.groups_size_mask+1;
@@ -1804,6 +2339,12 @@ public:
   hasher hash_function()const{return h();}
   key_equal key_eq()const{return pred();}
 
+  template<typename Key>
+  precomputed_hash hash_function_mixed(const Key& x)const
+  {
+    return precomputed_hash{hash_for(x)};
+  }
+
   std::size_t capacity()const noexcept
   {
     return arrays.elements()?(arrays.groups_size_mask+1)*N-1:0;
@@ -1821,6 +2362,8 @@ public:
 
   void rehash(std::size_t n)
   {
+    finish_incremental_rehash();
+
     auto m=size_t(std::ceil(float(size())/mlf));
     if(m>n)n=m;
     if(n)n=capacity_for(n); /* exact resulting capacity */
@@ -1839,6 +2382,9 @@ public:
     auto insertion=cstats.insertion.get_summary();
     auto successful_lookup=cstats.successful_lookup.get_summary();
     auto unsuccessful_lookup=cstats.unsuccessful_lookup.get_summary();
+    auto rehash=cstats.rehash.get_summary();
+    auto in_place_rehash=cstats.in_place_rehash.get_summary();
+    auto shrink=cstats.shrink.get_summary();
     return{
       {
         insertion.count,
@@ -1854,6 +2400,11 @@ public:
         unsuccessful_lookup.sequence_summary[0],
         unsuccessful_lookup.sequence_summary[1]
       },
+      {
+        rehash.count,
+        in_place_rehash.count,
+        shrink.count
+      },
     };
   }
 
@@ -1862,6 +2413,9 @@ public:
     cstats.insertion.reset();
     cstats.successful_lookup.reset();
     cstats.unsuccessful_lookup.reset();
+    cstats.rehash.reset();
+    cstats.in_place_rehash.reset();
+    cstats.shrink.reset();
   }
 #endif
 
@@ -1942,13 +2496,22 @@ public:
     return mix_policy::mix(h(),x);
   }
 
+  template<typename Key>
+  inline std::size_t hash_for(const Key& x,precomputed_hash hash)const
+  {
+    BOOST_ASSERT_MSG(
+      hash.value()==hash_for(x),"precomputed hash does not match the key");
+    (void)x;
+    return hash.value();
+  }
+
   inline std::size_t position_for(std::size_t hash)const
   {
     return position_for(hash,arrays);
   }
 
   static inline std::size_t position_for(
-    std::size_t hash,const arrays_type& arrays_)
+    std::size_t hash,const plain_arrays_type& arrays_)
   {
     return size_policy::position(hash,arrays_.groups_size_index);
   }
@@ -1959,6 +2522,37 @@ public:
     return pg->match_occupied()&~(int(pg==last-1)<<(N-1));
   }
 
+#if defined(BOOST_UNORDERED_RUNTIME_DISPATCH)
+  /* Returns some group between pg and the first group in [pg,last) with an
+   * occupied slot or the sentinel, both inclusive (or last). Empty groups
+   * before the returned one can be safely skipped during traversal.
+   */
+
+  static inline group_type* skip_empty_groups(group_type* pg,group_type* last)
+  {
+    return skip_empty_groups(
+      pg,last,
+      std::integral_constant<
+        bool,sizeof(group_type)==16&&group_type::regular_layout>{});
+  }
+
+  static inline group_type* skip_empty_groups(
+    group_type* pg,group_type* last,std::true_type /* 16B regular layout */)
+  {
+    if(!cpu_features<>::avx2)return pg;
+    return reinterpret_cast<group_type*>(
+      const_cast<unsigned char*>(skip_empty_groups16_avx2(
+        reinterpret_cast<const unsigned char*>(pg),
+        reinterpret_cast<const unsigned char*>(last))));
+  }
+
+  static inline group_type* skip_empty_groups(
+    group_type* pg,group_type*,std::false_type)
+  {
+    return pg;
+  }
+#endif
+
   template<typename... Args>
   locator unchecked_emplace_at(
     std::size_t pos0,std::size_t hash,Args&&... args)
@@ -1966,19 +2560,84 @@ public:
     auto res=nosize_unchecked_emplace_at(
       arrays,pos0,hash,std::forward<Args>(args)...);
     ++size_ctrl.size;
+#if defined(BOOST_UNORDERED_ENABLE_INCREMENTAL_REHASH)
+    if(BOOST_UNLIKELY(rehash_in_progress()))incremental_rehash_step(res);
+#endif
     return res;
   }
 
   BOOST_NOINLINE void unchecked_rehash_for_growth()
   {
+    if(growth_fits_in_place()){
+      locator it;
+      unchecked_rehash_in_place(it);
+      return;
+    }
     auto new_arrays_=new_arrays_for_growth();
     unchecked_rehash(new_arrays_);
   }
 
+  /* As unchecked_rehash_in_place without compaction: bounded tables undo
+   * anti-drift this way without moving any element (see cache_table and
+   * concurrent_cache_table).
+   */
+
+  BOOST_NOINLINE void unchecked_recalculate_overflow()
+  {
+    BOOST_ASSERT(!rehash_in_progress());
+
+    auto groups_size=arrays.groups_size_mask+1;
+    auto last=arrays.groups()+groups_size;
+    for(auto pg=arrays.groups();pg!=last;++pg)pg->reset_overflow();
+    BOOST_TRY{
+      for(std::size_t pos=0;pos!=groups_size;++pos){
+        auto pg=arrays.groups()+pos;
+        auto p=arrays.elements()+pos*N;
+        auto mask=match_really_occupied(pg,last);
+        while(mask){
+          auto n=unchecked_countr_zero(mask);
+          auto hash=hash_for(key_from(p[n]));
+          for(prober pb(position_for(hash));pb.get()!=pos;
+              pb.next(arrays.groups_size_mask)){
+            arrays.groups()[pb.get()].mark_overflow(hash);
+          }
+          mask&=mask-1;
+        }
+      }
+    }
+    BOOST_CATCH(...){
+      for(auto pg=arrays.groups();pg!=last;++pg){
+        for(std::size_t i=0;i<8;++i)pg->mark_overflow(i);
+      }
+      BOOST_RETHROW
+    }
+    BOOST_CATCH_END
+    size_ctrl.ml=initial_max_load();
+  }
+
   template<typename... Args>
   BOOST_NOINLINE locator
   unchecked_emplace_with_rehash(std::size_t hash,Args&&... args)
   {
+    if(growth_fits_in_place()){
+      finish_incremental_rehash();
+
+      /* there's room in the current arrays as ml<capacity() */
+      auto it=nosize_unchecked_emplace_at(
+        arrays,position_for(hash),hash,std::forward<Args>(args)...);
+      BOOST_TRY{
+        unchecked_rehash_in_place(it);
+      }
+      BOOST_CATCH(...){
+        destroy_element(it.p);
+        it.pg->reset(it.n);
+        BOOST_RETHROW
+      }
+      BOOST_CATCH_END
+      ++size_ctrl.size;
+      return it;
+    }
+
     auto    new_arrays_=new_arrays_for_growth();
     locator it;
     BOOST_TRY{
@@ -1993,6 +2652,43 @@ public:
     }
     BOOST_CATCH_END
 
+#if defined(BOOST_UNORDERED_ENABLE_AUTO_SHRINK)
+    add_shrink_stats(new_arrays_);
+#endif
+
+#if defined(BOOST_UNORDERED_ENABLE_INCREMENTAL_REHASH)
+    if(incremental_rehash){
+      /* Growth while a previous migration is still pending (unlikely, as
+       * the new arrays have room for many more insertions than needed to
+       * complete it): finish it off first.
+       */
+      BOOST_TRY{
+        finish_incremental_rehash();
+      }
+      BOOST_CATCH(...){
+        destroy_element(it.p);
+        delete_arrays(new_arrays_);
+        BOOST_RETHROW
+      }
+      BOOST_CATCH_END
+
+      /* Rather than moving all elements at once, keep the current arrays
+       * alive and migrate them group by group on subsequent insertions.
+       * Not worth it when the old arrays would be done with in one step.
+       */
+      if(size()&&arrays.groups_size_mask+1>incremental_rehash_groups){
+        old_arrays=arrays;
+        old_pos=0;
+        old_size=size();
+        arrays=new_arrays_;
+        size_ctrl.ml=initial_max_load();
+        ++size_ctrl.size;
+        BOOST_UNORDERED_ADD_STATS(cstats.rehash,());
+        return it;
+      }
+    }
+#endif
+
     /* new_arrays_ lifetime taken care of by unchecked_rehash */
     unchecked_rehash(new_arrays_);
     ++size_ctrl.size;
@@ -2017,21 +2713,50 @@ public:
     }
   }
 
+  bool rehash_in_progress()const noexcept
+  {
+#if defined(BOOST_UNORDERED_ENABLE_INCREMENTAL_REHASH)
+    return incremental_rehash&&old_arrays.elements()!=nullptr;
+#else
+    return false;
+#endif
+  }
+
+  void finish_incremental_rehash()
+  {
+#if defined(BOOST_UNORDERED_ENABLE_INCREMENTAL_REHASH)
+    if(rehash_in_progress())migrate_old_groups(old_arrays.groups_size_mask+1);
+#endif
+  }
+
+#if defined(BOOST_UNORDERED_ENABLE_INCREMENTAL_REHASH)
+  bool in_old_arrays(const void* p)const noexcept
+  {
+    return
+      reinterpret_cast<uintptr_t>(p)-
+      reinterpret_cast<uintptr_t>(old_arrays.groups())<
+      (old_arrays.groups_size_mask+1)*sizeof(group_type);
+  }
+#endif
+
   template<typename F>
   void for_all_elements(F f)const
   {
     for_all_elements(arrays,f);
+#if defined(BOOST_UNORDERED_ENABLE_INCREMENTAL_REHASH)
+    if(rehash_in_progress())for_all_elements(old_arrays,f);
+#endif
   }
 
   template<typename F>
-  static auto for_all_elements(const arrays_type& arrays_,F f)
+  static auto for_all_elements(const plain_arrays_type& arrays_,F f)
     ->decltype(f(nullptr),void())
   {
     for_all_elements_while(arrays_,[&](element_type* p){f(p);return true;});
   }
 
   template<typename F>
-  static auto for_all_elements(const arrays_type& arrays_,F f)
+  static auto for_all_elements(const plain_arrays_type& arrays_,F f)
     ->decltype(f(nullptr,0,nullptr),void())
   {
     for_all_elements_while(
@@ -2042,11 +2767,17 @@ public:
   template<typename F>
   bool for_all_elements_while(F f)const
   {
+#if defined(BOOST_UNORDERED_ENABLE_INCREMENTAL_REHASH)
+    return
+      for_all_elements_while(arrays,f)&&
+      (!rehash_in_progress()||for_all_elements_while(old_arrays,f));
+#else
     return for_all_elements_while(arrays,f);
+#endif
   }
 
   template<typename F>
-  static auto for_all_elements_while(const arrays_type& arrays_,F f)
+  static auto for_all_elements_while(const plain_arrays_type& arrays_,F f)
     ->decltype(f(nullptr),bool())
   {
     return for_all_elements_while(
@@ -2054,7 +2785,7 @@ public:
   }
 
   template<typename F>
-  static auto for_all_elements_while(const arrays_type& arrays_,F f)
+  static auto for_all_elements_while(const plain_arrays_type& arrays_,F f)
     ->decltype(f(nullptr,0,nullptr),bool())
   {
     auto p=arrays_.elements();
@@ -2062,6 +2793,14 @@ public:
       for(auto pg=arrays_.groups(),last=pg+arrays_.groups_size_mask+1;
           pg!=last;++pg,p+=N){
         auto mask=match_really_occupied(pg,last);
+#if defined(BOOST_UNORDERED_RUNTIME_DISPATCH)
+        if(!mask){
+          auto pg2=skip_empty_groups(pg+1,last);
+          p+=static_cast<std::size_t>(pg2-pg-1)*N;
+          pg=pg2-1;
+          continue;
+        }
+#endif
         while(mask){
           auto n=unchecked_countr_zero(mask);
           if(!f(pg,n,p+n))return false;
@@ -2079,6 +2818,15 @@ public:
   mutable cumulative_stats cstats;
 #endif
 
+#if defined(BOOST_UNORDERED_ENABLE_INCREMENTAL_REHASH)
+  /* Arrays being migrated from during incremental rehash, if any: their
+   * remaining old_size elements lie in groups [old_pos,end).
+   */
+  plain_arrays_type        old_arrays{0,0,nullptr,nullptr};
+  std::size_t              old_pos=0;
+  std::size_t              old_size=0;
+#endif
+
 private:
   template<
     typename,typename,template<typename...> class,
@@ -2086,6 +2834,9 @@ private:
   >
   friend class table_core;
 
+  template<typename,typename,typename,typename>
+  friend class concurrent_table;
+
   using hash_base=empty_value<Hash,0>;
   using pred_base=empty_value<Pred,1>;
   using allocator_base=empty_value<Allocator,2>;
@@ -2114,8 +2865,24 @@ private:
     return arrays_type::new_(typename arrays_type::allocator_type(al()),n);
   }
 
-  arrays_type new_arrays_for_growth()const
+  std::size_t slots_for_growth()const
   {
+#if defined(BOOST_UNORDERED_ENABLE_AUTO_SHRINK)
+    if(auto_shrink&&shrink_due()){
+      /* Halve capacity as many times as needed for size() to be back
+       * over the shrink threshold, so that a mass erasure is followed by a
+       * single rehash. The resulting load is below 2*auto_shrink_lf times
+       * the maximum, hence growth does not ensue right away (hysteresis).
+       */
+      static constexpr std::size_t small_capacity=2*N-1;
+
+      auto n=capacity()/2;
+      while(n>small_capacity&&
+            float(size())<auto_shrink_lf*mlf*float(n))n/=2;
+      return n;
+    }
+#endif
+
     /* Due to the anti-drift mechanism (see recover_slot), the new arrays may
      * be of the same size as the old arrays; in the limit, erasing one
      * element at full load and then inserting could bring us back to the same
@@ -2126,8 +2893,37 @@ private:
      * probability of an element having caused overflow; P has been measured as
      * ~0.162 under ideal conditions, yielding F ~ 0.0165 ~ 1/61.
      */
-    return new_arrays(std::size_t(
-      std::ceil(static_cast<float>(size()+size()/61+1)/mlf)));
+    return std::size_t(std::ceil(static_cast<float>(size()+size()/61+1)/mlf));
+  }
+
+  arrays_type new_arrays_for_growth()const
+  {
+    return new_arrays(slots_for_growth());
+  }
+
+#if defined(BOOST_UNORDERED_ENABLE_AUTO_SHRINK)
+  bool shrink_due()const
+  {
+    /* no shrinking below four groups (see initial_max_load) */
+    return
+      arrays.groups_size_mask>=3&&
+      float(size())<auto_shrink_lf*mlf*float(capacity());
+  }
+
+  void add_shrink_stats(const arrays_type& new_arrays_)
+  {
+    if(new_arrays_.groups_size_mask<arrays.groups_size_mask){
+      BOOST_UNORDERED_ADD_STATS(cstats.shrink,());
+    }
+  }
+#endif
+
+  bool growth_fits_in_place()const
+  {
+    /* ml lowered by anti-drift rather than lack of room: see
+     * unchecked_rehash_in_place.
+     */
+    return capacity_for(slots_for_growth())==capacity();
   }
 
   void delete_arrays(arrays_type& arrays_)noexcept
@@ -2166,7 +2962,8 @@ private:
   {
     BOOST_ASSERT(empty());
     BOOST_ASSERT(this!=std::addressof(x));
-    if(arrays.groups_size_mask==x.arrays.groups_size_mask){
+    if(arrays.groups_size_mask==x.arrays.groups_size_mask&&
+       !x.rehash_in_progress()){
       fast_copy_elements_from(x);
     }
     else{
@@ -2255,8 +3052,97 @@ private:
     }
   }
 
+#if defined(BOOST_MSVC)
+/* warning: forcing value to bool 'true' or 'false' in bool(pred()...) */
+#pragma warning(push)
+#pragma warning(disable:4800)
+#endif
+
+  template<typename FwdIterator,typename F>
+  BOOST_FORCEINLINE void unchecked_bulk_find(
+    FwdIterator first,std::size_t m,F& f)const
+  {
+    BOOST_ASSERT(m<2*bulk_visit_size);
+
+    std::size_t hashes[2*bulk_visit_size-1],
+                positions[2*bulk_visit_size-1];
+    int         masks[2*bulk_visit_size-1];
+    auto        it=first;
+
+    for(auto i=m;i--;++it){
+      auto hash=hashes[i]=hash_for(*it);
+      auto pos=positions[i]=position_for(hash);
+      BOOST_UNORDERED_PREFETCH(arrays.groups()+pos);
+    }
+
+    for(auto i=m;i--;){
+      auto hash=hashes[i];
+      auto pos=positions[i];
+      auto mask=masks[i]=(arrays.groups()+pos)->match(hash);
+      if(mask){
+        BOOST_UNORDERED_PREFETCH(
+          arrays.elements()+pos*N+unchecked_countr_zero(mask));
+      }
+    }
+
+    it=first;
+    for(auto i=m;i--;++it){
+      BOOST_UNORDERED_STATS_COUNTER(num_cmps);
+      auto          pos=positions[i];
+      prober        pb(pos);
+      auto          pg=arrays.groups()+pos;
+      auto          mask=masks[i];
+      element_type *p;
+      if(!mask)goto post_mask;
+      p=arrays.elements()+pos*N;
+      for(;;){
+        do{
+          BOOST_UNORDERED_INCREMENT_STATS_COUNTER(num_cmps);
+          auto n=unchecked_countr_zero(mask);
+          if(BOOST_LIKELY(bool(pred()(*it,key_from(p[n]))))){
+            BOOST_UNORDERED_ADD_STATS(
+              cstats.successful_lookup,(pb.length(),num_cmps));
+            f(it,locator{pg,n,p+n});
+            goto next_key;
+          }
+          mask&=mask-1;
+        }while(mask);
+      post_mask:
+        do{
+          if(BOOST_LIKELY(pg->is_not_overflowed(hashes[i]))||
+             BOOST_UNLIKELY(!pb.next(arrays.groups_size_mask))){
+            BOOST_UNORDERED_ADD_STATS(
+              cstats.unsuccessful_lookup,(pb.length(),num_cmps));
+            f(it,locator{});
+            goto next_key;
+          }
+          pos=pb.get();
+          pg=arrays.groups()+pos;
+          mask=pg->match(hashes[i]);
+        }while(!mask);
+        p=arrays.elements()+pos*N;
+        BOOST_UNORDERED_PREFETCH_ELEMENTS(p,N);
+      }
+      next_key:;
+    }
+  }
+
+#if defined(BOOST_MSVC)
+#pragma warning(pop) /* C4800 */
+#endif
+
   void recover_slot(unsigned char* pc)
   {
+#if defined(BOOST_UNORDERED_ENABLE_INCREMENTAL_REHASH)
+    if(BOOST_UNLIKELY(rehash_in_progress())&&in_old_arrays(pc)){
+      /* no anti-drift here: the old arrays don't take insertions */
+      group_type::reset(pc);
+      --old_size;
+      --size_ctrl.size;
+      return;
+    }
+#endif
+
     /* If this slot potentially caused overflow, we decrease the maximum load
      * so that average probe length won't increase unboundedly in repeated
      * insert/erase cycles (drift).
@@ -2264,6 +3150,17 @@ private:
     size_ctrl.ml-=group_type::maybe_caused_overflow(pc);
     group_type::reset(pc);
     --size_ctrl.size;
+
+#if defined(BOOST_UNORDERED_ENABLE_AUTO_SHRINK)
+    /* Erasure must not invalidate iterators, so rather than shrinking here
+     * we lower ml to the current size: the next insertion then goes through
+     * unchecked_emplace_with_rehash, which allocates smaller arrays (see
+     * slots_for_growth).
+     */
+    if(auto_shrink&&BOOST_UNLIKELY(shrink_due())){
+      size_ctrl.ml=std::size_t(size_ctrl.size);
+    }
+#endif
   }
 
   void recover_slot(group_type* pg,std::size_t pos)
@@ -2271,6 +3168,71 @@ private:
     recover_slot(reinterpret_cast<unsigned char*>(pg)+pos);
   }
 
+#if defined(BOOST_UNORDERED_ENABLE_INCREMENTAL_REHASH)
+  void swap_incremental_rehash_state(table_core& x)noexcept
+  {
+    using std::swap;
+    swap(old_arrays,x.old_arrays);
+    swap(old_pos,x.old_pos);
+    swap(old_size,x.old_size);
+  }
+
+  BOOST_NOINLINE void incremental_rehash_step(const locator& inserted)
+  {
+    BOOST_TRY{
+      migrate_old_groups(incremental_rehash_groups);
+    }
+    BOOST_CATCH(...){
+      /* strong exception guarantee for the insertion that triggered us */
+      erase(inserted.pg,inserted.n,inserted.p);
+      BOOST_RETHROW
+    }
+    BOOST_CATCH_END
+  }
+
+  void migrate_old_groups(std::size_t n)
+  {
+    auto groups_size=old_arrays.groups_size_mask+1;
+    auto last=old_arrays.groups()+groups_size;
+    for(;old_size&&n&&old_pos!=groups_size;--n,++old_pos){
+      auto pg=old_arrays.groups()+old_pos;
+      auto p=old_arrays.elements()+old_pos*N;
+      auto mask=match_really_occupied(pg,last);
+      while(mask){
+        auto i=unchecked_countr_zero(mask);
+        migrate_element(pg,i,p+i);
+        mask&=mask-1;
+      }
+    }
+    if(!old_size)release_old_arrays();
+  }
+
+  void migrate_element(group_type* pg,unsigned int n,element_type* p)
+  {
+    std::size_t num_destroyed=0;
+    BOOST_TRY{
+      nosize_transfer_element(p,arrays,num_destroyed);
+    }
+    BOOST_CATCH(...){
+      if(num_destroyed)recover_slot(pg,n); /* element lost */
+      BOOST_RETHROW
+    }
+    BOOST_CATCH_END
+    if(!num_destroyed)destroy_element(p);
+    pg->reset(n);
+    --old_size;
+  }
+
+  void release_old_arrays()noexcept
+  {
+    plain_arrays_type::delete_(
+      typename plain_arrays_type::allocator_type(al()),old_arrays);
+    old_arrays=plain_arrays_type{0,0,nullptr,nullptr};
+    old_pos=0;
+    old_size=0;
+  }
+#endif
+
   static std::size_t capacity_for(std::size_t n)
   {
     return size_policy::size(size_index_for<group_type,size_policy>(n))*N-1;
@@ -2284,6 +3246,8 @@ private:
 
   BOOST_NOINLINE void unchecked_rehash(arrays_type& new_arrays_)
   {
+    BOOST_ASSERT(!rehash_in_progress());
+
     std::size_t num_destroyed=0;
     BOOST_TRY{
       for_all_elements([&,this](element_type* p){
@@ -2317,6 +3281,89 @@ private:
     delete_arrays(arrays);
     arrays=new_arrays_;
     size_ctrl.ml=initial_max_load();
+    BOOST_UNORDERED_ADD_STATS(cstats.rehash,());
+  }
+
+  /* Growth within the same capacity happens when anti-drift (see
+   * recover_slot) has lowered ml because of overflow bits left behind by
+   * erased elements. Rather than reallocating, overflow bits are cleared and
+   * recalculated from the surviving elements; if this can't throw, elements
+   * are also moved back to the first available slot in their probe sequence
+   * (compaction). it is updated if the element it points to is moved. In the
+   * unlikely event that hashing throws, all overflow bits are set so that
+   * every element remains reachable.
+   */
+
+  BOOST_NOINLINE void unchecked_rehash_in_place(locator& it)
+  {
+    BOOST_ASSERT(!rehash_in_progress());
+
+    auto groups_size=arrays.groups_size_mask+1;
+    auto last=arrays.groups()+groups_size;
+    for(auto pg=arrays.groups();pg!=last;++pg)pg->reset_overflow();
+    BOOST_TRY{
+      for(std::size_t pos=0;pos!=groups_size;++pos){
+        auto pg=arrays.groups()+pos;
+        auto p=arrays.elements()+pos*N;
+        auto mask=match_really_occupied(pg,last);
+        while(mask){
+          auto n=unchecked_countr_zero(mask);
+          rehash_element_in_place(pg,pos,n,p+n,it);
+          mask&=mask-1;
+        }
+      }
+    }
+    BOOST_CATCH(...){
+      for(auto pg=arrays.groups();pg!=last;++pg){
+        for(std::size_t i=0;i<8;++i)pg->mark_overflow(i);
+      }
+      BOOST_RETHROW
+    }
+    BOOST_CATCH_END
+    size_ctrl.ml=initial_max_load();
+    BOOST_UNORDERED_ADD_STATS(cstats.in_place_rehash,());
+  }
+
+  void rehash_element_in_place(
+    group_type* pg,std::size_t pos,unsigned int n,element_type* p,locator& it)
+  {
+    auto hash=hash_for(key_from(*p));
+    for(prober pb(position_for(hash));pb.get()!=pos;
+        pb.next(arrays.groups_size_mask)){
+      auto pg1=arrays.groups()+pb.get();
+      if(relocate_element_in_place(
+        pg,n,p,pg1,pb.get(),hash,it,
+        std::integral_constant< /* relocation must not throw */
+          bool,
+          std::is_nothrow_move_constructible<init_type>::value||
+          !std::is_same<element_type,value_type>::value>{}))return;
+      pg1->mark_overflow(hash);
+    }
+  }
+
+  bool relocate_element_in_place(
+    group_type* pg,unsigned int n,element_type* p,
+    group_type* pg1,std::size_t pos1,std::size_t hash,locator& it,
+    std::true_type /* compaction */)
+  {
+    auto mask=pg1->match_available();
+    if(!mask)return false;
+    auto n1=unchecked_countr_zero(mask);
+    auto p1=arrays.elements()+pos1*N+n1;
+    construct_element(p1,type_policy::move(*p));
+    destroy_element(p);
+    pg1->set(n1,hash);
+    pg->reset(n);
+    if(p==it.p)it={pg1,n1,p1};
+    return true;
+  }
+
+  bool relocate_element_in_place(
+    group_type*,unsigned int,element_type*,
+    group_type*,std::size_t,std::size_t,locator&,
+    std::false_type /* no compaction */)
+  {
+    return false;
   }
 
   template<typename Value>
@@ -0,0 +1,145 @@
+// Copyright (C) 2025 Joaquin M Lopez Munoz
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_UNORDERED_DETAIL_FOA_FLAT_CACHE_TYPES_HPP
+#define BOOST_UNORDERED_DETAIL_FOA_FLAT_CACHE_TYPES_HPP
+
+#include <boost/core/allocator_access.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+namespace boost {
+  namespace unordered {
+    namespace detail {
+      namespace foa {
+        /* Slot of a concurrent_flat_cache: the value plus the eviction state
+         * used by concurrent_cache_table. value_from returns the value_type
+         * base subobject, which the cache downcasts back to reach the rest.
+         * stamp holds the CLOCK reference bit in bit 0 and the expiry time
+         * (steady_clock ticks, 0 meaning no expiry) in the remaining bits.
+         * weight is the value's contribution to the byte budget, if any.
+         */
+
+        template <class Value> struct cache_element : Value
+        {
+          static constexpr std::uint64_t referenced = 1;
+
+          template <class... Args>
+          explicit cache_element(Args&&... args)
+              : Value(std::forward<Args>(args)...)
+          {
+          }
+
+          cache_element(cache_element const& x)
+              : Value(static_cast<Value const&>(x)),
+                stamp{x.stamp.load(std::memory_order_relaxed)},
+                weight{x.weight}
+          {
+          }
+
+          cache_element(cache_element&& x)
+              : Value(
+                  std::move(const_cast<typename std::remove_const<
+                      typename Value::first_type>::type&>(x.first)),
+                  std::move(x.second)),
+                stamp{x.stamp.load(std::memory_order_relaxed)},
+                weight{x.weight}
+          {
+          }
+
+          mutable std::atomic<std::uint64_t> stamp{0};
+          std::size_t weight = 0;
+        };
+
+        template <class Key, class T> struct flat_cache_types
+        {
+          using key_type = Key;
+          using mapped_type = T;
+          using raw_key_type = typename std::remove_const<Key>::type;
+          using raw_mapped_type = typename std::remove_const<T>::type;
+
+          using init_type = std::pair<raw_key_type, raw_mapped_type>;
+          using moved_type = std::pair<raw_key_type&&, raw_mapped_type&&>;
+          using value_type = std::pair<Key const, T>;
+
+          using element_type = cache_element<value_type>;
+
+          static value_type& value_from(element_type& x) { return x; }
+
+          template <class K, class V>
+          static raw_key_type const& extract(std::pair<K, V> const& kv)
+          {
+            return kv.first;
+          }
+
+          static raw_key_type const& extract(element_type const& x)
+          {
+            return x.first;
+          }
+
+          static element_type&& move(element_type& x) { return std::move(x); }
+
+          static moved_type move(init_type& x)
+          {
+            return {std::move(x.first), std::move(x.second)};
+          }
+
+          static moved_type move(value_type& x)
+          {
+            return {std::move(const_cast<raw_key_type&>(x.first)),
+              std::move(const_cast<raw_mapped_type&>(x.second))};
+          }
+
+          template <class A, class... Args>
+          static void construct(A& al, element_type* p, Args&&... args)
+          {
+            using element_allocator =
+              typename boost::allocator_rebind<A, element_type>::type;
+
+            element_allocator eal(al);
+            boost::allocator_construct(eal, p, std::forward<Args>(args)...);
+          }
+
+          template <class A, class... Args>
+          static void construct(A& al, init_type* p, Args&&... args)
+          {
+            boost::allocator_construct(al, p, std::forward<Args>(args)...);
+          }
+
+          template <class A, class... Args>
+          static void construct(A& al, key_type* p, Args&&... args)
+          {
+            boost::allocator_construct(al, p, std::forward<Args>(args)...);
+          }
+
+          template <class A>
+          static void destroy(A& al, element_type* p) noexcept
+          {
+            using element_allocator =
+              typename boost::allocator_rebind<A, element_type>::type;
+
+            element_allocator eal(al);
+            boost::allocator_destroy(eal, p);
+          }
+
+          template <class A> static void destroy(A& al, init_type* p) noexcept
+          {
+            boost::allocator_destroy(al, p);
+          }
+
+          template <class A> static void destroy(A& al, key_type* p) noexcept
+          {
+            boost::allocator_destroy(al, p);
+          }
+        };
+      } // namespace foa
+    } // namespace detail
+  } // namespace unordered
+} // namespace boost
+
+#endif // BOOST_UNORDERED_DETAIL_FOA_FLAT_CACHE_TYPES_HPP
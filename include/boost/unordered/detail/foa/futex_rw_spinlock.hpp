@@ -0,0 +1,290 @@
+#ifndef BOOST_UNORDERED_DETAIL_FOA_FUTEX_RW_SPINLOCK_HPP_INCLUDED
+#define BOOST_UNORDERED_DETAIL_FOA_FUTEX_RW_SPINLOCK_HPP_INCLUDED
+
+// Copyright 2023 Peter Dimov
+// Copyright 2025 Joaquin M Lopez Munoz
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+// Variant of rw_spinlock that, after a bounded spin, parks waiting threads
+// on a futex keyed on the lock word rather than yielding and sleeping.
+// Only available on Linux, as signalled by
+// BOOST_UNORDERED_HAS_FUTEX_RW_SPINLOCK.
+
+#if defined(__linux__)
+
+#define BOOST_UNORDERED_HAS_FUTEX_RW_SPINLOCK
+
+#include <boost/core/yield_primitives.hpp>
+#include <atomic>
+#include <climits>
+#include <cstdint>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace boost{
+namespace unordered{
+namespace detail{
+namespace foa{
+
+class futex_rw_spinlock
+{
+private:
+
+    // bit 31: locked exclusive
+    // bit 30: writer pending
+    // bit 29: waiters parked (or about to park) on the futex
+    // bit 28..0: reader lock count
+
+    static constexpr std::uint32_t locked_exclusive_mask = 1u << 31; // 0x8000'0000
+    static constexpr std::uint32_t writer_pending_mask = 1u << 30; // 0x4000'0000
+    static constexpr std::uint32_t waiters_mask = 1u << 29; // 0x2000'0000
+    static constexpr std::uint32_t reader_lock_count_mask = waiters_mask - 1; // 0x1FFF'FFFF
+
+    static constexpr unsigned spin_count = 16; // iterations before parking
+
+    std::atomic<std::uint32_t> state_ = {};
+
+    struct null_waiter
+    {
+        void spin() noexcept {}
+        void sleep() noexcept {}
+    };
+
+private:
+
+    // Effects: Provides a hint to the implementation that the current thread
+    //          has been unable to make progress for k+1 iterations, and
+    //          reports it to w.
+
+    template<class Waiter>
+    static void pause( unsigned k, Waiter& w ) noexcept
+    {
+        if( k < 5 )
+        {
+            // Exponentially increase number of PAUSE instructions, as in
+            // rw_spinlock
+
+            unsigned const pause_count = 1u << k;
+
+            for( unsigned i = 0; i < pause_count; ++i )
+            {
+                boost::core::sp_thread_pause();
+            }
+        }
+        else
+        {
+            boost::core::sp_thread_yield();
+        }
+
+        w.spin();
+    }
+
+    // Effects: As pause( k, w ) for the first spin_count iterations;
+    //          afterwards, blocks until the lock is released, st being a
+    //          state observed in which the lock was held in a mode
+    //          incompatible with the requested one, and calls w.sleep().
+
+    template<class Waiter>
+    void wait( unsigned k, std::uint32_t st, Waiter& w ) noexcept
+    {
+        if( k < spin_count )
+        {
+            pause( k, w );
+            return;
+        }
+
+        if( !( st & waiters_mask ) )
+        {
+            // announce ourselves so that unlocking wakes us up; if the state
+            // has changed in the meantime, the lock may be free, retry
+
+            std::uint32_t newst = st | waiters_mask;
+            if( !state_.compare_exchange_strong( st, newst, std::memory_order_relaxed, std::memory_order_relaxed ) )
+            {
+                w.spin();
+                return;
+            }
+
+            st = newst;
+        }
+
+        // Non-private futex operations, as the lock may be placed in memory
+        // shared among processes. FUTEX_WAIT returns immediately if state_
+        // is no longer st.
+
+        ::syscall( SYS_futex, reinterpret_cast<std::uint32_t*>( &state_ ), FUTEX_WAIT, st, nullptr, nullptr, 0 );
+        w.sleep();
+    }
+
+    void wake_all() noexcept
+    {
+        ::syscall( SYS_futex, reinterpret_cast<std::uint32_t*>( &state_ ), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0 );
+    }
+
+    static bool can_lock_shared( std::uint32_t st ) noexcept
+    {
+        return ( st & ( locked_exclusive_mask | writer_pending_mask ) ) == 0 &&
+            ( st & reader_lock_count_mask ) != reader_lock_count_mask;
+    }
+
+public:
+
+    bool try_lock_shared() noexcept
+    {
+        std::uint32_t st = state_.load( std::memory_order_relaxed );
+
+        if( !can_lock_shared( st ) )
+        {
+            // either bit 31 set, bit 30 set, or reader count is max
+            return false;
+        }
+
+        std::uint32_t newst = st + 1;
+        return state_.compare_exchange_strong( st, newst, std::memory_order_acquire, std::memory_order_relaxed );
+    }
+
+    void lock_shared() noexcept
+    {
+        null_waiter w;
+        lock_shared( w );
+    }
+
+    // Effects: As lock_shared(), calling w.spin() for every iteration of
+    //          no progress and w.sleep() every time the thread parks.
+
+    template<class Waiter>
+    void lock_shared( Waiter& w ) noexcept
+    {
+        for( unsigned k = 0; ; ++k )
+        {
+            std::uint32_t st = state_.load( std::memory_order_relaxed );
+
+            if( can_lock_shared( st ) )
+            {
+                std::uint32_t newst = st + 1;
+                if( state_.compare_exchange_weak( st, newst, std::memory_order_acquire, std::memory_order_relaxed ) ) return;
+
+                pause( k % spin_count, w );
+            }
+            else if( st & ( locked_exclusive_mask | writer_pending_mask ) )
+            {
+                wait( k, st, w );
+            }
+            else
+            {
+                // reader count is max, spin
+
+                pause( k % spin_count, w );
+            }
+        }
+    }
+
+    void unlock_shared() noexcept
+    {
+        // pre: locked shared, not locked exclusive
+
+        std::uint32_t st = state_.fetch_sub( 1, std::memory_order_release ) - 1;
+
+        // only a pending writer can be waiting for the last reader to leave
+
+        if( ( st & waiters_mask ) && ( st & reader_lock_count_mask ) == 0 )
+        {
+            state_.fetch_and( ~waiters_mask, std::memory_order_relaxed );
+            wake_all();
+        }
+    }
+
+    bool try_lock() noexcept
+    {
+        std::uint32_t st = state_.load( std::memory_order_relaxed );
+
+        if( st & locked_exclusive_mask )
+        {
+            // locked exclusive
+            return false;
+        }
+
+        if( st & reader_lock_count_mask )
+        {
+            // locked shared
+            return false;
+        }
+
+        // keep the waiters bit so that they are woken up on unlock
+
+        std::uint32_t newst = locked_exclusive_mask | ( st & waiters_mask );
+        return state_.compare_exchange_strong( st, newst, std::memory_order_acquire, std::memory_order_relaxed );
+    }
+
+    void lock() noexcept
+    {
+        null_waiter w;
+        lock( w );
+    }
+
+    // Effects: As lock(), calling w.spin() for every iteration of no
+    //          progress and w.sleep() every time the thread parks.
+
+    template<class Waiter>
+    void lock( Waiter& w ) noexcept
+    {
+        for( unsigned k = 0; ; ++k )
+        {
+            std::uint32_t st = state_.load( std::memory_order_relaxed );
+
+            if( st & locked_exclusive_mask )
+            {
+                // locked exclusive, wait
+
+                wait( k, st, w );
+            }
+            else if( ( st & reader_lock_count_mask ) == 0 )
+            {
+                // not locked exclusive, not locked shared, try to lock
+
+                std::uint32_t newst = locked_exclusive_mask | ( st & waiters_mask );
+                if( state_.compare_exchange_weak( st, newst, std::memory_order_acquire, std::memory_order_relaxed ) ) return;
+
+                pause( k % spin_count, w );
+            }
+            else if( st & writer_pending_mask )
+            {
+                // writer pending bit already set, wait for readers to leave
+
+                wait( k, st, w );
+            }
+            else
+            {
+                // locked shared, set writer pending bit
+
+                std::uint32_t newst = st | writer_pending_mask;
+                state_.compare_exchange_weak( st, newst, std::memory_order_relaxed, std::memory_order_relaxed );
+
+                pause( k % spin_count, w );
+            }
+        }
+    }
+
+    void unlock() noexcept
+    {
+        // pre: locked exclusive, not locked shared
+
+        if( state_.exchange( 0, std::memory_order_release ) & waiters_mask )
+        {
+            wake_all();
+        }
+    }
+};
+
+static_assert( sizeof( futex_rw_spinlock ) == sizeof( std::uint32_t ), "futex_rw_spinlock must fit in a futex word" );
+
+} /* namespace foa */
+} /* namespace detail */
+} /* namespace unordered */
+} /* namespace boost */
+
+#endif // defined(__linux__)
+
+#endif // BOOST_UNORDERED_DETAIL_FOA_FUTEX_RW_SPINLOCK_HPP_INCLUDED
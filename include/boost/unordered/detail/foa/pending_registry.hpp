@@ -0,0 +1,136 @@
+/* Registry of in-flight compute_if_absent operations.
+ *
+ * Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/unordered for library home page.
+ */
+
+#ifndef BOOST_UNORDERED_DETAIL_FOA_PENDING_REGISTRY_HPP
+#define BOOST_UNORDERED_DETAIL_FOA_PENDING_REGISTRY_HPP
+
+#include <algorithm>
+#include <boost/config.hpp>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+namespace boost{
+namespace unordered{
+namespace detail{
+namespace foa{
+
+/* concurrent_table::compute_if_absent runs the user-provided factory with
+ * no lock held, so the key being computed must be marked as pending
+ * somewhere else than in its bucket group: group metadata has no spare
+ * reduced hash value to denote a reserved slot. Pending computations are
+ * registered here as (table, hash) pairs, and threads finding an equal pair
+ * already registered wait on the stripe's condition variable until it is
+ * removed. Keys are not compared, as the registering thread moves its key
+ * into the table while still registered; two different keys with the same
+ * hash value in the same table just make one computation wait for the
+ * other.
+ *
+ * The registry is process-wide so that concurrent tables don't grow in size,
+ * and striped by hash value so that unrelated computations seldom contend
+ * on the same mutex.
+ */
+
+class pending_registry
+{
+  struct entry
+  {
+    bool operator==(const entry& x)const
+    {
+      return table==x.table&&hash==x.hash;
+    }
+
+    const void* table;
+    std::size_t hash;
+  };
+
+  struct stripe
+  {
+    std::mutex              mtx;
+    std::condition_variable cv;
+    std::vector<entry>      entries;
+  };
+
+  static constexpr std::size_t num_stripes=64;
+
+public:
+  class registration
+  {
+  public:
+    registration(registration&& x)noexcept:
+      pr{x.pr},e(x.e){x.pr=nullptr;}
+    registration& operator=(registration&&)=delete;
+    ~registration(){if(pr)pr->remove(e);}
+
+    explicit operator bool()const noexcept{return pr!=nullptr;}
+
+  private:
+    friend class pending_registry;
+
+    registration(pending_registry* pr_,entry e_):pr{pr_},e(e_){}
+
+    pending_registry* pr;
+    entry             e;
+  };
+
+  static pending_registry& instance()
+  {
+    static pending_registry r;
+    return r;
+  }
+
+  /* Registers (table,hash) as pending and returns a registration that
+   * removes it on destruction. If already registered, waits until it's not
+   * and returns an empty registration instead: the caller must then look
+   * the key up again.
+   */
+
+  registration try_register(const void* table,std::size_t hash)
+  {
+    entry                        e{table,hash};
+    auto&                        s=stripe_for(hash);
+    std::unique_lock<std::mutex> lck(s.mtx);
+    if(std::find(s.entries.begin(),s.entries.end(),e)!=s.entries.end()){
+      s.cv.wait(lck,[&]{
+        return std::find(s.entries.begin(),s.entries.end(),e)==
+               s.entries.end();
+      });
+      return {nullptr,e};
+    }
+    s.entries.push_back(e);
+    return {this,e};
+  }
+
+private:
+  stripe& stripe_for(std::size_t hash)
+  {
+    return stripes[hash%num_stripes];
+  }
+
+  void remove(const entry& e)
+  {
+    auto& s=stripe_for(e.hash);
+    {
+      std::lock_guard<std::mutex> lck(s.mtx);
+      s.entries.erase(std::find(s.entries.begin(),s.entries.end(),e));
+    }
+    s.cv.notify_all();
+  }
+
+  stripe stripes[num_stripes];
+};
+
+} /* namespace foa */
+} /* namespace detail */
+} /* namespace unordered */
+} /* namespace boost */
+
+#endif
@@ -28,12 +28,20 @@ private:
 
     std::atomic<std::uint32_t> state_ = {};
 
+    struct null_waiter
+    {
+        void spin() noexcept {}
+        void sleep() noexcept {}
+    };
+
 private:
 
     // Effects: Provides a hint to the implementation that the current thread
-    //          has been unable to make progress for k+1 iterations.
+    //          has been unable to make progress for k+1 iterations, and
+    //          reports it to w.
 
-    static void yield( unsigned k ) noexcept
+    template<class Waiter>
+    static void yield( unsigned k, Waiter& w ) noexcept
     {
         unsigned const sleep_every = 1024; // see below
 
@@ -52,6 +60,8 @@ private:
             {
                 boost::core::sp_thread_pause();
             }
+
+            w.spin();
         }
         else if( k < sleep_every - 1 )
         {
@@ -59,6 +69,7 @@ private:
             // we switch to yielding the timeslice immediately
 
             boost::core::sp_thread_yield();
+            w.spin();
         }
         else
         {
@@ -66,6 +77,7 @@ private:
             // to avoid a deadlock if a lower priority thread has the lock
 
             boost::core::sp_thread_sleep();
+            w.sleep();
         }
     }
 
@@ -86,6 +98,16 @@ public:
     }
 
     void lock_shared() noexcept
+    {
+        null_waiter w;
+        lock_shared( w );
+    }
+
+    // Effects: As lock_shared(), calling w.spin() for every iteration of
+    //          no progress and w.sleep() every time the thread sleeps.
+
+    template<class Waiter>
+    void lock_shared( Waiter& w ) noexcept
     {
         for( unsigned k = 0; ; ++k )
         {
@@ -97,7 +119,7 @@ public:
                 if( state_.compare_exchange_weak( st, newst, std::memory_order_acquire, std::memory_order_relaxed ) ) return;
             }
 
-            yield( k );
+            yield( k, w );
         }
     }
 
@@ -132,6 +154,16 @@ public:
     }
 
     void lock() noexcept
+    {
+        null_waiter w;
+        lock( w );
+    }
+
+    // Effects: As lock(), calling w.spin() for every iteration of no
+    //          progress and w.sleep() every time the thread sleeps.
+
+    template<class Waiter>
+    void lock( Waiter& w ) noexcept
     {
         for( unsigned k = 0; ; ++k )
         {
@@ -160,7 +192,7 @@ public:
                 state_.compare_exchange_weak( st, newst, std::memory_order_relaxed, std::memory_order_relaxed );
             }
 
-            yield( k );
+            yield( k, w );
         }
     }
 
@@ -78,6 +78,11 @@ class table;
  * addresses rather than pointers).
  * 
  * p = nullptr is conventionally used to mark end() iterators.
+ *
+ * With BOOST_UNORDERED_ENABLE_INCREMENTAL_REHASH, iterators into the new
+ * arrays of a table being incrementally rehashed additionally keep opc and
+ * op pointing to the first non-migrated group of the old arrays, where
+ * traversal jumps to once the end of the new arrays is reached.
  */
 
 /* internal conversion from const_iterator to iterator */
@@ -109,12 +114,21 @@ public:
     typename std::conditional<Const,value_type const,value_type>::type;
 
   table_iterator():pc_{nullptr},p_{nullptr}{};
+#if defined(BOOST_UNORDERED_ENABLE_INCREMENTAL_REHASH)
+  template<bool Const2,typename std::enable_if<!Const2>::type* =nullptr>
+  table_iterator(const table_iterator<TypePolicy,GroupPtr,Const2>& x):
+    pc_{x.pc_},p_{x.p_},opc_{x.opc_},op_{x.op_}{}
+  table_iterator(
+    const_iterator_cast_tag, const table_iterator<TypePolicy,GroupPtr,true>& x):
+    pc_{x.pc_},p_{x.p_},opc_{x.opc_},op_{x.op_}{}
+#else
   template<bool Const2,typename std::enable_if<!Const2>::type* =nullptr>
   table_iterator(const table_iterator<TypePolicy,GroupPtr,Const2>& x):
     pc_{x.pc_},p_{x.p_}{}
   table_iterator(
     const_iterator_cast_tag, const table_iterator<TypePolicy,GroupPtr,true>& x):
     pc_{x.pc_},p_{x.p_}{}
+#endif
 
   inline reference operator*()const noexcept
     {return type_policy::value_from(*p());}
@@ -141,6 +155,18 @@ private:
     p_{to_pointer<table_element_pointer>(const_cast<table_element_type*>(ptet))}
   {}
 
+#if defined(BOOST_UNORDERED_ENABLE_INCREMENTAL_REHASH)
+  table_iterator(
+    group_type* pg,std::size_t n,const table_element_type* ptet,
+    group_type* opg,const table_element_type* optet):
+    table_iterator{pg,n,ptet}
+  {
+    opc_=to_pointer<char_pointer>(reinterpret_cast<unsigned char*>(opg));
+    op_=to_pointer<table_element_pointer>(
+      const_cast<table_element_type*>(optet));
+  }
+#endif
+
   unsigned char* pc()const noexcept{return boost::to_address(pc_);}
   table_element_type* p()const noexcept{return boost::to_address(p_);}
 
@@ -148,7 +174,23 @@ private:
   {
     BOOST_ASSERT(p()!=nullptr);
     increment(std::integral_constant<bool,regular_layout>{});
+#if defined(BOOST_UNORDERED_ENABLE_INCREMENTAL_REHASH)
+    if(BOOST_UNLIKELY(!p_&&op_))jump_to_old_arrays();
+#endif
+  }
+
+#if defined(BOOST_UNORDERED_ENABLE_INCREMENTAL_REHASH)
+  BOOST_NOINLINE void jump_to_old_arrays()noexcept
+  {
+    pc_=opc_;
+    p_=op_;
+    opc_=nullptr;
+    op_=nullptr;
+    if(!(reinterpret_cast<group_type*>(pc())->match_occupied()&0x1)){
+      increment(std::integral_constant<bool,regular_layout>{});
+    }
   }
+#endif
 
   inline void increment(std::true_type /* regular layout */)noexcept
   {
@@ -235,6 +277,10 @@ private:
 
   char_pointer          pc_=nullptr;
   table_element_pointer  p_=nullptr;
+#if defined(BOOST_UNORDERED_ENABLE_INCREMENTAL_REHASH)
+  char_pointer          opc_=nullptr;
+  table_element_pointer  op_=nullptr;
+#endif
 };
 
 /* Returned by table::erase([const_]iterator) to avoid iterator increment
@@ -305,9 +351,12 @@ private:
 template<typename,typename,typename,typename>
 class concurrent_table; /* concurrent/non-concurrent interop */
 
+template<typename,typename,typename,typename>
+class cache_table; /* evicts in place, see cache_table.hpp */
+
 template <typename TypePolicy,typename Hash,typename Pred,typename Allocator>
 using table_core_impl=
-  table_core<TypePolicy,group15<plain_integral>,table_arrays,
+  table_core<TypePolicy,default_group<plain_integral>,table_arrays,
   plain_size_control,Hash,Pred,Allocator>;
 
 #include <boost/unordered/detail/foa/ignore_wshadow.hpp>
@@ -334,6 +383,7 @@ class table:table_core_impl<TypePolicy,Hash,Pred,Allocator>
     typename boost::allocator_pointer<Allocator>::type
   >::template rebind<group_type>;
   friend compatible_concurrent_table;
+  friend cache_table<TypePolicy,Hash,Pred,Allocator>;
 
 public:
   using key_type=typename super::key_type;
@@ -360,6 +410,7 @@ public:
     table_iterator<type_policy,group_type_pointer,false>,
     const_iterator>::type;
   using erase_return_type=table_erase_return_type<iterator>;
+  using super::bulk_visit_size;
 
 #if defined(BOOST_UNORDERED_ENABLE_STATS)
   using stats=typename super::stats;
@@ -386,7 +437,7 @@ public:
 
   iterator begin()noexcept
   {
-    iterator it{this->arrays.groups(),0,this->arrays.elements()};
+    iterator it=make_iterator(this->arrays.groups(),0,this->arrays.elements());
     if(this->arrays.elements()&&
        !(this->arrays.groups()[0].match_occupied()&0x1))++it;
     return it;
@@ -442,6 +493,15 @@ public:
       try_emplace_args_t{},std::forward<Key>(x),std::forward<Args>(args)...);
   }
 
+  template<typename Key,typename... Args>
+  BOOST_FORCEINLINE std::pair<iterator,bool> try_emplace(
+    Key&& x,precomputed_hash hash,Args&&... args)
+  {
+    return emplace_impl_with_hash(
+      this->hash_for(x,hash),
+      try_emplace_args_t{},std::forward<Key>(x),std::forward<Args>(args)...);
+  }
+
   BOOST_FORCEINLINE std::pair<iterator,bool>
   insert(const init_type& x){return emplace_impl(x);}
 
@@ -466,6 +526,37 @@ public:
   >::type
   insert(element_type&& x){return emplace_impl(std::move(x));}
 
+  /* Bulk insertion is pipelined in chunks of bulk_visit_size when iterating
+   * over value_type/init_type elements with a forward iterator, otherwise
+   * elements are emplaced one by one.
+   */
+
+  template<typename InputIterator>
+  void insert_bulk(InputIterator first,InputIterator last)
+  {
+    insert_bulk(
+      first,last,
+      std::integral_constant<
+        bool,is_pipelined_insert_iterator<InputIterator>::value>{});
+  }
+
+  template<typename FwdIterator>
+  std::size_t erase_bulk(FwdIterator first,FwdIterator last)
+  {
+    std::size_t res=0;
+    auto        n=static_cast<std::size_t>(std::distance(first,last));
+    while(n){
+      auto m=n<2*bulk_visit_size?n:bulk_visit_size;
+      res+=unchecked_erase_bulk(first,m);
+      n-=m;
+      std::advance(
+        first,
+        static_cast<
+          typename std::iterator_traits<FwdIterator>::difference_type>(m));
+    }
+    return res;
+  }
+
   template<
     bool dependent_value=false,
     typename std::enable_if<
@@ -495,6 +586,17 @@ public:
     else return 0;
   }
 
+  template<typename Key>
+  BOOST_FORCEINLINE std::size_t erase(const Key& x,precomputed_hash hash)
+  {
+    auto it=find(x,hash);
+    if(it!=end()){
+      erase(it);
+      return 1;
+    }
+    else return 0;
+  }
+
   void swap(table& x)
     noexcept(noexcept(std::declval<super&>().swap(std::declval<super&>())))
   {
@@ -526,6 +628,7 @@ public:
 
   using super::hash_function;
   using super::key_eq;
+  using super::hash_function_mixed;
 
   template<typename Key>
   BOOST_FORCEINLINE iterator find(const Key& x)
@@ -539,6 +642,77 @@ public:
     return const_cast<table*>(this)->find(x);
   }
 
+  template<typename Key>
+  BOOST_FORCEINLINE iterator find(const Key& x,precomputed_hash hash)
+  {
+    auto hash_=this->hash_for(x,hash);
+    return make_iterator(super::find(x,this->position_for(hash_),hash_));
+  }
+
+  template<typename Key>
+  BOOST_FORCEINLINE const_iterator find(
+    const Key& x,precomputed_hash hash)const
+  {
+    return const_cast<table*>(this)->find(x,hash);
+  }
+
+  template<typename FwdIterator,typename OutputIterator>
+  BOOST_FORCEINLINE OutputIterator find(
+    FwdIterator first,FwdIterator last,OutputIterator out)
+  {
+    super::bulk_find(first,last,[&](FwdIterator,const locator& l){
+      *out++=make_iterator(l);
+    });
+    return out;
+  }
+
+  template<typename FwdIterator,typename OutputIterator>
+  BOOST_FORCEINLINE OutputIterator find(
+    FwdIterator first,FwdIterator last,OutputIterator out)const
+  {
+    super::bulk_find(first,last,[&](FwdIterator,const locator& l){
+      *out++=const_iterator(make_iterator(l));
+    });
+    return out;
+  }
+
+  template<typename FwdIterator,typename OutputIterator>
+  BOOST_FORCEINLINE OutputIterator contains(
+    FwdIterator first,FwdIterator last,OutputIterator out)const
+  {
+    super::bulk_find(first,last,[&](FwdIterator,const locator& l){
+      *out++=bool(l);
+    });
+    return out;
+  }
+
+  template<typename FwdIterator,typename F>
+  BOOST_FORCEINLINE std::size_t visit(FwdIterator first,FwdIterator last,F&& f)
+  {
+    std::size_t res=0;
+    super::bulk_find(first,last,[&](FwdIterator,const locator& l){
+      if(l){
+        f(*make_iterator(l));
+        ++res;
+      }
+    });
+    return res;
+  }
+
+  template<typename FwdIterator,typename F>
+  BOOST_FORCEINLINE std::size_t visit(
+    FwdIterator first,FwdIterator last,F&& f)const
+  {
+    std::size_t res=0;
+    super::bulk_find(first,last,[&](FwdIterator,const locator& l){
+      if(l){
+        f(*const_iterator(make_iterator(l)));
+        ++res;
+      }
+    });
+    return res;
+  }
+
   using super::capacity;
   using super::load_factor;
   using super::max_load_factor;
@@ -596,10 +770,16 @@ private:
     BOOST_UNORDERED_SWAP_STATS(this->cstats,x.cstats);
   }
 
+  /* x's arrays are taken over as they are, so any pending cooperative
+   * rehash must be completed beforehand.
+   */
   template<typename ExclusiveLockGuard>
   table(compatible_concurrent_table&& x,ExclusiveLockGuard):
-    table(std::move(x),x.make_empty_arrays())
-  {}
+    table(
+      (x.finish_cooperative_rehash(),std::move(x)),x.make_empty_arrays())
+  {
+    BOOST_ASSERT(!x.is_frozen());
+  }
 
   struct erase_on_exit
   {
@@ -613,16 +793,154 @@ private:
     bool           rollback_=false;
   };
 
-  static inline iterator make_iterator(const locator& l)noexcept
+  inline iterator make_iterator(const locator& l)const noexcept
+  {
+    return make_iterator(l.pg,l.n,l.p);
+  }
+
+  inline iterator make_iterator(
+    group_type* pg,unsigned int n,element_type* p)const noexcept
+  {
+#if defined(BOOST_UNORDERED_ENABLE_INCREMENTAL_REHASH)
+    if(BOOST_UNLIKELY(this->rehash_in_progress())&&!this->in_old_arrays(pg)){
+      return {
+        pg,n,p,this->old_arrays.groups()+this->old_pos,
+        this->old_arrays.elements()+this->old_pos*N};
+    }
+#endif
+    return {pg,n,p};
+  }
+
+  template<typename Iterator>
+  using is_pipelined_insert_iterator=std::integral_constant<
+    bool,
+    std::is_base_of<
+      std::forward_iterator_tag,
+      typename std::iterator_traits<Iterator>::iterator_category
+    >::value&&
+    detail::is_similar_to_any<
+      typename std::iterator_traits<Iterator>::reference,
+      value_type,init_type
+    >::value
+  >;
+
+  template<typename InputIterator>
+  void insert_bulk(
+    InputIterator first,InputIterator last,std::false_type /* pipelined */)
+  {
+    for(;first!=last;++first)emplace(*first);
+  }
+
+  template<typename FwdIterator>
+  void insert_bulk(
+    FwdIterator first,FwdIterator last,std::true_type /* pipelined */)
+  {
+    auto n=static_cast<std::size_t>(std::distance(first,last));
+    while(n){
+      auto m=n<2*bulk_visit_size?n:bulk_visit_size;
+      unchecked_insert_bulk(first,m);
+      n-=m;
+      std::advance(
+        first,
+        static_cast<
+          typename std::iterator_traits<FwdIterator>::difference_type>(m));
+    }
+  }
+
+  /* Prefetches the element slots positions[0,m) are likely to be accessed at,
+   * once their groups have been (prefetched and) loaded.
+   */
+
+  BOOST_FORCEINLINE void prefetch_elements_for(
+    const std::size_t* hashes,const std::size_t* positions,std::size_t m)const
+  {
+    auto elements=this->arrays.elements();
+    if(!elements)return;
+    for(std::size_t i=0;i<m;++i){
+      auto pos=positions[i];
+      auto pg=this->arrays.groups()+pos;
+      auto mask=pg->match(hashes[i]);
+      if(!mask)mask=pg->match_available();
+      if(mask){
+        BOOST_UNORDERED_PREFETCH(elements+pos*N+unchecked_countr_zero(mask));
+      }
+    }
+  }
+
+  template<typename FwdIterator>
+  BOOST_FORCEINLINE void unchecked_insert_bulk(FwdIterator first,std::size_t m)
+  {
+    BOOST_ASSERT(m<2*bulk_visit_size);
+
+    std::size_t hashes[2*bulk_visit_size-1],
+                positions[2*bulk_visit_size-1];
+    auto        it=first;
+
+    for(std::size_t i=0;i<m;++i,++it){
+      auto hash=hashes[i]=this->hash_for(this->key_from(*it));
+      auto pos=positions[i]=this->position_for(hash);
+      BOOST_UNORDERED_PREFETCH(this->arrays.groups()+pos);
+    }
+    prefetch_elements_for(hashes,positions,m);
+
+    it=first;
+    for(std::size_t i=0;i<m;++i,++it){
+      if(super::find(this->key_from(*it),positions[i],hashes[i]))continue;
+      if(BOOST_LIKELY(this->size_ctrl.size<this->size_ctrl.ml)){
+        this->unchecked_emplace_at(positions[i],hashes[i],*it);
+      }
+      else{
+        this->unchecked_emplace_with_rehash(hashes[i],*it);
+
+        /* positions of the remaining elements are stale after rehashing */
+
+        for(auto j=i+1;j<m;++j)positions[j]=this->position_for(hashes[j]);
+      }
+    }
+  }
+
+  template<typename FwdIterator>
+  BOOST_FORCEINLINE std::size_t unchecked_erase_bulk(
+    FwdIterator first,std::size_t m)
   {
-    return {l.pg,l.n,l.p};
+    BOOST_ASSERT(m<2*bulk_visit_size);
+
+    std::size_t res=0,
+                hashes[2*bulk_visit_size-1],
+                positions[2*bulk_visit_size-1];
+    auto        it=first;
+
+    for(std::size_t i=0;i<m;++i,++it){
+      auto hash=hashes[i]=this->hash_for(*it);
+      auto pos=positions[i]=this->position_for(hash);
+      BOOST_UNORDERED_PREFETCH(this->arrays.groups()+pos);
+    }
+    prefetch_elements_for(hashes,positions,m);
+
+    it=first;
+    for(std::size_t i=0;i<m;++i,++it){
+      auto loc=super::find(*it,positions[i],hashes[i]);
+      if(loc){
+        super::erase(loc.pg,loc.n,loc.p);
+        ++res;
+      }
+    }
+    return res;
   }
 
   template<typename... Args>
   BOOST_FORCEINLINE std::pair<iterator,bool> emplace_impl(Args&&... args)
+  {
+    return emplace_impl_with_hash(
+      this->hash_for(this->key_from(std::forward<Args>(args)...)),
+      std::forward<Args>(args)...);
+  }
+
+  template<typename... Args>
+  BOOST_FORCEINLINE std::pair<iterator,bool> emplace_impl_with_hash(
+    std::size_t hash,Args&&... args)
   {
     const auto &k=this->key_from(std::forward<Args>(args)...);
-    auto        hash=this->hash_for(k);
     auto        pos0=this->position_for(hash);
     auto        loc=super::find(k,pos0,hash);
 
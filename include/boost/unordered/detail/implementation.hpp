@@ -93,6 +93,19 @@ namespace boost {
       static const float minimum_max_load_factor = 1e-3f;
       static const std::size_t default_bucket_count = 0;
 
+#if defined(BOOST_UNORDERED_ENABLE_AUTO_SHRINK)
+#if !defined(BOOST_UNORDERED_AUTO_SHRINK_LOAD_FACTOR)
+#define BOOST_UNORDERED_AUTO_SHRINK_LOAD_FACTOR 0.25f
+#endif
+
+      // The bucket array shrinks when the load factor falls below this
+      // fraction of the maximum load factor.
+      static constexpr float auto_shrink_load_factor =
+        BOOST_UNORDERED_AUTO_SHRINK_LOAD_FACTOR;
+      BOOST_UNORDERED_STATIC_ASSERT(
+        auto_shrink_load_factor > 0.0f && auto_shrink_load_factor < 0.5f);
+#endif
+
       struct move_tag
       {
       };
@@ -1357,6 +1370,44 @@ namespace boost {
           recalculate_max_load();
         }
 
+        // Erasure must not invalidate iterators to other elements, so rather
+        // than shrinking here we lower max_load_ to the current size: the
+        // next insertion then calls reserve or reserve_for_insert, which
+        // allocate a smaller bucket array.
+        void schedule_shrink_if_due()
+        {
+#if defined(BOOST_UNORDERED_ENABLE_AUTO_SHRINK)
+          if (shrink_due()) {
+            max_load_ = size_;
+          }
+#endif
+        }
+
+#if defined(BOOST_UNORDERED_ENABLE_AUTO_SHRINK)
+        bool shrink_due() const
+        {
+          std::size_t const bc = buckets_.bucket_count();
+          return static_cast<float>(size_) < auto_shrink_load_factor * mlf_ *
+                                               static_cast<float>(bc) &&
+                 bucket_array_type::bucket_count_for(bc / 2) < bc;
+        }
+
+        // Halves the bucket count as many times as needed for the load factor
+        // to be back over the shrink threshold, so that a mass erasure is
+        // followed by a single rehash. The resulting load factor is below
+        // twice the threshold, hence growth does not ensue right away.
+        std::size_t buckets_for_shrinkage() const
+        {
+          std::size_t num_buckets = buckets_.bucket_count() / 2;
+          while (num_buckets > 1 &&
+                 static_cast<float>(size_) < auto_shrink_load_factor * mlf_ *
+                                               static_cast<float>(num_buckets)) {
+            num_buckets /= 2;
+          }
+          return num_buckets;
+        }
+#endif
+
         ////////////////////////////////////////////////////////////////////////
         // Constructors
 
@@ -1765,6 +1816,7 @@ namespace boost {
 
           buckets_.extract_node(it.itb, it.p);
           --size_;
+          schedule_shrink_if_due();
 
           return it.p;
         }
@@ -2190,6 +2242,7 @@ namespace boost {
 
           buckets_.extract_node(itb, p);
           --size_;
+          schedule_shrink_if_due();
 
           return p;
         }
@@ -2210,6 +2263,7 @@ namespace boost {
           buckets_.extract_node_after(itb, pp);
           this->delete_node(p);
           --size_;
+          schedule_shrink_if_due();
           return 1;
         }
 
@@ -2227,6 +2281,7 @@ namespace boost {
           buckets_.extract_node_after(itb, pp);
           this->delete_node(pos.p);
           --size_;
+          schedule_shrink_if_due();
 
           return iterator(next.p, next.itb);
         }
@@ -2266,6 +2321,7 @@ namespace boost {
               pp = std::addressof(itb->next);
             }
           }
+          schedule_shrink_if_due();
 
           return iterator(last.p, last.itb);
         }
@@ -2580,6 +2636,7 @@ namespace boost {
           bucket_iterator itb = n.itb;
           buckets_.extract_node(itb, p);
           --size_;
+          schedule_shrink_if_due();
           return p;
         }
 
@@ -2607,6 +2664,7 @@ namespace boost {
             if (!itb->next) {
               buckets_.unlink_bucket(itb);
             }
+            schedule_shrink_if_due();
           }
           return deleted_count;
         }
@@ -2705,6 +2763,12 @@ namespace boost {
       inline void table<Types>::reserve(std::size_t num_elements)
       {
         std::size_t num_buckets = min_buckets(num_elements, mlf_);
+#if defined(BOOST_UNORDERED_ENABLE_AUTO_SHRINK)
+        if (num_elements > max_load_ && shrink_due()) { // from insertion
+          num_buckets = (std::max)(num_buckets, buckets_for_shrinkage());
+          recalculate_max_load(); // in case rehash leaves the buckets as is
+        }
+#endif
         this->rehash(num_buckets);
       }
 
@@ -2712,8 +2776,13 @@ namespace boost {
       inline void table<Types>::reserve_for_insert(std::size_t num_elements)
       {
         if (num_elements > max_load_) {
-          std::size_t const num_buckets = static_cast<std::size_t>(
+          std::size_t num_buckets = static_cast<std::size_t>(
             1.0f + std::ceil(static_cast<float>(num_elements) / mlf_));
+#if defined(BOOST_UNORDERED_ENABLE_AUTO_SHRINK)
+          if (shrink_due()) {
+            num_buckets = (std::max)(num_buckets, buckets_for_shrinkage());
+          }
+#endif
 
           this->rehash_impl(num_buckets);
         }
@@ -12,6 +12,7 @@
 #define BOOST_UNORDERED_HASH_TRAITS_HPP
 
 #include <boost/unordered/detail/type_traits.hpp>
+#include <cstddef>
 
 namespace boost{
 namespace unordered{
@@ -64,6 +65,24 @@ struct hash_is_avalanching_impl<
 template<typename Hash>
 struct hash_is_avalanching: detail::hash_is_avalanching_impl<Hash>::type{};
 
+/* Hash value of a key exactly as used internally by open-addressing and
+ * concurrent containers (that is, after post-mixing if the hash function is
+ * not avalanching), as returned by their hash_function_mixed(k) member
+ * function. It can then be passed to the lookup and modification overloads
+ * accepting a precomputed_hash to avoid calculating the hash of k again,
+ * as long as the hash function used is the same.
+ */
+class precomputed_hash
+{
+public:
+  explicit precomputed_hash(std::size_t value)noexcept:value_{value}{}
+
+  std::size_t value()const noexcept{return value_;}
+
+private:
+  std::size_t value_;
+};
+
 } /* namespace unordered */
 } /* namespace boost */
 
@@ -0,0 +1,416 @@
+/* Allocator adaptor backing large allocations with huge pages.
+ *
+ * Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/unordered for library home page.
+ */
+
+#ifndef BOOST_UNORDERED_HUGE_PAGE_ALLOCATOR_HPP
+#define BOOST_UNORDERED_HUGE_PAGE_ALLOCATOR_HPP
+
+#include <boost/config.hpp>
+#if defined(BOOST_HAS_PRAGMA_ONCE)
+#pragma once
+#endif
+
+#include <boost/core/allocator_access.hpp>
+#include <boost/core/pointer_traits.hpp>
+#include <boost/throw_exception.hpp>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+#if defined(__linux__)
+#define BOOST_UNORDERED_HUGE_PAGES_LINUX
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace boost{
+namespace unordered{
+
+/* Tuning of huge_page_allocator. Allocations of at least threshold bytes are
+ * aligned to huge_page_size and, on Linux:
+ *   - are requested to be backed by transparent huge pages
+ *     (madvise(MADV_HUGEPAGE)) or, if hugetlb is set, obtained from the
+ *     reserved huge page pool (mmap(MAP_HUGETLB)), falling back to
+ *     transparent huge pages if the pool is exhausted;
+ *   - have their pages distributed according to numa_policy among the NUMA
+ *     nodes in the numa_nodes mask (a bit per node, all nodes by default);
+ *   - if lazy_zero is set, are mapped directly from the OS rather than
+ *     obtained from the upstream allocator, so that they come zeroed and
+ *     are not faulted in until touched (containers then skip initialization
+ *     of their metadata, see allocates_zeroed);
+ *   - if populate is set, are faulted in upfront (MAP_POPULATE or
+ *     MADV_POPULATE_WRITE, page touching otherwise) so that no page faults
+ *     happen later on the hot path.
+ * Hints rejected by the OS are silently ignored.
+ */
+
+struct huge_page_options
+{
+  enum numa_policy_type{numa_default,numa_interleave,numa_bind};
+
+  static constexpr std::size_t huge_page_size=std::size_t(2)<<20;
+
+  std::size_t      threshold=std::size_t(32)<<20;
+  bool             hugetlb=false;
+  numa_policy_type numa_policy=numa_default;
+  unsigned long    numa_nodes=~0ul;
+  bool             lazy_zero=false;
+  bool             populate=false;
+};
+
+namespace detail{
+
+/* Large blocks are followed by a trailer recording how they were obtained:
+ * either mapped directly (base==nullptr, size is the length of the mapping)
+ * or allocated from the upstream allocator (size bytes starting at base).
+ */
+
+struct huge_block_trailer
+{
+  unsigned char* base;
+  std::size_t    size;
+};
+
+inline std::size_t huge_block_round_up(std::size_t n,std::size_t m)
+{
+  return (n+m-1)/m*m;
+}
+
+inline std::size_t huge_block_trailer_offset(std::size_t bytes)
+{
+  return huge_block_round_up(bytes,alignof(huge_block_trailer));
+}
+
+inline void huge_block_set_trailer(
+  unsigned char* p,std::size_t bytes,huge_block_trailer t)
+{
+  std::memcpy(p+huge_block_trailer_offset(bytes),&t,sizeof(t));
+}
+
+inline huge_block_trailer huge_block_get_trailer(
+  unsigned char* p,std::size_t bytes)
+{
+  huge_block_trailer t;
+  std::memcpy(&t,p+huge_block_trailer_offset(bytes),sizeof(t));
+  return t;
+}
+
+inline std::size_t huge_block_span(std::size_t bytes)
+{
+  return huge_block_trailer_offset(bytes)+sizeof(huge_block_trailer);
+}
+
+#if defined(BOOST_UNORDERED_HUGE_PAGES_LINUX)
+inline int huge_block_map_flags(bool populate)noexcept
+{
+#if defined(MAP_POPULATE)
+  if(populate)return MAP_PRIVATE|MAP_ANONYMOUS|MAP_POPULATE;
+#else
+  (void)populate;
+#endif
+  return MAP_PRIVATE|MAP_ANONYMOUS;
+}
+
+inline unsigned char* huge_block_map(std::size_t len,bool populate)noexcept
+{
+#if defined(MAP_HUGETLB)
+  void* p=::mmap(
+    nullptr,len,PROT_READ|PROT_WRITE,
+    huge_block_map_flags(populate)|MAP_HUGETLB,-1,0);
+  if(p!=MAP_FAILED)return static_cast<unsigned char*>(p);
+#else
+  (void)len;
+  (void)populate;
+#endif
+  return nullptr;
+}
+
+/* regular mapping of len bytes aligned to alignment */
+
+inline unsigned char* huge_block_map_aligned(
+  std::size_t len,std::size_t alignment)noexcept
+{
+  void* q=::mmap(
+    nullptr,len+alignment,PROT_READ|PROT_WRITE,
+    huge_block_map_flags(false),-1,0);
+  if(q==MAP_FAILED)return nullptr;
+
+  auto base=static_cast<unsigned char*>(q);
+  auto p=base+
+    (alignment-reinterpret_cast<std::uintptr_t>(base)%alignment)%alignment;
+  if(p!=base)::munmap(base,static_cast<std::size_t>(p-base));
+  ::munmap(p+len,static_cast<std::size_t>(base+len+alignment-(p+len)));
+  return p;
+}
+
+inline void huge_block_unmap(unsigned char* p,std::size_t len)noexcept
+{
+  ::munmap(p,len);
+}
+#endif
+
+/* Applies huge page and NUMA hints to the not yet touched [p,p+bytes),
+ * p aligned to huge_page_size.
+ */
+
+inline void huge_block_advise(
+  unsigned char* p,std::size_t bytes,const huge_page_options& opts,
+  bool hugetlb)noexcept
+{
+#if defined(BOOST_UNORDERED_HUGE_PAGES_LINUX)
+  std::size_t page_size=static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+  std::size_t len=bytes/page_size*page_size; /* don't go past the block */
+
+#if defined(MADV_HUGEPAGE)
+  if(!hugetlb){
+    ::madvise(
+      p,bytes/huge_page_options::huge_page_size*
+        huge_page_options::huge_page_size,
+      MADV_HUGEPAGE);
+  }
+#else
+  (void)hugetlb;
+#endif
+
+#if defined(SYS_mbind)
+  if(opts.numa_policy!=huge_page_options::numa_default&&len){
+    /* <numaif.h> values, the header may not be available */
+    static constexpr int mpol_bind=2,
+                         mpol_interleave=3;
+
+    unsigned long nodes=opts.numa_nodes;
+    ::syscall(
+      SYS_mbind,p,len,
+      opts.numa_policy==huge_page_options::numa_interleave?
+        mpol_interleave:mpol_bind,
+      &nodes,sizeof(nodes)*CHAR_BIT+1,0u);
+  }
+#else
+  (void)len;
+  (void)opts;
+#endif
+#else
+  (void)p;
+  (void)bytes;
+  (void)opts;
+  (void)hugetlb;
+#endif
+}
+
+/* Faults in [p,p+bytes), p aligned to huge_page_size. Writing is fine as
+ * contents are not initialized yet.
+ */
+
+inline void huge_block_populate(unsigned char* p,std::size_t bytes)noexcept
+{
+  std::size_t page_size=4096,
+              i=0;
+
+#if defined(BOOST_UNORDERED_HUGE_PAGES_LINUX)
+  /* MADV_POPULATE_WRITE (Linux 5.14), the header may not know of it */
+  static constexpr int madv_populate_write=23;
+
+  page_size=static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+  std::size_t len=bytes/page_size*page_size;
+  if(len&&::madvise(p,len,madv_populate_write)==0)i=len;
+#endif
+
+  for(;i<bytes;i+=page_size)static_cast<volatile unsigned char*>(p)[i]=0;
+}
+
+template<typename CharAllocator>
+unsigned char* huge_block_allocate(
+  CharAllocator& al,std::size_t bytes,const huge_page_options& opts)
+{
+  static constexpr std::size_t huge_page_size=
+    huge_page_options::huge_page_size;
+
+#if defined(BOOST_UNORDERED_HUGE_PAGES_LINUX)
+  if(opts.hugetlb){
+    std::size_t len=huge_block_round_up(
+      huge_block_span(bytes),huge_page_size);
+    if(auto p=huge_block_map(len,opts.populate)){
+      huge_block_set_trailer(p,bytes,{nullptr,len});
+      huge_block_advise(p,bytes,opts,true);
+      return p;
+    }
+  }
+  if(opts.lazy_zero){
+    std::size_t len=huge_block_span(bytes);
+    auto        p=huge_block_map_aligned(len,huge_page_size);
+    if(!p)boost::throw_exception(std::bad_alloc());
+    huge_block_set_trailer(p,bytes,{nullptr,len});
+    huge_block_advise(p,bytes,opts,false);
+    if(opts.populate)huge_block_populate(p,bytes);
+    return p;
+  }
+#endif
+
+  /* over-allocate so as to align to huge_page_size */
+  std::size_t size=huge_block_span(bytes)+huge_page_size-1;
+  unsigned char* base=boost::to_address(boost::allocator_allocate(al,size));
+  unsigned char* p=base+
+    (huge_page_size-reinterpret_cast<std::uintptr_t>(base)%huge_page_size)%
+    huge_page_size;
+  huge_block_set_trailer(p,bytes,{base,size});
+  huge_block_advise(p,bytes,opts,false);
+  if(opts.populate)huge_block_populate(p,bytes);
+  return p;
+}
+
+template<typename CharAllocator>
+void huge_block_deallocate(
+  CharAllocator& al,unsigned char* p,std::size_t bytes)noexcept
+{
+  using pointer=typename boost::allocator_pointer<CharAllocator>::type;
+
+  auto t=huge_block_get_trailer(p,bytes);
+  if(!t.base){
+#if defined(BOOST_UNORDERED_HUGE_PAGES_LINUX)
+    huge_block_unmap(p,t.size);
+#endif
+  }
+  else{
+    boost::allocator_deallocate(
+      al,boost::pointer_traits<pointer>::pointer_to(*t.base),t.size);
+  }
+}
+
+} /* namespace detail */
+
+/* Adaptor over Allocator serving allocations of at least opts.threshold
+ * bytes as blocks aligned to a huge page boundary with the huge page and
+ * NUMA hints of huge_page_options. Smaller allocations are forwarded to
+ * Allocator unchanged, as is the allocation of the underlying storage of
+ * large blocks unless taken from the hugetlb pool, so this can be layered
+ * over std::pmr::polymorphic_allocator and other custom allocators.
+ * Intended for the bucket arrays of large containers, whose allocation is
+ * the only one reaching the threshold in practice.
+ */
+
+template<typename T,typename Allocator=std::allocator<T>>
+class huge_page_allocator
+{
+  using upstream_type=
+    typename boost::allocator_rebind<Allocator,T>::type;
+  using char_allocator_type=
+    typename boost::allocator_rebind<Allocator,unsigned char>::type;
+  using upstream_pointer=
+    typename boost::allocator_pointer<upstream_type>::type;
+
+  template<typename,typename> friend class huge_page_allocator;
+
+public:
+  using value_type=T;
+  using upstream_allocator_type=upstream_type;
+  using propagate_on_container_copy_assignment=typename boost::
+    allocator_propagate_on_container_copy_assignment<upstream_type>::type;
+  using propagate_on_container_move_assignment=typename boost::
+    allocator_propagate_on_container_move_assignment<upstream_type>::type;
+  using propagate_on_container_swap=typename boost::
+    allocator_propagate_on_container_swap<upstream_type>::type;
+
+  template<typename U>
+  struct rebind
+  {
+    using other=huge_page_allocator<
+      U,typename boost::allocator_rebind<Allocator,U>::type>;
+  };
+
+  huge_page_allocator()=default;
+
+  explicit huge_page_allocator(
+    const huge_page_options& opts,const upstream_type& al=upstream_type()):
+    opts_(opts),al_(al){}
+
+  template<typename U,typename Allocator2>
+  huge_page_allocator(const huge_page_allocator<U,Allocator2>& x)noexcept:
+    opts_(x.opts_),al_(x.al_){}
+
+  huge_page_allocator select_on_container_copy_construction()const
+  {
+    return huge_page_allocator{
+      opts_,boost::allocator_select_on_container_copy_construction(al_)};
+  }
+
+  const huge_page_options& options()const noexcept{return opts_;}
+  upstream_allocator_type upstream()const noexcept{return al_;}
+
+  /* Whether allocate(n) returns zeroed memory. Open-addressing and
+   * concurrent containers skip the initialization of the metadata of their
+   * bucket array in this case.
+   */
+
+  bool allocates_zeroed(std::size_t n)const noexcept
+  {
+#if defined(BOOST_UNORDERED_HUGE_PAGES_LINUX)
+    return opts_.lazy_zero&&is_large(n);
+#else
+    (void)n;
+    return false;
+#endif
+  }
+
+  T* allocate(std::size_t n)
+  {
+    if(!is_large(n))return boost::to_address(boost::allocator_allocate(al_,n));
+
+    char_allocator_type cal(al_);
+    return reinterpret_cast<T*>(
+      detail::huge_block_allocate(cal,n*sizeof(T),opts_));
+  }
+
+  void deallocate(T* p,std::size_t n)noexcept
+  {
+    if(!is_large(n)){
+      boost::allocator_deallocate(
+        al_,boost::pointer_traits<upstream_pointer>::pointer_to(*p),n);
+      return;
+    }
+
+    char_allocator_type cal(al_);
+    detail::huge_block_deallocate(
+      cal,reinterpret_cast<unsigned char*>(p),n*sizeof(T));
+  }
+
+  template<typename U,typename Allocator2>
+  bool operator==(const huge_page_allocator<U,Allocator2>& x)const noexcept
+  {
+    return opts_.threshold==x.opts_.threshold&&al_==x.al_;
+  }
+
+  template<typename U,typename Allocator2>
+  bool operator!=(const huge_page_allocator<U,Allocator2>& x)const noexcept
+  {
+    return !(*this==x);
+  }
+
+private:
+  bool is_large(std::size_t n)const noexcept
+  {
+    return n>=(opts_.threshold+sizeof(T)-1)/sizeof(T);
+  }
+
+  huge_page_options opts_;
+  upstream_type     al_;
+};
+
+} /* namespace unordered */
+
+using unordered::huge_page_allocator;
+using unordered::huge_page_options;
+
+} /* namespace boost */
+
+#endif
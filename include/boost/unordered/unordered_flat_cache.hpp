@@ -0,0 +1,258 @@
+// Copyright (C) 2025 Joaquin M Lopez Munoz
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_UNORDERED_UNORDERED_FLAT_CACHE_HPP_INCLUDED
+#define BOOST_UNORDERED_UNORDERED_FLAT_CACHE_HPP_INCLUDED
+
+#include <boost/config.hpp>
+#if defined(BOOST_HAS_PRAGMA_ONCE)
+#pragma once
+#endif
+
+#include <boost/unordered/detail/foa/cache_table.hpp>
+#include <boost/unordered/detail/foa/flat_map_types.hpp>
+#include <boost/unordered/detail/type_traits.hpp>
+#include <boost/unordered/unordered_flat_cache_fwd.hpp>
+
+#include <boost/core/allocator_access.hpp>
+#include <boost/container_hash/hash.hpp>
+
+#include <type_traits>
+#include <utility>
+
+namespace boost {
+  namespace unordered {
+
+#if defined(BOOST_MSVC)
+#pragma warning(push)
+#pragma warning(disable : 4714) /* marked as __forceinline not inlined */
+#endif
+
+    template <class Key, class T, class Hash, class KeyEqual, class Allocator>
+    class unordered_flat_cache
+    {
+      using map_types = detail::foa::flat_map_types<Key, T>;
+
+      using table_type = detail::foa::cache_table<map_types, Hash, KeyEqual,
+        typename boost::allocator_rebind<Allocator,
+          typename map_types::value_type>::type>;
+
+      table_type table_;
+      cache_eviction policy_;
+
+      /* marks set on lookup and insertion, see cache_table */
+
+      static unsigned char hit_mark(cache_eviction p) noexcept
+      {
+        return p == cache_eviction::lru ? 3 : 1;
+      }
+
+      static unsigned char insert_mark(cache_eviction p) noexcept
+      {
+        return p == cache_eviction::sieve ? 0 : 1;
+      }
+
+    public:
+      using key_type = Key;
+      using mapped_type = T;
+      using value_type = typename map_types::value_type;
+      using init_type = typename map_types::init_type;
+      using size_type = std::size_t;
+      using difference_type = std::ptrdiff_t;
+      using hasher = typename boost::unordered::detail::type_identity<Hash>::type;
+      using key_equal = typename boost::unordered::detail::type_identity<KeyEqual>::type;
+      using allocator_type = typename boost::unordered::detail::type_identity<Allocator>::type;
+      using reference = value_type&;
+      using const_reference = value_type const&;
+      using pointer = typename boost::allocator_pointer<allocator_type>::type;
+      using const_pointer =
+        typename boost::allocator_const_pointer<allocator_type>::type;
+      using iterator = typename table_type::iterator;
+      using const_iterator = typename table_type::const_iterator;
+
+      explicit unordered_flat_cache(size_type capacity,
+        cache_eviction policy = cache_eviction::clock,
+        hasher const& h = hasher(), key_equal const& pred = key_equal(),
+        allocator_type const& a = allocator_type())
+          : table_(capacity, hit_mark(policy), insert_mark(policy), h, pred,
+              a),
+            policy_(policy)
+      {
+      }
+
+      unordered_flat_cache(size_type capacity, allocator_type const& a)
+          : unordered_flat_cache(
+              capacity, cache_eviction::clock, hasher(), key_equal(), a)
+      {
+      }
+
+      unordered_flat_cache(unordered_flat_cache const&) = delete;
+      unordered_flat_cache& operator=(unordered_flat_cache const&) = delete;
+
+      ~unordered_flat_cache() = default;
+
+      allocator_type get_allocator() const noexcept
+      {
+        return table_.get_allocator();
+      }
+
+      /// Iterators
+      ///
+
+      iterator begin() noexcept { return table_.begin(); }
+      const_iterator begin() const noexcept { return table_.begin(); }
+      const_iterator cbegin() const noexcept { return table_.cbegin(); }
+
+      iterator end() noexcept { return table_.end(); }
+      const_iterator end() const noexcept { return table_.end(); }
+      const_iterator cend() const noexcept { return table_.cend(); }
+
+      /// Capacity
+      ///
+
+      BOOST_ATTRIBUTE_NODISCARD bool empty() const noexcept
+      {
+        return table_.empty();
+      }
+
+      size_type size() const noexcept { return table_.size(); }
+
+      size_type capacity() const noexcept { return table_.capacity(); }
+
+      cache_eviction policy() const noexcept { return policy_; }
+
+      /// Lookup
+      ///
+
+      BOOST_FORCEINLINE iterator find(key_type const& key)
+      {
+        return table_.find(key);
+      }
+
+      BOOST_FORCEINLINE const_iterator find(key_type const& key) const
+      {
+        return table_.find(key);
+      }
+
+      template <class K>
+      BOOST_FORCEINLINE typename std::enable_if<
+        boost::unordered::detail::are_transparent<K, hasher, key_equal>::value,
+        iterator>::type
+      find(K const& key)
+      {
+        return table_.find(key);
+      }
+
+      template <class K>
+      BOOST_FORCEINLINE typename std::enable_if<
+        boost::unordered::detail::are_transparent<K, hasher, key_equal>::value,
+        const_iterator>::type
+      find(K const& key) const
+      {
+        return table_.find(key);
+      }
+
+      BOOST_FORCEINLINE size_type count(key_type const& key) const
+      {
+        return table_.count(key);
+      }
+
+      template <class K>
+      BOOST_FORCEINLINE typename std::enable_if<
+        detail::are_transparent<K, hasher, key_equal>::value, size_type>::type
+      count(K const& key) const
+      {
+        return table_.count(key);
+      }
+
+      BOOST_FORCEINLINE bool contains(key_type const& key) const
+      {
+        return table_.contains(key);
+      }
+
+      template <class K>
+      BOOST_FORCEINLINE typename std::enable_if<
+        detail::are_transparent<K, hasher, key_equal>::value, bool>::type
+      contains(K const& key) const
+      {
+        return table_.contains(key);
+      }
+
+      /// Modifiers
+      ///
+
+      BOOST_FORCEINLINE std::pair<iterator, bool> insert(init_type const& value)
+      {
+        return table_.insert(value);
+      }
+
+      BOOST_FORCEINLINE std::pair<iterator, bool> insert(init_type&& value)
+      {
+        return table_.insert(std::move(value));
+      }
+
+      template <class... Args>
+      BOOST_FORCEINLINE std::pair<iterator, bool> try_emplace(
+        key_type const& key, Args&&... args)
+      {
+        return table_.try_emplace(key, std::forward<Args>(args)...);
+      }
+
+      template <class... Args>
+      BOOST_FORCEINLINE std::pair<iterator, bool> try_emplace(
+        key_type&& key, Args&&... args)
+      {
+        return table_.try_emplace(std::move(key), std::forward<Args>(args)...);
+      }
+
+      template <class M>
+      BOOST_FORCEINLINE std::pair<iterator, bool> insert_or_assign(
+        key_type const& key, M&& obj)
+      {
+        return table_.insert_or_assign(key, std::forward<M>(obj));
+      }
+
+      template <class M>
+      BOOST_FORCEINLINE std::pair<iterator, bool> insert_or_assign(
+        key_type&& key, M&& obj)
+      {
+        return table_.insert_or_assign(std::move(key), std::forward<M>(obj));
+      }
+
+      BOOST_FORCEINLINE void erase(iterator pos) { table_.erase(pos); }
+
+      BOOST_FORCEINLINE void erase(const_iterator pos) { table_.erase(pos); }
+
+      BOOST_FORCEINLINE size_type erase(key_type const& key)
+      {
+        return table_.erase(key);
+      }
+
+      template <class K>
+      BOOST_FORCEINLINE typename std::enable_if<
+        detail::transparent_non_iterable<K, unordered_flat_cache>::value,
+        size_type>::type
+      erase(K const& key)
+      {
+        return table_.erase(key);
+      }
+
+      void clear() noexcept { table_.clear(); }
+
+      /// Observers
+      ///
+
+      hasher hash_function() const { return table_.hash_function(); }
+
+      key_equal key_eq() const { return table_.key_eq(); }
+    };
+
+#if defined(BOOST_MSVC)
+#pragma warning(pop) /* C4714 */
+#endif
+
+  } // namespace unordered
+} // namespace boost
+
+#endif
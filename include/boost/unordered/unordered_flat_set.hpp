@@ -12,6 +12,7 @@
 #endif
 
 #include <boost/unordered/concurrent_flat_set_fwd.hpp>
+#include <boost/unordered/detail/concurrent_static_asserts.hpp>
 #include <boost/unordered/detail/foa/flat_set_types.hpp>
 #include <boost/unordered/detail/foa/table.hpp>
 #include <boost/unordered/detail/serialize_container.hpp>
@@ -72,6 +73,7 @@ namespace boost {
         typename boost::allocator_const_pointer<allocator_type>::type;
       using iterator = typename table_type::iterator;
       using const_iterator = typename table_type::const_iterator;
+      static constexpr size_type bulk_visit_size = table_type::bulk_visit_size;
 
 #if defined(BOOST_UNORDERED_ENABLE_STATS)
       using stats = typename table_type::stats;
@@ -281,9 +283,7 @@ namespace boost {
       template <class InputIterator>
       void insert(InputIterator first, InputIterator last)
       {
-        for (auto pos = first; pos != last; ++pos) {
-          table_.emplace(*pos);
-        }
+        table_.insert_bulk(first, last);
       }
 
       void insert(std::initializer_list<value_type> ilist)
@@ -317,6 +317,13 @@ namespace boost {
         return iterator{detail::foa::const_iterator_cast_tag{}, last};
       }
 
+      template <class FwdIterator>
+      size_type erase_bulk(FwdIterator first, FwdIterator last)
+      {
+        BOOST_UNORDERED_STATIC_ASSERT_BULK_VISIT_ITERATOR(FwdIterator)
+        return table_.erase_bulk(first, last);
+      }
+
       BOOST_FORCEINLINE size_type erase(key_type const& key)
       {
         return table_.erase(key);
@@ -331,6 +338,20 @@ namespace boost {
         return table_.erase(key);
       }
 
+      BOOST_FORCEINLINE size_type erase(
+        key_type const& key, precomputed_hash hash)
+      {
+        return table_.erase(key, hash);
+      }
+
+      template <class K>
+      BOOST_FORCEINLINE typename std::enable_if<
+        detail::are_transparent<K, hasher, key_equal>::value, size_type>::type
+      erase(K const& key, precomputed_hash hash)
+      {
+        return table_.erase(key, hash);
+      }
+
       void swap(unordered_flat_set& rhs) noexcept(
         noexcept(std::declval<table_type&>().swap(std::declval<table_type&>())))
       {
@@ -395,6 +416,36 @@ namespace boost {
         return table_.find(key);
       }
 
+      BOOST_FORCEINLINE iterator find(
+        key_type const& key, precomputed_hash hash)
+      {
+        return table_.find(key, hash);
+      }
+
+      BOOST_FORCEINLINE const_iterator find(
+        key_type const& key, precomputed_hash hash) const
+      {
+        return table_.find(key, hash);
+      }
+
+      template <class K>
+      BOOST_FORCEINLINE typename std::enable_if<
+        boost::unordered::detail::are_transparent<K, hasher, key_equal>::value,
+        iterator>::type
+      find(K const& key, precomputed_hash hash)
+      {
+        return table_.find(key, hash);
+      }
+
+      template <class K>
+      BOOST_FORCEINLINE typename std::enable_if<
+        boost::unordered::detail::are_transparent<K, hasher, key_equal>::value,
+        const_iterator>::type
+      find(K const& key, precomputed_hash hash) const
+      {
+        return table_.find(key, hash);
+      }
+
       BOOST_FORCEINLINE bool contains(key_type const& key) const
       {
         return this->find(key) != this->end();
@@ -409,6 +460,57 @@ namespace boost {
         return this->find(key) != this->end();
       }
 
+      template <class FwdIterator, class OutputIterator>
+      BOOST_FORCEINLINE OutputIterator find(
+        FwdIterator first, FwdIterator last, OutputIterator out)
+      {
+        BOOST_UNORDERED_STATIC_ASSERT_BULK_VISIT_ITERATOR(FwdIterator)
+        return table_.find(first, last, out);
+      }
+
+      template <class FwdIterator, class OutputIterator>
+      BOOST_FORCEINLINE OutputIterator find(
+        FwdIterator first, FwdIterator last, OutputIterator out) const
+      {
+        BOOST_UNORDERED_STATIC_ASSERT_BULK_VISIT_ITERATOR(FwdIterator)
+        return table_.find(first, last, out);
+      }
+
+      template <class FwdIterator, class OutputIterator>
+      BOOST_FORCEINLINE OutputIterator contains(
+        FwdIterator first, FwdIterator last, OutputIterator out) const
+      {
+        BOOST_UNORDERED_STATIC_ASSERT_BULK_VISIT_ITERATOR(FwdIterator)
+        return table_.contains(first, last, out);
+      }
+
+      template <class FwdIterator, class F>
+      BOOST_FORCEINLINE size_type visit(
+        FwdIterator first, FwdIterator last, F f)
+      {
+        BOOST_UNORDERED_STATIC_ASSERT_BULK_VISIT_ITERATOR(FwdIterator)
+        BOOST_UNORDERED_STATIC_ASSERT_CONST_INVOCABLE(F)
+        return table_.visit(first, last, f);
+      }
+
+      template <class FwdIterator, class F>
+      BOOST_FORCEINLINE size_type visit(
+        FwdIterator first, FwdIterator last, F f) const
+      {
+        BOOST_UNORDERED_STATIC_ASSERT_BULK_VISIT_ITERATOR(FwdIterator)
+        BOOST_UNORDERED_STATIC_ASSERT_CONST_INVOCABLE(F)
+        return table_.visit(first, last, f);
+      }
+
+      template <class FwdIterator, class F>
+      BOOST_FORCEINLINE size_type cvisit(
+        FwdIterator first, FwdIterator last, F f) const
+      {
+        BOOST_UNORDERED_STATIC_ASSERT_BULK_VISIT_ITERATOR(FwdIterator)
+        BOOST_UNORDERED_STATIC_ASSERT_CONST_INVOCABLE(F)
+        return table_.visit(first, last, f);
+      }
+
       std::pair<iterator, iterator> equal_range(key_type const& key)
       {
         auto pos = table_.find(key);
@@ -500,6 +602,20 @@ namespace boost {
       hasher hash_function() const { return table_.hash_function(); }
 
       key_equal key_eq() const { return table_.key_eq(); }
+
+      precomputed_hash hash_function_mixed(key_type const& key) const
+      {
+        return table_.hash_function_mixed(key);
+      }
+
+      template <class K>
+      typename std::enable_if<
+        detail::are_transparent<K, hasher, key_equal>::value,
+        precomputed_hash>::type
+      hash_function_mixed(K const& key) const
+      {
+        return table_.hash_function_mixed(key);
+      }
     };
 
     template <class Key, class Hash, class KeyEqual, class Allocator>
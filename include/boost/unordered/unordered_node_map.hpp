@@ -12,6 +12,7 @@
 #endif
 
 #include <boost/unordered/concurrent_node_map_fwd.hpp>
+#include <boost/unordered/detail/concurrent_static_asserts.hpp>
 #include <boost/unordered/detail/foa/node_map_handle.hpp>
 #include <boost/unordered/detail/foa/node_map_types.hpp>
 #include <boost/unordered/detail/foa/table.hpp>
@@ -78,6 +79,7 @@ namespace boost {
         typename boost::allocator_const_pointer<allocator_type>::type;
       using iterator = typename table_type::iterator;
       using const_iterator = typename table_type::const_iterator;
+      static constexpr size_type bulk_visit_size = table_type::bulk_visit_size;
       using node_type = detail::foa::node_map_handle<map_types,
         typename boost::allocator_rebind<Allocator,
           typename map_types::value_type>::type>;
@@ -277,9 +279,7 @@ namespace boost {
       template <class InputIterator>
       BOOST_FORCEINLINE void insert(InputIterator first, InputIterator last)
       {
-        for (auto pos = first; pos != last; ++pos) {
-          table_.emplace(*pos);
-        }
+        table_.insert_bulk(first, last);
       }
 
       void insert(std::initializer_list<value_type> ilist)
@@ -421,6 +421,32 @@ namespace boost {
           std::forward<K>(key), std::forward<Args>(args)...);
       }
 
+      template <class... Args>
+      BOOST_FORCEINLINE std::pair<iterator, bool> try_emplace(
+        key_type const& key, precomputed_hash hash, Args&&... args)
+      {
+        return table_.try_emplace(key, hash, std::forward<Args>(args)...);
+      }
+
+      template <class... Args>
+      BOOST_FORCEINLINE std::pair<iterator, bool> try_emplace(
+        key_type&& key, precomputed_hash hash, Args&&... args)
+      {
+        return table_.try_emplace(
+          std::move(key), hash, std::forward<Args>(args)...);
+      }
+
+      template <class K, class... Args>
+      BOOST_FORCEINLINE typename std::enable_if<
+        boost::unordered::detail::transparent_non_iterable<K,
+          unordered_node_map>::value,
+        std::pair<iterator, bool> >::type
+      try_emplace(K&& key, precomputed_hash hash, Args&&... args)
+      {
+        return table_.try_emplace(
+          std::forward<K>(key), hash, std::forward<Args>(args)...);
+      }
+
       template <class... Args>
       BOOST_FORCEINLINE iterator try_emplace(
         const_iterator, key_type const& key, Args&&... args)
@@ -468,6 +494,13 @@ namespace boost {
         return iterator{detail::foa::const_iterator_cast_tag{}, last};
       }
 
+      template <class FwdIterator>
+      size_type erase_bulk(FwdIterator first, FwdIterator last)
+      {
+        BOOST_UNORDERED_STATIC_ASSERT_BULK_VISIT_ITERATOR(FwdIterator)
+        return table_.erase_bulk(first, last);
+      }
+
       BOOST_FORCEINLINE size_type erase(key_type const& key)
       {
         return table_.erase(key);
@@ -482,6 +515,20 @@ namespace boost {
         return table_.erase(key);
       }
 
+      BOOST_FORCEINLINE size_type erase(
+        key_type const& key, precomputed_hash hash)
+      {
+        return table_.erase(key, hash);
+      }
+
+      template <class K>
+      BOOST_FORCEINLINE typename std::enable_if<
+        detail::are_transparent<K, hasher, key_equal>::value, size_type>::type
+      erase(K const& key, precomputed_hash hash)
+      {
+        return table_.erase(key, hash);
+      }
+
       void swap(unordered_node_map& rhs) noexcept(
         noexcept(std::declval<table_type&>().swap(std::declval<table_type&>())))
       {
@@ -649,6 +696,36 @@ namespace boost {
         return table_.find(key);
       }
 
+      BOOST_FORCEINLINE iterator find(
+        key_type const& key, precomputed_hash hash)
+      {
+        return table_.find(key, hash);
+      }
+
+      BOOST_FORCEINLINE const_iterator find(
+        key_type const& key, precomputed_hash hash) const
+      {
+        return table_.find(key, hash);
+      }
+
+      template <class K>
+      BOOST_FORCEINLINE typename std::enable_if<
+        boost::unordered::detail::are_transparent<K, hasher, key_equal>::value,
+        iterator>::type
+      find(K const& key, precomputed_hash hash)
+      {
+        return table_.find(key, hash);
+      }
+
+      template <class K>
+      BOOST_FORCEINLINE typename std::enable_if<
+        boost::unordered::detail::are_transparent<K, hasher, key_equal>::value,
+        const_iterator>::type
+      find(K const& key, precomputed_hash hash) const
+      {
+        return table_.find(key, hash);
+      }
+
       BOOST_FORCEINLINE bool contains(key_type const& key) const
       {
         return this->find(key) != this->end();
@@ -663,6 +740,57 @@ namespace boost {
         return this->find(key) != this->end();
       }
 
+      template <class FwdIterator, class OutputIterator>
+      BOOST_FORCEINLINE OutputIterator find(
+        FwdIterator first, FwdIterator last, OutputIterator out)
+      {
+        BOOST_UNORDERED_STATIC_ASSERT_BULK_VISIT_ITERATOR(FwdIterator)
+        return table_.find(first, last, out);
+      }
+
+      template <class FwdIterator, class OutputIterator>
+      BOOST_FORCEINLINE OutputIterator find(
+        FwdIterator first, FwdIterator last, OutputIterator out) const
+      {
+        BOOST_UNORDERED_STATIC_ASSERT_BULK_VISIT_ITERATOR(FwdIterator)
+        return table_.find(first, last, out);
+      }
+
+      template <class FwdIterator, class OutputIterator>
+      BOOST_FORCEINLINE OutputIterator contains(
+        FwdIterator first, FwdIterator last, OutputIterator out) const
+      {
+        BOOST_UNORDERED_STATIC_ASSERT_BULK_VISIT_ITERATOR(FwdIterator)
+        return table_.contains(first, last, out);
+      }
+
+      template <class FwdIterator, class F>
+      BOOST_FORCEINLINE size_type visit(
+        FwdIterator first, FwdIterator last, F f)
+      {
+        BOOST_UNORDERED_STATIC_ASSERT_BULK_VISIT_ITERATOR(FwdIterator)
+        BOOST_UNORDERED_STATIC_ASSERT_INVOCABLE(F)
+        return table_.visit(first, last, f);
+      }
+
+      template <class FwdIterator, class F>
+      BOOST_FORCEINLINE size_type visit(
+        FwdIterator first, FwdIterator last, F f) const
+      {
+        BOOST_UNORDERED_STATIC_ASSERT_BULK_VISIT_ITERATOR(FwdIterator)
+        BOOST_UNORDERED_STATIC_ASSERT_CONST_INVOCABLE(F)
+        return table_.visit(first, last, f);
+      }
+
+      template <class FwdIterator, class F>
+      BOOST_FORCEINLINE size_type cvisit(
+        FwdIterator first, FwdIterator last, F f) const
+      {
+        BOOST_UNORDERED_STATIC_ASSERT_BULK_VISIT_ITERATOR(FwdIterator)
+        BOOST_UNORDERED_STATIC_ASSERT_CONST_INVOCABLE(F)
+        return table_.visit(first, last, f);
+      }
+
       std::pair<iterator, iterator> equal_range(key_type const& key)
       {
         auto pos = table_.find(key);
@@ -754,6 +882,20 @@ namespace boost {
       hasher hash_function() const { return table_.hash_function(); }
 
       key_equal key_eq() const { return table_.key_eq(); }
+
+      precomputed_hash hash_function_mixed(key_type const& key) const
+      {
+        return table_.hash_function_mixed(key);
+      }
+
+      template <class K>
+      typename std::enable_if<
+        detail::are_transparent<K, hasher, key_equal>::value,
+        precomputed_hash>::type
+      hash_function_mixed(K const& key) const
+      {
+        return table_.hash_function_mixed(key);
+      }
     };
 
     template <class Key, class T, class Hash, class KeyEqual, class Allocator>
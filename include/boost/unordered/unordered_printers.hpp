@@ -126,7 +126,7 @@ __asm__(".pushsection \".debug_gdb_scripts\", \"MS\",@progbits,1\n"
 
         ".ascii \"    def children(self):\\n\"\n"
         ".ascii \"        def generator():\\n\"\n"
-        ".ascii \"            members = [\\\"insertion\\\", \\\"successful_lookup\\\", \\\"unsuccessful_lookup\\\"]\\n\"\n"
+        ".ascii \"            members = [\\\"insertion\\\", \\\"successful_lookup\\\", \\\"unsuccessful_lookup\\\", \\\"rehash\\\", \\\"in_place_rehash\\\", \\\"shrink\\\"]\\n\"\n"
         ".ascii \"            for member in members:\\n\"\n"
         ".ascii \"                yield \\\"\\\", member\\n\"\n"
         ".ascii \"                yield \\\"\\\", self.val[member]\\n\"\n"
@@ -0,0 +1,155 @@
+// Copyright 2025 Joaquin M Lopez Munoz.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "helpers.hpp"
+
+#include <boost/unordered/concurrent_flat_map.hpp>
+#include <boost/unordered/concurrent_flat_set.hpp>
+#include <boost/unordered/concurrent_node_map.hpp>
+#include <boost/unordered/concurrent_node_set.hpp>
+
+#include <atomic>
+#include <iterator>
+#include <list>
+#include <sstream>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Range insertion from forward ranges of value_type or init_type objects is
+// done in bulk (elements hashed and prefetched in chunks, container locked
+// once per call unless growth is needed). Results must be the same as with
+// element-by-element insertion.
+
+namespace {
+  int key_of(int x) { return x; }
+  template <class T> int key_of(std::pair<T, int> const& x) { return x.first; }
+
+  int make_value(int x, int const*) { return x; }
+  template <class T> T make_value(int x, T const*) { return T(x, x); }
+
+  template <class X, class Range> void test_concurrent(Range const& r)
+  {
+    // all threads insert the whole range, so there are as many insertion
+    // visits as distinct elements and the rest are visits to existing ones
+
+    using value_type = typename X::value_type;
+
+    X x;
+    std::atomic<std::size_t> processed{0}, inserted{0}, visited{0};
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < num_threads; ++t) {
+      threads.emplace_back([&, t] {
+        auto on_insert = [&](value_type const&) { ++inserted; };
+        auto on_existing = [&](value_type const&) { ++visited; };
+        if (t % 2) {
+          processed +=
+            x.insert_and_cvisit(r.begin(), r.end(), on_insert, on_existing);
+        } else {
+          processed +=
+            x.insert_and_visit(r.begin(), r.end(), on_insert, on_existing);
+        }
+      });
+    }
+    for (auto& th : threads) {
+      th.join();
+    }
+
+    std::size_t const n = static_cast<std::size_t>(
+      std::distance(r.begin(), r.end()));
+    BOOST_TEST_EQ(processed.load(), num_threads * n);
+    BOOST_TEST_EQ(inserted.load(), x.size());
+    BOOST_TEST_EQ(inserted.load() + visited.load(), num_threads * n);
+    for (auto const& v : r) {
+      BOOST_TEST_EQ(x.count(key_of(v)), 1u);
+    }
+  }
+
+  template <class X, class Range> void test_equivalence(Range const& r)
+  {
+    // bulk and element-by-element insertion produce the same result
+
+    using value_type = typename X::value_type;
+
+    X x1, x2;
+    std::size_t visits1 = 0, visits2 = 0;
+    BOOST_TEST_EQ(x1.insert(r.begin(), r.end()),
+      static_cast<std::size_t>(std::distance(r.begin(), r.end())));
+    x1.insert_or_visit(
+      r.begin(), r.end(), [&](value_type const&) { ++visits1; });
+    x1.insert_or_cvisit(
+      r.begin(), r.end(), [&](value_type const&) { ++visits1; });
+    for (auto const& v : r) {
+      x2.insert(v);
+    }
+    for (auto const& v : r) {
+      x2.insert_or_cvisit(v, [&](value_type const&) { ++visits2; });
+      x2.insert_or_cvisit(v, [&](value_type const&) { ++visits2; });
+    }
+    BOOST_TEST(x1 == x2);
+    BOOST_TEST_EQ(visits1, visits2);
+  }
+
+  template <class X> void test_input_iterator(std::vector<int> const& v)
+  {
+    // input ranges are inserted element by element
+
+    std::stringstream ss;
+    for (int k : v) {
+      ss << k << " ";
+    }
+    X x1, x2;
+    std::istream_iterator<int> first(ss), last;
+    BOOST_TEST_EQ(x1.insert(first, last), v.size());
+    x2.insert(v.begin(), v.end());
+    BOOST_TEST(x1 == x2);
+  }
+
+  template <class Value> std::vector<Value> make_range(int n)
+  {
+    // large enough to grow the container several times, with duplicates
+    std::vector<Value> v;
+    for (int i = 0; i < n; ++i) {
+      v.push_back(make_value(i, static_cast<Value const*>(nullptr)));
+      if (i % 3 == 0) {
+        v.push_back(make_value(i / 2, static_cast<Value const*>(nullptr)));
+      }
+    }
+    return v;
+  }
+} // namespace
+
+UNORDERED_AUTO_TEST (bulk_insert) {
+  using flat_map = boost::concurrent_flat_map<int, int>;
+  using node_map = boost::concurrent_node_map<int, int>;
+  using flat_set = boost::concurrent_flat_set<int>;
+  using node_set = boost::concurrent_node_set<int>;
+
+  int const n = 20000;
+  auto values = make_range<std::pair<int const, int> >(n);
+  auto inits = make_range<std::pair<int, int> >(n);
+  auto keys = make_range<int>(n);
+  std::list<int> key_list(keys.begin(), keys.end());
+
+  test_concurrent<flat_map>(values);
+  test_concurrent<flat_map>(inits);
+  test_concurrent<node_map>(values);
+  test_concurrent<node_map>(inits);
+  test_concurrent<flat_set>(keys);
+  test_concurrent<flat_set>(key_list);
+  test_concurrent<node_set>(keys);
+  test_concurrent<node_set>(key_list);
+
+  test_concurrent<flat_map>(std::vector<std::pair<int, int> >());
+
+  test_equivalence<flat_map>(values);
+  test_equivalence<node_map>(inits);
+  test_equivalence<flat_set>(keys);
+  test_equivalence<node_set>(key_list);
+
+  test_input_iterator<flat_set>(keys);
+  test_input_iterator<node_set>(keys);
+}
+
+RUN_TESTS()
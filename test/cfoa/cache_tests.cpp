@@ -0,0 +1,255 @@
+// Copyright 2025 Joaquin M Lopez Munoz.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#define BOOST_UNORDERED_ENABLE_STATS
+
+#include "helpers.hpp"
+
+#include <boost/unordered/concurrent_flat_cache.hpp>
+
+#include <chrono>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Bounded cache: size and byte budgets are enforced by CLOCK eviction,
+// referenced elements survive sweeps, expired elements are invisible and
+// get replaced on insertion.
+
+namespace {
+  using int_cache = boost::concurrent_flat_cache<int, int>;
+
+  void test_capacity()
+  {
+    int_cache x(1000);
+    BOOST_TEST_EQ(x.capacity(), 1000u);
+    BOOST_TEST_EQ(x.max_bytes(), 0u);
+    BOOST_TEST(x.empty());
+
+    for (int i = 0; i < 10000; ++i) {
+      BOOST_TEST(x.try_emplace(i, i));
+      BOOST_TEST_LE(x.size(), 1000u);
+    }
+    BOOST_TEST_EQ(x.size(), 1000u);
+    BOOST_TEST(x.contains(9999));
+
+    std::size_t n = x.cvisit_all([](int_cache::value_type const& v) {
+      BOOST_TEST_EQ(v.first, v.second);
+    });
+    BOOST_TEST_EQ(n, 1000u);
+
+    // existing elements are not overwritten
+
+    BOOST_TEST_NOT(x.try_emplace(9999, 0));
+    BOOST_TEST_NOT(x.insert({9999, 0}));
+    x.cvisit(9999, [](int_cache::value_type const& v) {
+      BOOST_TEST_EQ(v.second, 9999);
+    });
+
+    BOOST_TEST_EQ(x.erase(9999), 1u);
+    BOOST_TEST_EQ(x.erase(9999), 0u);
+    BOOST_TEST_EQ(x.size(), 999u);
+    x.clear();
+    BOOST_TEST(x.empty());
+  }
+
+  void test_hot_elements_survive()
+  {
+    int const hot = 100;
+    int_cache x(1000);
+
+    for (int i = 0; i < 1000; ++i) {
+      x.try_emplace(i, i);
+    }
+    for (int i = 1000; i < 20000; ++i) {
+      for (int j = 0; j < hot; ++j) {
+        x.cvisit(j, [](int_cache::value_type const&) {});
+      }
+      x.try_emplace(i, i);
+    }
+
+    for (int j = 0; j < hot; ++j) {
+      BOOST_TEST(x.contains(j));
+    }
+    BOOST_TEST_EQ(x.size(), 1000u);
+  }
+
+  void test_insert_or_assign()
+  {
+    int_cache x(100);
+
+    BOOST_TEST(x.insert_or_assign(1, 1));
+    BOOST_TEST_NOT(x.insert_or_assign(1, 2));
+    BOOST_TEST_EQ(x.count(1), 1u);
+    x.visit(1, [](int_cache::value_type& v) {
+      BOOST_TEST_EQ(v.second, 2);
+      ++v.second;
+    });
+    BOOST_TEST_NOT(
+      x.insert_or_visit({1, 0}, [](int_cache::value_type& v) { ++v.second; }));
+    x.cvisit(1, [](int_cache::value_type const& v) {
+      BOOST_TEST_EQ(v.second, 4);
+    });
+  }
+
+  void test_ttl()
+  {
+    using namespace std::chrono;
+
+    int_cache x(100);
+    BOOST_TEST(x.ttl() == steady_clock::duration::zero());
+
+    x.try_emplace(0, 0); // never expires
+    x.set_ttl(milliseconds(50));
+    BOOST_TEST(x.ttl() == milliseconds(50));
+    for (int i = 1; i < 10; ++i) {
+      x.try_emplace(i, i);
+    }
+    BOOST_TEST(x.contains(5));
+    BOOST_TEST_EQ(x.cvisit_all([](int_cache::value_type const&) {}), 10u);
+
+    std::this_thread::sleep_for(milliseconds(100));
+
+    BOOST_TEST(x.contains(0));
+    BOOST_TEST_NOT(x.contains(5));
+    BOOST_TEST_EQ(x.cvisit(5, [](int_cache::value_type const&) {}), 0u);
+    BOOST_TEST_EQ(x.cvisit_all([](int_cache::value_type const&) {}), 1u);
+
+    // expired elements are replaced on insertion, with a renewed expiry
+
+    x.set_ttl(seconds(60));
+    BOOST_TEST(x.try_emplace(5, 50));
+    BOOST_TEST(x.insert({6, 60}));
+    BOOST_TEST_EQ(x.count(5), 1u);
+    x.cvisit(5, [](int_cache::value_type const& v) {
+      BOOST_TEST_EQ(v.second, 50);
+    });
+    x.cvisit(6, [](int_cache::value_type const& v) {
+      BOOST_TEST_EQ(v.second, 60);
+    });
+    BOOST_TEST_EQ(x.size(), 10u);
+  }
+
+  void test_byte_budget()
+  {
+    using string_cache = boost::concurrent_flat_cache<int, std::string>;
+
+    string_cache x(1000, 10000, [](string_cache::value_type const& v) {
+      return v.second.size();
+    });
+    BOOST_TEST_EQ(x.max_bytes(), 10000u);
+
+    for (int i = 0; i < 1000; ++i) {
+      x.try_emplace(i, std::size_t(100), 'x');
+      BOOST_TEST_LE(x.bytes(), 10000u);
+    }
+    BOOST_TEST_EQ(x.size(), 100u);
+    BOOST_TEST_EQ(x.bytes(), 10000u);
+
+    BOOST_TEST_EQ(x.erase(999), 1u);
+    BOOST_TEST_EQ(x.bytes(), 9900u);
+
+    BOOST_TEST_NOT(x.insert_or_assign(998, std::string(50, 'y')));
+    BOOST_TEST_EQ(x.bytes(), 9850u);
+
+    // heavier than the budget, evicted right away along with the rest
+
+    x.try_emplace(1000, std::size_t(20000), 'z');
+    BOOST_TEST_LE(x.bytes(), 10000u);
+    BOOST_TEST_NOT(x.contains(1000));
+
+    x.insert_or_assign(1, std::string(10, 'a'));
+    BOOST_TEST_EQ(x.erase_if([](string_cache::value_type const& v) {
+      return v.second.size() == 10;
+    }),
+      1u);
+    x.clear();
+    BOOST_TEST_EQ(x.bytes(), 0u);
+  }
+
+  void test_concurrency()
+  {
+    int const n = 100000;
+    int_cache x(1000);
+
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < num_threads; ++t) {
+      threads.emplace_back([&, t] {
+        // half of the lookups go to 10 hot keys
+
+        std::mt19937 gen(static_cast<unsigned>(t));
+        std::uniform_int_distribution<int> hot(0, 9), cold(10, n);
+        for (int i = 0; i < n; ++i) {
+          int k = i % 2 ? hot(gen) : cold(gen);
+          if (!x.cvisit(k, [&](int_cache::value_type const& v) {
+                BOOST_TEST_EQ(v.first, v.second);
+              })) {
+            x.try_emplace(k, k);
+          }
+        }
+      });
+    }
+    for (auto& th : threads) {
+      th.join();
+    }
+
+    BOOST_TEST_LE(x.size(), 1000u + num_threads);
+    std::size_t m = x.cvisit_all([](int_cache::value_type const& v) {
+      BOOST_TEST_EQ(v.first, v.second);
+    });
+    BOOST_TEST_EQ(m, x.size());
+
+    // hot keys are there
+
+    for (int k = 0; k < 10; ++k) {
+      BOOST_TEST(x.contains(k));
+    }
+  }
+
+  // Once warmed up, the cache is never rehashed, even as anti-drift keeps
+  // lowering the maximum load of the underlying table.
+
+  void test_no_rehash()
+  {
+    int const n = 1000000;
+    int_cache x(10000);
+
+    for (int i = 0; i < 20000; ++i) {
+      x.try_emplace(i, i);
+    }
+    auto rehash = x.get_stats().rehash;
+
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < num_threads; ++t) {
+      threads.emplace_back([&, t] {
+        std::mt19937 gen(static_cast<unsigned>(t));
+        std::uniform_int_distribution<int> dist(0, n);
+        for (int i = 0; i < n / static_cast<int>(num_threads); ++i) {
+          int k = dist(gen);
+          x.try_emplace(k, k);
+        }
+      });
+    }
+    for (auto& th : threads) {
+      th.join();
+    }
+
+    BOOST_TEST_EQ(x.get_stats().rehash.count, rehash.count);
+    BOOST_TEST_EQ(x.get_stats().rehash.in_place_count, rehash.in_place_count);
+    BOOST_TEST_LE(x.size(), 10000u + num_threads);
+  }
+} // namespace
+
+UNORDERED_AUTO_TEST (cache) {
+  test_capacity();
+  test_hot_elements_survive();
+  test_insert_or_assign();
+  test_ttl();
+  test_byte_budget();
+  test_concurrency();
+  test_no_rehash();
+}
+
+RUN_TESTS()
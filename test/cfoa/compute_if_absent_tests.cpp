@@ -0,0 +1,135 @@
+// Copyright 2025 Joaquin M Lopez Munoz.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "helpers.hpp"
+
+#include <boost/unordered/concurrent_flat_map.hpp>
+#include <boost/unordered/concurrent_node_map.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+// compute_if_absent runs the factory with no lock held, exactly once per key
+// even when several threads ask for the same absent key at the same time.
+
+namespace {
+  template <class X> void test_basic()
+  {
+    using value_type = typename X::value_type;
+
+    X x;
+    int calls = 0;
+    auto factory = [&] {
+      ++calls;
+      return std::string("a");
+    };
+
+    BOOST_TEST(x.compute_if_absent(1, factory));
+    BOOST_TEST_NOT(x.compute_if_absent(1, factory));
+    BOOST_TEST_EQ(calls, 1);
+    BOOST_TEST_EQ(x.size(), 1u);
+
+    BOOST_TEST_NOT(x.compute_if_absent_or_visit(1, factory,
+      [](value_type& v) { v.second += "b"; }));
+    int k = 1;
+    BOOST_TEST_NOT(x.compute_if_absent_or_cvisit(k, factory,
+      [](value_type const& v) { BOOST_TEST_EQ(v.second, "ab"); }));
+    BOOST_TEST(x.compute_if_absent_or_cvisit(2, factory,
+      [](value_type const&) { BOOST_ERROR("should not be visited"); }));
+    BOOST_TEST_EQ(calls, 2);
+    x.cvisit(2, [](value_type const& v) { BOOST_TEST_EQ(v.second, "a"); });
+  }
+
+  template <class X> void test_factory_unlocked()
+  {
+    using value_type = typename X::value_type;
+
+    X x;
+
+    // would deadlock (or trip the reentrancy check) if any lock were held
+
+    BOOST_TEST(x.compute_if_absent(0, [&] {
+      BOOST_TEST(x.try_emplace(1, "1"));
+      BOOST_TEST_EQ(x.cvisit_all([](value_type const&) {}), 1u);
+      return std::string("0");
+    }));
+    BOOST_TEST_EQ(x.size(), 2u);
+
+    // the key was inserted meanwhile by the factory itself
+
+    BOOST_TEST_NOT(x.compute_if_absent(2, [&] {
+      x.try_emplace(2, "other");
+      return std::string("2");
+    }));
+    x.cvisit(2, [](value_type const& v) { BOOST_TEST_EQ(v.second, "other"); });
+  }
+
+  template <class X> void test_exception()
+  {
+    X x;
+
+    BOOST_TEST_THROWS(x.compute_if_absent(0,
+                        []() -> std::string { throw std::runtime_error(""); }),
+      std::runtime_error);
+    BOOST_TEST_EQ(x.count(0), 0u);
+    BOOST_TEST(x.compute_if_absent(0, [] { return std::string("0"); }));
+    BOOST_TEST_EQ(x.count(0), 1u);
+  }
+
+  template <class X> void test_single_computation()
+  {
+    using value_type = typename X::value_type;
+
+    int const num_keys = 20;
+
+    X x;
+    std::atomic<int> calls[num_keys];
+    for (auto& c : calls) {
+      c = 0;
+    }
+
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < num_threads; ++t) {
+      threads.emplace_back([&] {
+        for (int k = 0; k < num_keys; ++k) {
+          x.compute_if_absent_or_cvisit(
+            k,
+            [&] {
+              ++calls[k];
+              std::this_thread::sleep_for(std::chrono::milliseconds(2));
+              return std::to_string(k);
+            },
+            [&](value_type const& v) {
+              BOOST_TEST_EQ(v.second, std::to_string(k));
+            });
+        }
+      });
+    }
+    for (auto& th : threads) {
+      th.join();
+    }
+
+    BOOST_TEST_EQ(x.size(), static_cast<std::size_t>(num_keys));
+    for (auto& c : calls) {
+      BOOST_TEST_EQ(c.load(), 1);
+    }
+  }
+} // namespace
+
+UNORDERED_AUTO_TEST (compute_if_absent) {
+  test_basic<boost::concurrent_flat_map<int, std::string> >();
+  test_basic<boost::concurrent_node_map<int, std::string> >();
+  test_factory_unlocked<boost::concurrent_flat_map<int, std::string> >();
+  test_factory_unlocked<boost::concurrent_node_map<int, std::string> >();
+  test_exception<boost::concurrent_flat_map<int, std::string> >();
+  test_exception<boost::concurrent_node_map<int, std::string> >();
+  test_single_computation<boost::concurrent_flat_map<int, std::string> >();
+  test_single_computation<boost::concurrent_node_map<int, std::string> >();
+}
+
+RUN_TESTS()
@@ -0,0 +1,203 @@
+// Copyright 2025 Joaquin M Lopez Munoz.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#define BOOST_UNORDERED_ENABLE_STATS
+
+#include "helpers.hpp"
+
+#include <boost/unordered/concurrent_flat_map.hpp>
+#include <boost/unordered/concurrent_node_map.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+// Contention stats: group and container-level lock acquisitions that had to
+// wait, insertion rollbacks, rehash durations and most contended groups.
+
+namespace {
+  template <class Stats> void check_no_contention(Stats const& s)
+  {
+    BOOST_TEST_EQ(s.contention.group_lock.count, 0u);
+    BOOST_TEST_EQ(s.contention.container_lock.count, 0u);
+    BOOST_TEST_EQ(s.contention.insertion_rollbacks, 0u);
+    BOOST_TEST_EQ(s.contention.rehash_time.count, 0u);
+    BOOST_TEST(s.contention.hot_groups.empty());
+  }
+
+  // Runs f in a separate thread while a visitation of key k holds its group
+  // (and the thread's container-level) lock, so that f has to wait.
+
+  template <class X, class F> void blocked(X& x, int k, F f)
+  {
+    std::atomic<bool> entered{false}, release{false}, started{false};
+
+    std::thread t1([&] {
+      x.visit(k, [&](typename X::value_type&) {
+        entered = true;
+        while (!release) {
+          std::this_thread::yield();
+        }
+      });
+    });
+    while (!entered) {
+      std::this_thread::yield();
+    }
+
+    std::thread t2([&] {
+      started = true;
+      f();
+    });
+    while (!started) {
+      std::this_thread::yield();
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    release = true;
+
+    t1.join();
+    t2.join();
+  }
+
+  template <class X> void test_group_lock_contention()
+  {
+    X x;
+    for (int i = 0; i < 100; ++i) {
+      x.emplace(i, i);
+    }
+    x.reset_stats();
+    check_no_contention(x.get_stats());
+
+    blocked(x, 42, [&] {
+      x.visit(42, [](typename X::value_type& v) { ++v.second; });
+    });
+
+    auto s = x.get_stats();
+    BOOST_TEST_GE(s.contention.group_lock.count, 1u);
+    BOOST_TEST_GT(
+      s.contention.group_lock.spins.average +
+        s.contention.group_lock.sleeps.average,
+      0.0);
+    BOOST_TEST_EQ(s.contention.container_lock.count, 0u);
+    BOOST_TEST_EQ(s.contention.rehash_time.count, 0u);
+    BOOST_TEST_GE(s.contention.hot_groups.size(), 1u);
+    BOOST_TEST_LE(s.contention.hot_groups.size(), 8u);
+    for (std::size_t i = 1; i < s.contention.hot_groups.size(); ++i) {
+      BOOST_TEST_GE(
+        s.contention.hot_groups[i - 1].count,
+        s.contention.hot_groups[i].count);
+    }
+    BOOST_TEST_EQ(x.count(42), 1u);
+
+    x.reset_stats();
+    check_no_contention(x.get_stats());
+  }
+
+  template <class X> void test_container_lock_contention()
+  {
+    X x;
+    for (int i = 0; i < 100; ++i) {
+      x.emplace(i, i);
+    }
+    x.reset_stats();
+
+    // rehash needs exclusive access to the whole container
+
+    blocked(x, 42, [&] { x.rehash(10000); });
+
+    auto s = x.get_stats();
+    BOOST_TEST_GE(s.contention.container_lock.count, 1u);
+    BOOST_TEST_GT(
+      s.contention.container_lock.spins.average +
+        s.contention.container_lock.sleeps.average,
+      0.0);
+    BOOST_TEST_EQ(s.contention.rehash_time.count, 1u);
+    BOOST_TEST_GE(s.contention.rehash_time.duration.average, 0.0);
+    BOOST_TEST(s.contention.hot_groups.empty());
+    BOOST_TEST_EQ(x.size(), 100u);
+  }
+
+  template <class X> void test_rehash_time()
+  {
+    X x;
+    x.rehash(1000);
+    auto s = x.get_stats();
+    BOOST_TEST_EQ(s.contention.rehash_time.count, 1u);
+
+    // no-op rehash is not recorded
+
+    x.rehash(1000);
+    BOOST_TEST_EQ(x.get_stats().contention.rehash_time.count, 1u);
+
+    for (int i = 0; i < 10000; ++i) {
+      x.emplace(i, i);
+    }
+#if !defined(BOOST_UNORDERED_ENABLE_COOPERATIVE_REHASH)
+    // cooperative rehashes are spread over many operations and not timed
+
+    s = x.get_stats();
+    BOOST_TEST_EQ(s.contention.rehash_time.count, s.rehash.count);
+    BOOST_TEST_GT(s.contention.rehash_time.count, 1u);
+#endif
+  }
+
+  template <class X> void test_concurrent_insertion()
+  {
+    int const n = 50000;
+    X x;
+
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < num_threads; ++t) {
+      threads.emplace_back([&] {
+        for (int i = 0; i < n; ++i) {
+          x.emplace(i, i);
+        }
+      });
+    }
+    for (auto& th : threads) {
+      th.join();
+    }
+    BOOST_TEST_EQ(x.size(), static_cast<std::size_t>(n));
+
+    auto s = x.get_stats();
+    BOOST_TEST_LE(s.contention.insertion_rollbacks, num_threads * n);
+    BOOST_TEST_LE(s.contention.hot_groups.size(), 8u);
+  }
+
+  template <class X> void test_no_transfer()
+  {
+    X x;
+    for (int i = 0; i < 100; ++i) {
+      x.emplace(i, i);
+    }
+    blocked(x, 42, [&] { x.visit(42, [](typename X::value_type&) {}); });
+    BOOST_TEST_GE(x.get_stats().contention.group_lock.count, 1u);
+
+    X x2(x);
+    check_no_contention(x2.get_stats());
+
+    X x3(std::move(x));
+    check_no_contention(x3.get_stats());
+    BOOST_TEST_GE(x.get_stats().contention.group_lock.count, 1u);
+
+    x.swap(x2);
+    BOOST_TEST_GE(x.get_stats().contention.group_lock.count, 1u);
+    check_no_contention(x2.get_stats());
+  }
+} // namespace
+
+UNORDERED_AUTO_TEST (contention_stats) {
+  test_group_lock_contention<boost::concurrent_flat_map<int, int> >();
+  test_group_lock_contention<boost::concurrent_node_map<int, int> >();
+  test_container_lock_contention<boost::concurrent_flat_map<int, int> >();
+  test_container_lock_contention<boost::concurrent_node_map<int, int> >();
+  test_rehash_time<boost::concurrent_flat_map<int, int> >();
+  test_rehash_time<boost::concurrent_node_map<int, int> >();
+  test_concurrent_insertion<boost::concurrent_flat_map<int, int> >();
+  test_concurrent_insertion<boost::concurrent_node_map<int, int> >();
+  test_no_transfer<boost::concurrent_flat_map<int, int> >();
+  test_no_transfer<boost::concurrent_node_map<int, int> >();
+}
+
+RUN_TESTS()
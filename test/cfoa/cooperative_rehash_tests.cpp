@@ -0,0 +1,252 @@
+// Copyright 2025 Joaquin M Lopez Munoz.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#define BOOST_UNORDERED_ENABLE_COOPERATIVE_REHASH
+#define BOOST_UNORDERED_ENABLE_STATS
+
+#include "helpers.hpp"
+
+#include <boost/unordered/concurrent_flat_map.hpp>
+#include <boost/unordered/concurrent_node_map.hpp>
+#include <boost/unordered/unordered_flat_map.hpp>
+#include <boost/unordered/unordered_node_map.hpp>
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+// Growth leaves the old bucket array in place while its elements are migrated
+// by subsequent insertions. Migration state is not observable from the
+// outside, so tests fill containers right up to their maximum load and then
+// exercise every operation after the insertion triggering growth, which has
+// the old array still mostly populated.
+
+namespace {
+  static std::atomic<bool> hash_throws{false};
+
+  struct throwing_hash
+  {
+    std::size_t operator()(int x) const
+    {
+      if (hash_throws && x % 7 == 0) {
+        throw std::runtime_error("hash");
+      }
+      return boost::hash<int>()(x);
+    }
+  };
+
+  template <class K, class V>
+  using flat_map = boost::concurrent_flat_map<K, V, throwing_hash>;
+
+  template <class K, class V>
+  using node_map = boost::concurrent_node_map<K, V, throwing_hash>;
+
+  // fills x up to its maximum load with keys [0, n) and inserts key n,
+  // which triggers growth
+
+  template <class X> int fill_and_grow(X& x)
+  {
+    x.reserve(10000);
+    x.reset_stats();
+    int const n = static_cast<int>(x.max_load());
+    std::size_t const bc = x.bucket_count();
+    for (int i = 0; i < n; ++i) {
+      x.emplace(i, i);
+    }
+    BOOST_TEST_EQ(x.bucket_count(), bc);
+    x.emplace(n, n);
+    BOOST_TEST_GT(x.bucket_count(), bc);
+    BOOST_TEST_EQ(x.get_stats().rehash.count, 1u);
+    return n + 1;
+  }
+
+  template <class X> void check_contents(X const& x, int n)
+  {
+    BOOST_TEST_EQ(x.size(), static_cast<std::size_t>(n));
+    for (int i = 0; i < n; ++i) {
+      BOOST_TEST(x.cvisit(i, [&](typename X::value_type const& v) {
+        BOOST_TEST_EQ(v.second, i);
+      }));
+    }
+    BOOST_TEST(!x.contains(n));
+
+    std::size_t visited = 0;
+    x.cvisit_all([&](typename X::value_type const&) { ++visited; });
+    BOOST_TEST_EQ(visited, static_cast<std::size_t>(n));
+  }
+
+  template <class X, class Y> void test_operations()
+  {
+    {
+      X x;
+      int n = fill_and_grow(x);
+
+      // lookup, bulk lookup, insertion and erasure of old and new elements
+      check_contents(x, n);
+      std::vector<int> keys;
+      for (int i = 0; i < n; i += 3) {
+        keys.push_back(i);
+      }
+      BOOST_TEST_EQ(x.cvisit(keys.begin(), keys.end(),
+                      [](typename X::value_type const&) {}),
+        keys.size());
+      BOOST_TEST(!x.emplace(0, 0));
+      BOOST_TEST(!x.emplace(n - 1, 0));
+      BOOST_TEST_EQ(x.erase(1), 1u);
+      BOOST_TEST_EQ(x.erase(1), 0u);
+      BOOST_TEST(x.emplace(1, 1));
+      BOOST_TEST_EQ(x.erase_if([&](typename X::value_type const& v) {
+        return v.first >= n - 10;
+      }),
+        10u);
+      n -= 10;
+      check_contents(x, n);
+      BOOST_TEST_EQ(x.get_stats().rehash.count, 1u);
+    }
+
+    {
+      X x;
+      int n = fill_and_grow(x);
+
+      // copy, move, swap and conversion complete the migration
+      X y(x);
+      check_contents(y, n);
+      X z(std::move(x));
+      check_contents(z, n);
+      BOOST_TEST(y == z);
+      X w;
+      fill_and_grow(w);
+      w.swap(y);
+      check_contents(w, n);
+      y = std::move(w);
+      check_contents(y, n);
+
+      Y m(std::move(z));
+      BOOST_TEST_EQ(m.size(), static_cast<std::size_t>(n));
+      for (int i = 0; i < n; ++i) {
+        BOOST_TEST_EQ(m.at(i), i);
+      }
+    }
+
+    {
+      X x;
+      int n = fill_and_grow(x);
+      x.rehash(0);
+      check_contents(x, n);
+
+      X y;
+      fill_and_grow(y);
+      y.clear();
+      BOOST_TEST(y.empty());
+      y.emplace(0, 0);
+      BOOST_TEST_EQ(y.size(), 1u);
+    }
+  }
+
+  template <class X> void test_concurrent_growth()
+  {
+    // Writers insert disjoint key ranges going through several growth steps
+    // while readers look up keys known to have been inserted.
+
+    X x;
+    int const n = 200000;
+    std::size_t const num_writers = (std::max)(num_threads / 2, std::size_t(1));
+    std::atomic<int> inserted{0};
+    std::atomic<std::size_t> misses{0};
+    std::vector<std::thread> threads;
+
+    x.emplace(-1, -1);
+
+    for (std::size_t t = 0; t < num_writers; ++t) {
+      threads.emplace_back([&, t] {
+        for (int i = static_cast<int>(t); i < n;
+             i += static_cast<int>(num_writers)) {
+          x.emplace(i, i);
+          ++inserted;
+        }
+      });
+    }
+    for (std::size_t t = 0; t < num_writers; ++t) {
+      threads.emplace_back([&, t] {
+        unsigned i = static_cast<unsigned>(t);
+        while (inserted < n) {
+          if (!x.contains(-1)) {
+            ++misses;
+          }
+          x.visit(static_cast<int>(i++ % n),
+            [](typename X::value_type const& v) {
+              BOOST_TEST_EQ(v.first, v.second);
+            });
+        }
+      });
+    }
+    for (auto& th : threads) {
+      th.join();
+    }
+
+    BOOST_TEST_EQ(misses.load(), 0u);
+    BOOST_TEST_GT(x.get_stats().rehash.count, 1u);
+    BOOST_TEST_EQ(x.size(), static_cast<std::size_t>(n) + 1);
+    for (int i = 0; i < n; ++i) {
+      BOOST_TEST(x.contains(i));
+    }
+  }
+
+  template <class X> void test_hash_exception()
+  {
+    X x;
+    int n = fill_and_grow(x);
+
+    // hashing of old elements during migration throws; affected elements
+    // remain reachable
+    hash_throws = true;
+    int m = n;
+    for (int i = 0; i < 1000; ++i) {
+      if ((n + i) % 7 == 0) {
+        continue;
+      }
+      try {
+        if (x.emplace(n + i, n + i)) {
+          ++m;
+        }
+      } catch (std::runtime_error const&) {
+      }
+    }
+    hash_throws = false;
+
+    BOOST_TEST_EQ(x.size(), static_cast<std::size_t>(m));
+    std::size_t visited = 0;
+    x.cvisit_all([&](typename X::value_type const&) { ++visited; });
+    BOOST_TEST_EQ(visited, static_cast<std::size_t>(m));
+    for (int i = 0; i < n; ++i) {
+      BOOST_TEST(x.contains(i));
+    }
+
+    // completed on exclusive access
+    X y(x);
+    BOOST_TEST(x == y);
+    x.rehash(0);
+    BOOST_TEST_EQ(x.size(), static_cast<std::size_t>(m));
+    for (int i = 0; i < n; ++i) {
+      BOOST_TEST(x.contains(i));
+    }
+  }
+} // namespace
+
+UNORDERED_AUTO_TEST (cooperative_rehash_) {
+  test_operations<flat_map<int, int>,
+    boost::unordered_flat_map<int, int, throwing_hash> >();
+  test_operations<node_map<int, int>,
+    boost::unordered_node_map<int, int, throwing_hash> >();
+  test_hash_exception<flat_map<int, int> >();
+  test_hash_exception<node_map<int, int> >();
+}
+
+UNORDERED_AUTO_TEST (cooperative_rehash_concurrent_growth) {
+  test_concurrent_growth<boost::concurrent_flat_map<int, int> >();
+  test_concurrent_growth<boost::concurrent_node_map<int, int> >();
+}
+
+RUN_TESTS()
@@ -0,0 +1,212 @@
+// Copyright 2025 Joaquin M Lopez Munoz.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "helpers.hpp"
+
+#include <boost/unordered/concurrent_flat_map.hpp>
+#include <boost/unordered/concurrent_flat_set.hpp>
+#include <boost/unordered/concurrent_insert_only_flat_map.hpp>
+#include <boost/unordered/concurrent_node_map.hpp>
+#include <boost/unordered/concurrent_node_set.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+// Frozen containers are looked up and traversed without locking; freeze
+// waits for ongoing operations, and the container can be modified again
+// once thawed.
+
+namespace {
+  int key_of(int x) { return x; }
+  template <class T> int key_of(std::pair<T, int> const& x)
+  {
+    return x.first;
+  }
+
+  template <class X> void make(X& x, int i) { x.emplace(i); }
+  template <class K, class T>
+  void make(boost::concurrent_flat_map<K, T>& x, int i)
+  {
+    x.emplace(i, i);
+  }
+  template <class K, class T>
+  void make(boost::concurrent_node_map<K, T>& x, int i)
+  {
+    x.emplace(i, i);
+  }
+  template <class K, class T>
+  void make(boost::concurrent_insert_only_flat_map<K, T>& x, int i)
+  {
+    x.emplace(i, i);
+  }
+
+  template <class X> void populate(X& x, int n)
+  {
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < num_threads; ++t) {
+      threads.emplace_back([&, t] {
+        for (int i = static_cast<int>(t); i < n;
+             i += static_cast<int>(num_threads)) {
+          make(x, i);
+        }
+      });
+    }
+    for (auto& th : threads) {
+      th.join();
+    }
+  }
+
+  template <class X> void test_frozen_lookup()
+  {
+    using value_type = typename X::value_type;
+
+    int const n = 20000;
+    X x;
+    populate(x, n);
+
+    BOOST_TEST_NOT(x.is_frozen());
+    x.freeze();
+    BOOST_TEST(x.is_frozen());
+
+    std::atomic<std::size_t> errors{0};
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < num_threads; ++t) {
+      threads.emplace_back([&] {
+        for (int i = -10; i < n + 10; ++i) {
+          bool found = i >= 0 && i < n;
+          if (x.contains(i) != found || x.count(i) != (found ? 1u : 0u)) {
+            ++errors;
+          }
+          x.cvisit(i, [&](value_type const& v) {
+            if (key_of(v) != i) {
+              ++errors;
+            }
+          });
+          auto h = x.hash_function_mixed(i);
+          if (x.cvisit(i, h, [](value_type const&) {}) != (found ? 1u : 0u)) {
+            ++errors;
+          }
+        }
+
+        int keys[] = {-1, 0, 1, n - 1, n, n + 1};
+        if (x.cvisit(keys, keys + 6, [](value_type const&) {}) != 3u) {
+          ++errors;
+        }
+
+        std::size_t s = 0;
+        x.cvisit_all([&](value_type const&) { ++s; });
+        if (s != static_cast<std::size_t>(n)) {
+          ++errors;
+        }
+        if (x.cvisit_while([&](value_type const& v) {
+              return key_of(v) != n / 2;
+            })) {
+          ++errors;
+        }
+
+#if defined(BOOST_UNORDERED_PARALLEL_ALGORITHMS)
+        std::atomic<std::size_t> ps{0};
+        x.cvisit_all(std::execution::par, [&](value_type const&) { ++ps; });
+        if (ps != static_cast<std::size_t>(n)) {
+          ++errors;
+        }
+        if (x.cvisit_while(std::execution::par, [&](value_type const& v) {
+              return key_of(v) != n / 2;
+            })) {
+          ++errors;
+        }
+#endif
+      });
+    }
+    for (auto& th : threads) {
+      th.join();
+    }
+    BOOST_TEST_EQ(errors.load(), 0u);
+    BOOST_TEST_EQ(x.size(), static_cast<std::size_t>(n));
+
+    // copies are not frozen
+
+    X x2(x);
+    BOOST_TEST(x2 == x);
+    BOOST_TEST_NOT(x2.is_frozen());
+    make(x2, n);
+    BOOST_TEST_EQ(x2.size(), static_cast<std::size_t>(n + 1));
+
+    x.thaw();
+    BOOST_TEST_NOT(x.is_frozen());
+    make(x, n);
+    x.rehash(0);
+    BOOST_TEST(x2 == x);
+
+    // freeze/thaw can be repeated
+
+    x.freeze();
+    x.freeze();
+    BOOST_TEST_EQ(x.count(n), 1u);
+    x.thaw();
+    x.clear();
+    BOOST_TEST_EQ(x.count(n), 0u);
+  }
+
+  template <class X> void test_freeze_waits()
+  {
+    X x;
+    populate(x, 1000);
+
+    std::atomic<bool> entered{false}, release{false}, released{false};
+    std::atomic<bool> waited{false};
+
+    std::thread t1([&] {
+      x.insert_or_cvisit(42, [&](typename X::value_type const&) {
+        entered = true;
+        while (!release) {
+          std::this_thread::yield();
+        }
+        released = true;
+      });
+    });
+    while (!entered) {
+      std::this_thread::yield();
+    }
+
+    std::thread t2([&] {
+      x.freeze();
+      waited = released.load();
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    release = true;
+
+    t1.join();
+    t2.join();
+    BOOST_TEST(waited.load());
+    BOOST_TEST(x.is_frozen());
+    BOOST_TEST_EQ(x.count(42), 1u);
+    x.thaw();
+  }
+
+  template <class X> void test_empty()
+  {
+    X x;
+    x.freeze();
+    BOOST_TEST_EQ(x.count(0), 0u);
+    BOOST_TEST_EQ(x.cvisit_all([](typename X::value_type const&) {}), 0u);
+    x.thaw();
+  }
+} // namespace
+
+UNORDERED_AUTO_TEST (freeze) {
+  test_frozen_lookup<boost::concurrent_flat_map<int, int> >();
+  test_frozen_lookup<boost::concurrent_flat_set<int> >();
+  test_frozen_lookup<boost::concurrent_node_map<int, int> >();
+  test_frozen_lookup<boost::concurrent_node_set<int> >();
+  test_frozen_lookup<boost::concurrent_insert_only_flat_map<int, int> >();
+  test_freeze_waits<boost::concurrent_flat_set<int> >();
+  test_freeze_waits<boost::concurrent_node_set<int> >();
+  test_empty<boost::concurrent_flat_map<int, int> >();
+  test_empty<boost::concurrent_insert_only_flat_map<int, int> >();
+}
+
+RUN_TESTS()
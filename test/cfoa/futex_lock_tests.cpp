@@ -0,0 +1,78 @@
+// Copyright 2025 Joaquin M Lopez Munoz.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#define BOOST_UNORDERED_ENABLE_FUTEX_LOCKS
+
+#include "helpers.hpp"
+
+#include <boost/unordered/concurrent_flat_map.hpp>
+#include <boost/unordered/concurrent_node_map.hpp>
+
+#include <atomic>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// With BOOST_UNORDERED_ENABLE_FUTEX_LOCKS, group and container-level locks
+// park waiters on a futex where supported. Containers must work as usual
+// when there are many more threads than cores and some of them hold
+// exclusive access to the whole container (rehash, erase_if).
+
+namespace {
+  namespace foa = boost::unordered::detail::foa;
+
+#if defined(BOOST_UNORDERED_HAS_FUTEX_RW_SPINLOCK)
+  BOOST_STATIC_ASSERT(
+    std::is_same<foa::concurrent_rw_mutex, foa::futex_rw_spinlock>::value);
+#else
+  BOOST_STATIC_ASSERT(
+    std::is_same<foa::concurrent_rw_mutex, foa::rw_spinlock>::value);
+#endif
+
+  template <class X> void test_oversubscription()
+  {
+    int const n = 20000;
+    std::size_t const m = 4 * num_threads;
+    X x;
+    std::atomic<std::size_t> mismatches{0};
+
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < m; ++t) {
+      threads.emplace_back([&, t] {
+        for (int i = static_cast<int>(t); i < n; i += static_cast<int>(m)) {
+          x.emplace(i, i);
+          x.cvisit(i / 2, [&](typename X::value_type const& v) {
+            if (v.first != v.second) {
+              ++mismatches;
+            }
+          });
+          if (i % 3 == 0) {
+            x.erase(i);
+          }
+          if (i % 1000 == 0) {
+            x.rehash(0);
+            x.erase_if([](typename X::value_type const& v) {
+              return v.first < 0;
+            });
+          }
+        }
+      });
+    }
+    for (auto& th : threads) {
+      th.join();
+    }
+    BOOST_TEST_EQ(mismatches.load(), 0u);
+    BOOST_TEST_EQ(x.size(), static_cast<std::size_t>(n - (n + 2) / 3));
+    for (int i = 0; i < n; ++i) {
+      BOOST_TEST_EQ(x.count(i), i % 3 ? 1u : 0u);
+    }
+  }
+} // namespace
+
+UNORDERED_AUTO_TEST (futex_locks) {
+  test_oversubscription<boost::concurrent_flat_map<int, int> >();
+  test_oversubscription<boost::concurrent_node_map<int, int> >();
+}
+
+RUN_TESTS()
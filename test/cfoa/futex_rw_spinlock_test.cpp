@@ -0,0 +1,66 @@
+// Copyright 2023 Peter Dimov
+// Copyright 2025 Joaquin M Lopez Munoz
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/unordered/detail/foa/futex_rw_spinlock.hpp>
+#include <boost/config/pragma_message.hpp>
+
+#if !defined(BOOST_UNORDERED_HAS_FUTEX_RW_SPINLOCK)
+
+BOOST_PRAGMA_MESSAGE( "Test skipped because futex_rw_spinlock is not supported on this platform." )
+
+int main() {}
+
+#else
+
+#include <boost/compat/shared_lock.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <cstdint>
+#include <mutex>
+
+using boost::unordered::detail::foa::futex_rw_spinlock;
+
+static futex_rw_spinlock sp;
+static futex_rw_spinlock sp2;
+
+int main()
+{
+    BOOST_TEST_EQ( sizeof( futex_rw_spinlock ), sizeof( std::uint32_t ) );
+
+    BOOST_TEST( sp.try_lock() );
+    BOOST_TEST( !sp.try_lock() );
+    BOOST_TEST( !sp.try_lock_shared() );
+    BOOST_TEST( sp2.try_lock() );
+    BOOST_TEST( !sp2.try_lock() );
+    sp.unlock();
+    sp2.unlock();
+
+    sp.lock();
+    BOOST_TEST( !sp.try_lock() );
+    sp2.lock_shared();
+    sp2.lock_shared();
+    BOOST_TEST( !sp2.try_lock() );
+    BOOST_TEST( sp2.try_lock_shared() );
+    sp.unlock();
+    sp2.unlock_shared();
+    sp2.unlock_shared();
+    sp2.unlock_shared();
+
+    {
+        std::lock_guard<futex_rw_spinlock> lock( sp );
+        BOOST_TEST( !sp.try_lock_shared() );
+        boost::compat::shared_lock<futex_rw_spinlock> lock2( sp2 );
+        boost::compat::shared_lock<futex_rw_spinlock> lock3( sp2 );
+        BOOST_TEST( !sp2.try_lock() );
+    }
+
+    BOOST_TEST( sp.try_lock() );
+    sp.unlock();
+    BOOST_TEST( sp2.try_lock() );
+    sp2.unlock();
+
+    return boost::report_errors();
+}
+
+#endif
@@ -0,0 +1,71 @@
+// Copyright 2023 Peter Dimov
+// Copyright 2025 Joaquin M Lopez Munoz
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/unordered/detail/foa/futex_rw_spinlock.hpp>
+#include <boost/config/pragma_message.hpp>
+
+#if !defined(BOOST_UNORDERED_HAS_FUTEX_RW_SPINLOCK)
+
+BOOST_PRAGMA_MESSAGE( "Test skipped because futex_rw_spinlock is not supported on this platform." )
+
+int main() {}
+
+#else
+
+#include <boost/core/lightweight_test.hpp>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <cstdio>
+
+using boost::unordered::detail::foa::futex_rw_spinlock;
+
+// More threads than cores, so that waiters get parked on the futex
+
+static int count = 0;
+static futex_rw_spinlock sp;
+
+void f( int k, int n )
+{
+    std::printf( "Thread %d started.\n", k );
+
+    for( int i = 0; i < n; ++i )
+    {
+        std::lock_guard<futex_rw_spinlock> lock( sp );
+        ++count;
+
+        if( i % 1000 == 0 )
+        {
+            // hold the lock across a reschedule
+            std::this_thread::yield();
+        }
+    }
+
+    std::printf( "Thread %d finished.\n", k );
+}
+
+int main()
+{
+    int const N = 100000; // iterations
+    int const M = 4 * static_cast<int>( std::thread::hardware_concurrency() ) + 4; // threads
+
+    std::vector<std::thread> th;
+
+    for( int i = 0; i < M; ++i )
+    {
+        th.emplace_back( f, i, N );
+    }
+
+    for( auto& t: th )
+    {
+        t.join();
+    }
+
+    BOOST_TEST_EQ( count, N * M );
+
+    return boost::report_errors();
+}
+
+#endif
@@ -0,0 +1,85 @@
+// Copyright 2023 Peter Dimov
+// Copyright 2025 Joaquin M Lopez Munoz
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/unordered/detail/foa/futex_rw_spinlock.hpp>
+#include <boost/config/pragma_message.hpp>
+
+#if !defined(BOOST_UNORDERED_HAS_FUTEX_RW_SPINLOCK)
+
+BOOST_PRAGMA_MESSAGE( "Test skipped because futex_rw_spinlock is not supported on this platform." )
+
+int main() {}
+
+#else
+
+#include <boost/compat/shared_lock.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <cstdio>
+
+using boost::unordered::detail::foa::futex_rw_spinlock;
+
+// Readers and writers, with more threads than cores, so that both get
+// parked on the futex
+
+static int count = 0;
+static futex_rw_spinlock sp;
+
+void f( int k, int n )
+{
+    std::printf( "Thread %d started.\n", k );
+
+    int i = 0;
+
+    for( ;; ++i )
+    {
+        int oldc;
+
+        {
+            boost::compat::shared_lock<futex_rw_spinlock> lock( sp );
+            if( count >= n ) break;
+            oldc = count;
+
+            if( i % 100 == 0 )
+            {
+                // hold the lock across a reschedule
+                std::this_thread::yield();
+            }
+        }
+
+        {
+            std::lock_guard<futex_rw_spinlock> lock( sp );
+            if( count == oldc ) ++count;
+        }
+    }
+
+    std::printf( "Thread %d finished (%i iterations).\n", k, i );
+}
+
+int main()
+{
+    int const N = 200000; // total iterations
+    int const M = 4 * static_cast<int>( std::thread::hardware_concurrency() ) + 4; // threads
+
+    std::vector<std::thread> th;
+
+    for( int i = 0; i < M; ++i )
+    {
+        th.emplace_back( f, i, N );
+    }
+
+    for( auto& t: th )
+    {
+        t.join();
+    }
+
+    BOOST_TEST_EQ( count, N );
+
+    return boost::report_errors();
+}
+
+#endif
@@ -0,0 +1,91 @@
+// Copyright 2025 Joaquin M Lopez Munoz.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#define BOOST_UNORDERED_CONCURRENT_GROUP_ACCESS_LAYOUT 2
+
+#include "helpers.hpp"
+
+#include <boost/unordered/concurrent_flat_map.hpp>
+#include <boost/unordered/concurrent_node_map.hpp>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+// With BOOST_UNORDERED_CONCURRENT_GROUP_ACCESS_LAYOUT==2, group locks and
+// insertion counters are placed one per cache line and shared by the groups
+// whose metadata lie on the same cache line. Containers must work as usual,
+// including for capacities smaller than the number of groups sharing a lock
+// and with fancy pointers.
+
+namespace {
+  namespace foa = boost::unordered::detail::foa;
+
+  using group_type = foa::default_group<foa::atomic_integral>;
+  using layout_type = foa::group_access_layout<group_type>;
+
+  BOOST_STATIC_ASSERT(
+    sizeof(foa::cacheline_group_access) == foa::cacheline_size);
+  BOOST_STATIC_ASSERT(
+    layout_type::groups_per_slot == foa::cacheline_size / sizeof(group_type));
+  BOOST_STATIC_ASSERT(layout_type::cacheline_aligned);
+
+  template <class X> void test_operations()
+  {
+    int const n = 20000;
+    X x;
+    std::atomic<std::size_t> mismatches{0};
+
+    // empty container
+    BOOST_TEST_EQ(x.count(0), 0u);
+    BOOST_TEST_EQ(x.erase(0), 0u);
+
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < num_threads; ++t) {
+      threads.emplace_back([&, t] {
+        for (int i = static_cast<int>(t); i < n;
+             i += static_cast<int>(num_threads)) {
+          x.emplace(i, i);
+          x.visit(i / 2, [&](typename X::value_type& v) {
+            if (v.first != v.second) {
+              ++mismatches;
+            }
+          });
+          if (i % 3 == 0) {
+            x.erase(i);
+          }
+        }
+      });
+    }
+    for (auto& th : threads) {
+      th.join();
+    }
+    BOOST_TEST_EQ(mismatches.load(), 0u);
+    BOOST_TEST_EQ(x.size(), static_cast<std::size_t>(n - (n + 2) / 3));
+
+    // shrink to fewer groups than share a lock
+    x.erase_if([](typename X::value_type const& v) { return v.first > 4; });
+    x.rehash(0);
+    BOOST_TEST_EQ(x.size(), 3u);
+    BOOST_TEST_LE(
+      x.bucket_count() / group_type::N, layout_type::groups_per_slot);
+    for (int i = 0; i < 5; ++i) {
+      BOOST_TEST_EQ(x.count(i), i % 3 ? 1u : 0u);
+    }
+
+    X y(x);
+    BOOST_TEST(x == y);
+  }
+} // namespace
+
+UNORDERED_AUTO_TEST (group_access_layout) {
+  test_operations<boost::concurrent_flat_map<int, int> >();
+  test_operations<boost::concurrent_node_map<int, int> >();
+  test_operations<boost::concurrent_flat_map<int, int, boost::hash<int>,
+    std::equal_to<int>, fancy_allocator<std::pair<int const, int> > > >();
+  test_operations<boost::concurrent_node_map<int, int, boost::hash<int>,
+    std::equal_to<int>, fancy_allocator<std::pair<int const, int> > > >();
+}
+
+RUN_TESTS()
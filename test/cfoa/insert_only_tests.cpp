@@ -0,0 +1,249 @@
+// Copyright 2025 Joaquin M Lopez Munoz.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "helpers.hpp"
+
+#include <boost/unordered/concurrent_insert_only_flat_map.hpp>
+#include <boost/unordered/concurrent_insert_only_flat_set.hpp>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+// Insert-only containers: lookups, visitation and insertion run without
+// group locks on regular group layouts; every operation has to see fully
+// constructed elements only, and keys must not be duplicated under heavy
+// concurrent insertion of the same values.
+
+namespace {
+  int key_of(int x) { return x; }
+  template <class T> int key_of(std::pair<T, int> const& x)
+  {
+    return x.first;
+  }
+  int mapped_of(int x) { return x; }
+  template <class T> int mapped_of(std::pair<T, int> const& x)
+  {
+    return x.second;
+  }
+
+  template <class X> void make(X& x, int i) { x.emplace(i); }
+  template <class K, class T>
+  void make(boost::concurrent_insert_only_flat_map<K, T>& x, int i)
+  {
+    x.try_emplace(i, i);
+  }
+
+  template <class X> void test_dedup()
+  {
+    int const n = 20000;
+    X x;
+
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < num_threads; ++t) {
+      threads.emplace_back([&, t] {
+        for (int i = 0; i < n; ++i) {
+          make(x, (i + static_cast<int>(t) * 997) % n);
+        }
+      });
+    }
+    for (auto& th : threads) {
+      th.join();
+    }
+
+    BOOST_TEST_EQ(x.size(), static_cast<std::size_t>(n));
+    std::size_t total = 0;
+    x.cvisit_all([&](typename X::value_type const& v) {
+      BOOST_TEST_EQ(key_of(v), mapped_of(v));
+      ++total;
+    });
+    BOOST_TEST_EQ(total, static_cast<std::size_t>(n));
+    for (int i = 0; i < n; ++i) {
+      BOOST_TEST_EQ(x.count(i), 1u);
+    }
+  }
+
+  template <class X> void test_insert_or_visit()
+  {
+    int const n = 10000;
+    X x;
+    std::atomic<std::size_t> inserted{0}, visited{0};
+
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < num_threads; ++t) {
+      threads.emplace_back([&] {
+        for (int i = 0; i < n; ++i) {
+          typename X::value_type v(i, i);
+          if (x.insert_or_cvisit(
+                v, [&](typename X::value_type const&) { ++visited; })) {
+            ++inserted;
+          }
+          x.insert_and_cvisit(
+            v, [&](typename X::value_type const&) { ++inserted; },
+            [&](typename X::value_type const&) { ++visited; });
+        }
+      });
+    }
+    for (auto& th : threads) {
+      th.join();
+    }
+
+    BOOST_TEST_EQ(x.size(), static_cast<std::size_t>(n));
+    BOOST_TEST_EQ(inserted.load(), static_cast<std::size_t>(n));
+    BOOST_TEST_EQ(inserted.load() + visited.load(), 2 * num_threads * n);
+  }
+
+  template <class X> void test_read_while_inserting()
+  {
+    int const n = 50000;
+    X x; // starts empty so that insertion goes through several rehashes
+    std::atomic<bool> done{false};
+    std::atomic<std::size_t> mismatches{0};
+
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < num_threads; ++t) {
+      threads.emplace_back([&, t] {
+        if (t % 2 == 0) {
+          for (int i = static_cast<int>(t); i < n;
+               i += static_cast<int>(num_threads)) {
+            make(x, i);
+          }
+        } else {
+          while (!done) {
+            for (int i = 0; i < n; i += 97) {
+              x.cvisit(i, [&](typename X::value_type const& v) {
+                if (key_of(v) != i || mapped_of(v) != i) {
+                  ++mismatches;
+                }
+              });
+            }
+            std::size_t s = 0;
+            x.cvisit_all([&](typename X::value_type const& v) {
+              if (key_of(v) != mapped_of(v) || key_of(v) < 0 ||
+                  key_of(v) >= n) {
+                ++mismatches;
+              }
+              ++s;
+            });
+            if (s > static_cast<std::size_t>(n)) {
+              ++mismatches;
+            }
+          }
+        }
+      });
+    }
+    for (std::size_t t = 0; t < num_threads; t += 2) {
+      threads[t].join();
+    }
+    done = true;
+    for (std::size_t t = 1; t < num_threads; t += 2) {
+      threads[t].join();
+    }
+
+    BOOST_TEST_EQ(mismatches.load(), 0u);
+    std::size_t expected = 0;
+    for (int i = 0; i < n; ++i) {
+      if (static_cast<std::size_t>(i) % num_threads % 2 == 0) {
+        ++expected;
+        BOOST_TEST_EQ(x.count(i), 1u);
+      }
+    }
+    BOOST_TEST_EQ(x.size(), expected);
+  }
+
+  template <class X> void test_container_operations()
+  {
+    X x;
+    for (int i = 0; i < 1000; ++i) {
+      make(x, i);
+    }
+
+    X x2(x);
+    BOOST_TEST(x2 == x);
+    make(x2, 1000);
+    BOOST_TEST(x2 != x);
+
+    X x3(std::move(x2));
+    BOOST_TEST_EQ(x3.size(), 1001u);
+    BOOST_TEST_EQ(x2.size(), 0u);
+
+    x3.swap(x);
+    BOOST_TEST_EQ(x.size(), 1001u);
+    BOOST_TEST_EQ(x3.size(), 1000u);
+
+    x2 = x3;
+    BOOST_TEST(x2 == x3);
+    x3.clear();
+    BOOST_TEST(x3.empty());
+    BOOST_TEST_EQ(x3.count(0), 0u);
+    make(x3, 0);
+    BOOST_TEST_EQ(x3.count(0), 1u);
+
+    BOOST_TEST_EQ(
+      x.visit_while(
+        [](typename X::value_type const& v) { return key_of(v) != 500; }),
+      false);
+    x.rehash(10000);
+    BOOST_TEST_GE(x.bucket_count(), 10000u);
+    BOOST_TEST_EQ(x.size(), 1001u);
+  }
+
+  void test_map_specifics()
+  {
+    boost::concurrent_insert_only_flat_map<int, int> x;
+    BOOST_TEST(x.try_emplace(1, 10));
+    BOOST_TEST_NOT(x.try_emplace(1, 20));
+    BOOST_TEST_NOT(x.try_emplace_or_cvisit(
+      1, 30, [](std::pair<int const, int> const& v) {
+        BOOST_TEST_EQ(v.second, 10);
+      }));
+    BOOST_TEST(x.emplace_or_cvisit(2, 20, [](std::pair<int const, int> const&) {
+      BOOST_ERROR("unexpected visitation");
+    }));
+    BOOST_TEST_EQ(x.cvisit(2,
+                    [](std::pair<int const, int> const& v) {
+                      BOOST_TEST_EQ(v.second, 20);
+                    }),
+      1u);
+
+    int keys[] = {1, 2, 3};
+    BOOST_TEST_EQ(
+      x.cvisit(keys, keys + 3, [](std::pair<int const, int> const&) {}), 2u);
+  }
+
+#if defined(BOOST_UNORDERED_ENABLE_STATS)
+  template <class X> void test_stats()
+  {
+    X x;
+    for (int i = 0; i < 1000; ++i) {
+      make(x, i);
+    }
+    auto s = x.get_stats();
+    BOOST_TEST_GE(s.insertion.count, 1000u); // rehashing counts as well
+    BOOST_TEST_EQ(s.contention.group_lock.count, 0u);
+    x.reset_stats();
+    BOOST_TEST_EQ(x.get_stats().insertion.count, 0u);
+  }
+#endif
+} // namespace
+
+using set_type = boost::concurrent_insert_only_flat_set<int>;
+using map_type = boost::concurrent_insert_only_flat_map<int, int>;
+
+UNORDERED_AUTO_TEST (insert_only) {
+  test_dedup<set_type>();
+  test_dedup<map_type>();
+  test_insert_or_visit<map_type>();
+  test_read_while_inserting<set_type>();
+  test_read_while_inserting<map_type>();
+  test_container_operations<set_type>();
+  test_container_operations<map_type>();
+  test_map_specifics();
+#if defined(BOOST_UNORDERED_ENABLE_STATS)
+  test_stats<set_type>();
+  test_stats<map_type>();
+#endif
+}
+
+RUN_TESTS()
@@ -0,0 +1,107 @@
+// Copyright 2025 Joaquin M Lopez Munoz.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#define BOOST_UNORDERED_CONCURRENT_MAX_MUTEXES 4
+
+#include "helpers.hpp"
+
+#include <boost/unordered/concurrent_flat_map.hpp>
+#include <boost/unordered/concurrent_node_map.hpp>
+
+#include <atomic>
+#include <set>
+#include <thread>
+#include <vector>
+
+// Container-level locking uses as many mutexes as hardware threads, up to
+// BOOST_UNORDERED_CONCURRENT_MAX_MUTEXES, with threads assigned to mutexes
+// according to per-thread slot ids that are reused on thread exit.
+
+using boost::unordered::detail::foa::thread_slot;
+
+namespace {
+  std::vector<std::size_t> slot_ids(std::size_t n)
+  {
+    std::vector<std::size_t> ids(n);
+    boost::compat::latch latch(static_cast<std::ptrdiff_t>(n));
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < n; ++i) {
+      threads.emplace_back([&, i] {
+        ids[i] = thread_slot::id();
+        // keep all threads alive till every id has been assigned
+        latch.arrive_and_wait();
+      });
+    }
+    for (auto& th : threads) {
+      th.join();
+    }
+    return ids;
+  }
+
+  void test_thread_slots()
+  {
+    std::size_t const id = thread_slot::id();
+    BOOST_TEST_EQ(thread_slot::id(), id);
+
+    std::size_t const n = 2 * num_threads;
+    for (int i = 0; i < 3; ++i) {
+      // ids of live threads are distinct and those of exited threads reused
+      auto ids = slot_ids(n);
+      std::set<std::size_t> s(ids.begin(), ids.end());
+      BOOST_TEST_EQ(s.size(), n);
+      BOOST_TEST_EQ(s.count(id), 0u);
+      BOOST_TEST_LE(*s.rbegin(), n + 1);
+    }
+  }
+
+  template <class X> void test_locking()
+  {
+    // visitation on all mutexes racing with exclusive operations
+
+    X x;
+    int const n = 10000;
+    std::atomic<bool> done{false};
+    std::atomic<std::size_t> mismatches{0};
+    std::vector<std::thread> threads;
+
+    for (std::size_t t = 0; t < num_threads; ++t) {
+      threads.emplace_back([&, t] {
+        int i = static_cast<int>(t);
+        while (!done) {
+          x.visit(i++ % n, [&](typename X::value_type const& v) {
+            if (v.first != v.second) {
+              ++mismatches;
+            }
+          });
+        }
+      });
+    }
+
+    for (int r = 0; r < 20; ++r) {
+      for (int i = 0; i < n; ++i) {
+        x.emplace(i, i);
+      }
+      x.rehash(0);
+      X y(x);
+      BOOST_TEST_EQ(y.size(), static_cast<std::size_t>(n));
+      x.clear();
+      BOOST_TEST(x.empty());
+    }
+
+    done = true;
+    for (auto& th : threads) {
+      th.join();
+    }
+    BOOST_TEST_EQ(mismatches.load(), 0u);
+  }
+} // namespace
+
+UNORDERED_AUTO_TEST (thread_slots) { test_thread_slots(); }
+
+UNORDERED_AUTO_TEST (multimutex_locking) {
+  test_locking<boost::concurrent_flat_map<int, int> >();
+  test_locking<boost::concurrent_node_map<int, int> >();
+}
+
+RUN_TESTS()
@@ -0,0 +1,180 @@
+// Copyright 2025 Joaquin M Lopez Munoz.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#define BOOST_UNORDERED_ENABLE_OPTIMISTIC_READS
+
+#include "helpers.hpp"
+
+#include <boost/unordered/concurrent_flat_map.hpp>
+#include <boost/unordered/concurrent_flat_set.hpp>
+#include <boost/unordered/concurrent_node_map.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+// With BOOST_UNORDERED_ENABLE_OPTIMISTIC_READS, const visitation on flat
+// containers with trivially copyable elements is done on a copy of the
+// element validated against concurrent writers rather than under a group
+// lock. Other containers keep visiting the element in place.
+
+namespace {
+  struct payload
+  {
+    std::uint64_t a = 0, b = 0, c = 0;
+  };
+
+  template <class X, class Key>
+  bool visits_copy(X& x, Key const& k)
+  {
+    void const* p1 = nullptr;
+    void const* p2 = nullptr;
+    x.visit(k, [&](typename X::value_type const& v) { p1 = &v; });
+    x.cvisit(k, [&](typename X::value_type const& v) { p2 = &v; });
+    BOOST_TEST(p1 != nullptr);
+    BOOST_TEST(p2 != nullptr);
+    return p1 != p2;
+  }
+
+  void test_dispatch()
+  {
+    boost::concurrent_flat_map<int, int> x1{{1, 1}};
+    boost::concurrent_flat_set<int> x2{1};
+    boost::concurrent_flat_map<int, std::string> x3{{1, "1"}};
+    boost::concurrent_node_map<int, int> x4{{1, 1}};
+
+#if defined(BOOST_UNORDERED_OPTIMISTIC_READS)
+    BOOST_TEST(visits_copy(x1, 1));
+    BOOST_TEST(visits_copy(x2, 1));
+#else
+    // disabled under ThreadSanitizer
+    BOOST_TEST(!visits_copy(x1, 1));
+    BOOST_TEST(!visits_copy(x2, 1));
+#endif
+    BOOST_TEST(!visits_copy(x3, 1));
+    BOOST_TEST(!visits_copy(x4, 1));
+
+    // lookup results are not affected
+    BOOST_TEST_EQ(x1.count(1), 1u);
+    BOOST_TEST_EQ(x1.count(2), 0u);
+    BOOST_TEST(x2.contains(1));
+    BOOST_TEST(!x2.contains(2));
+    int r = 0;
+    BOOST_TEST_EQ(x1.cvisit(1, [&](std::pair<int const, int> const& v) {
+      r = v.second;
+    }),
+      1u);
+    BOOST_TEST_EQ(r, 1);
+  }
+
+  template <class X> void test_torn_reads()
+  {
+    // writers update, erase and reinsert elements while readers check that
+    // the copies visited are never partially written
+
+    using value_type = typename X::value_type;
+
+    int const n = 1000;
+    X x;
+    for (int i = 0; i < n; ++i) {
+      x.emplace(i, payload{});
+    }
+
+    std::atomic<bool> done{false};
+    std::atomic<std::size_t> torn{0}, found{0};
+    std::vector<std::thread> threads;
+
+    for (std::size_t t = 0; t < num_threads; ++t) {
+      threads.emplace_back([&, t] {
+        int i = static_cast<int>(t);
+        std::size_t f = 0;
+        while (!done) {
+          f += x.cvisit(i++ % n, [&](value_type const& v) {
+            if (v.second.a != v.second.b || v.second.b != v.second.c) {
+              ++torn;
+            }
+          });
+        }
+        found += f;
+      });
+    }
+
+    for (std::uint64_t r = 1; r <= 200; ++r) {
+      for (int i = 0; i < n; ++i) {
+        if (i % 7 == static_cast<int>(r % 7)) {
+          x.erase(i);
+          x.emplace(i, payload{r, r, r});
+        } else {
+          x.visit(i, [&](value_type& v) {
+            v.second.a = r;
+            v.second.b = r;
+            v.second.c = r;
+          });
+        }
+      }
+    }
+
+    done = true;
+    for (auto& th : threads) {
+      th.join();
+    }
+    BOOST_TEST_EQ(torn.load(), 0u);
+    BOOST_TEST_GT(found.load(), 0u);
+  }
+
+  template <class X> void test_growth()
+  {
+    // lookups racing with insertions triggering rehashes
+
+    int const n = 50000;
+    X x;
+    std::atomic<int> inserted{0};
+    std::atomic<std::size_t> mismatches{0}, missing{0};
+    std::vector<std::thread> threads;
+
+    for (std::size_t t = 0; t < num_threads; ++t) {
+      threads.emplace_back([&, t] {
+        int i = static_cast<int>(t);
+        while (inserted < n) {
+          int m = inserted;
+          if (m == 0) {
+            continue;
+          }
+          int k = i++ % m;
+          if (!x.cvisit(k, [&](typename X::value_type const& v) {
+                if (v.first != v.second) {
+                  ++mismatches;
+                }
+              })) {
+            ++missing;
+          }
+        }
+      });
+    }
+
+    for (int i = 0; i < n; ++i) {
+      x.emplace(i, i);
+      ++inserted;
+    }
+
+    for (auto& th : threads) {
+      th.join();
+    }
+    BOOST_TEST_EQ(mismatches.load(), 0u);
+    BOOST_TEST_EQ(missing.load(), 0u);
+  }
+} // namespace
+
+UNORDERED_AUTO_TEST (optimistic_read_dispatch) { test_dispatch(); }
+
+UNORDERED_AUTO_TEST (optimistic_read_consistency) {
+  test_torn_reads<boost::concurrent_flat_map<int, payload> >();
+  test_torn_reads<boost::concurrent_node_map<int, payload> >();
+  test_growth<boost::concurrent_flat_map<int, int> >();
+  test_growth<boost::concurrent_node_map<int, int> >();
+}
+
+RUN_TESTS()
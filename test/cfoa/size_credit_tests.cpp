@@ -0,0 +1,135 @@
+// Copyright 2025 Joaquin M Lopez Munoz.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "helpers.hpp"
+
+#include <boost/unordered/concurrent_flat_map.hpp>
+#include <boost/unordered/concurrent_node_map.hpp>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+// Insertions and erasures take size units from per-thread credits rather
+// than from the shared size counter. Credits are not observable except
+// through size() being exact when no operations are in progress and growth
+// happening at the same sizes as with serial insertion.
+
+namespace {
+  template <class X> std::size_t serial_bucket_count(int n)
+  {
+    X x;
+    for (int i = 0; i < n; ++i) {
+      x.emplace(i, i);
+    }
+    return x.bucket_count();
+  }
+
+  template <class X> void test_insert_erase()
+  {
+    int const n = 100000;
+    std::size_t const num_writers = num_threads;
+    X x;
+    std::atomic<bool> done{false};
+    std::atomic<std::size_t> out_of_range{0};
+    std::vector<std::thread> threads;
+
+    // insertion of disjoint ranges
+    for (std::size_t t = 0; t < num_writers; ++t) {
+      threads.emplace_back([&, t] {
+        for (int i = static_cast<int>(t); i < n;
+             i += static_cast<int>(num_writers)) {
+          x.emplace(i, i);
+        }
+      });
+    }
+    std::thread observer([&] {
+      while (!done) {
+        // at most n elements plus n / 2 inserted in the second phase
+        if (x.size() > static_cast<std::size_t>(n + n / 2)) {
+          ++out_of_range;
+        }
+      }
+    });
+    for (auto& th : threads) {
+      th.join();
+    }
+    BOOST_TEST_EQ(x.size(), static_cast<std::size_t>(n));
+
+    // growth happened at the same sizes as with serial insertion
+    BOOST_TEST_EQ(x.bucket_count(), serial_bucket_count<X>(n));
+
+    // erasure of half the elements, insertion of new ones
+    threads.clear();
+    for (std::size_t t = 0; t < num_writers; ++t) {
+      threads.emplace_back([&, t] {
+        for (int i = static_cast<int>(t); i < n;
+             i += static_cast<int>(num_writers)) {
+          if (i % 2) {
+            x.erase(i);
+          } else {
+            x.emplace(n + i, i);
+          }
+        }
+      });
+    }
+    for (auto& th : threads) {
+      th.join();
+    }
+    done = true;
+    observer.join();
+    BOOST_TEST_EQ(out_of_range.load(), 0u);
+    BOOST_TEST_EQ(x.size(), static_cast<std::size_t>(n));
+
+    std::size_t visited = 0;
+    x.cvisit_all([&](typename X::value_type const&) { ++visited; });
+    BOOST_TEST_EQ(visited, static_cast<std::size_t>(n));
+
+    // operations requiring exclusive access see the exact size
+    X y(x);
+    BOOST_TEST_EQ(y.size(), static_cast<std::size_t>(n));
+    BOOST_TEST(x == y);
+    x.erase_if([](typename X::value_type const& v) { return v.first < n; });
+    BOOST_TEST_EQ(x.size(), static_cast<std::size_t>(n / 2));
+    x.clear();
+    BOOST_TEST(x.empty());
+    BOOST_TEST_EQ(x.size(), 0u);
+  }
+
+  template <class X> void test_growth_point()
+  {
+    // insertions close to the maximum load do not use credits, so that growth
+    // takes place exactly when the maximum load is reached
+
+    X x;
+    x.reserve(10000);
+    std::size_t const bc = x.bucket_count();
+    int const n = static_cast<int>(x.max_load());
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < num_threads; ++t) {
+      threads.emplace_back([&, t] {
+        for (int i = static_cast<int>(t); i < n;
+             i += static_cast<int>(num_threads)) {
+          x.emplace(i, i);
+        }
+      });
+    }
+    for (auto& th : threads) {
+      th.join();
+    }
+    BOOST_TEST_EQ(x.size(), static_cast<std::size_t>(n));
+    BOOST_TEST_EQ(x.bucket_count(), bc);
+    x.emplace(n, n);
+    BOOST_TEST_GT(x.bucket_count(), bc);
+  }
+} // namespace
+
+UNORDERED_AUTO_TEST (size_credits) {
+  test_insert_erase<boost::concurrent_flat_map<int, int> >();
+  test_insert_erase<boost::concurrent_node_map<int, int> >();
+  test_growth_point<boost::concurrent_flat_map<int, int> >();
+  test_growth_point<boost::concurrent_node_map<int, int> >();
+}
+
+RUN_TESTS()
@@ -0,0 +1,217 @@
+// Copyright 2025 Joaquin M Lopez Munoz.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "helpers.hpp"
+
+#include <boost/unordered/concurrent_flat_map.hpp>
+#include <boost/unordered/concurrent_node_map.hpp>
+
+#include <atomic>
+#include <functional>
+#include <thread>
+#include <vector>
+
+// try_visit, try_[c]visit_or_emplace and try_erase never wait on a lock:
+// they report try_result::would_block instead.
+
+namespace {
+  using boost::unordered::try_result;
+
+  // hash function spinning while called from a given thread, so that
+  // the container can be caught in the middle of a rehash
+
+  struct blocking_hash
+  {
+    static std::atomic<bool> entered;
+    static std::atomic<bool> released;
+    static std::atomic<std::thread::id> blocked_id;
+
+    std::size_t operator()(int x) const
+    {
+      if (std::this_thread::get_id() == blocked_id) {
+        entered = true;
+        while (!released) {
+          std::this_thread::yield();
+        }
+      }
+      return boost::hash<int>()(x);
+    }
+  };
+
+  std::atomic<bool> blocking_hash::entered{false};
+  std::atomic<bool> blocking_hash::released{false};
+  std::atomic<std::thread::id> blocking_hash::blocked_id;
+
+  template <class X> void test_basic()
+  {
+    using value_type = typename X::value_type;
+
+    X x;
+
+    BOOST_TEST(x.try_visit(1, [](value_type&) {}) == try_result::not_found);
+
+    // no capacity yet, insertion would need to rehash
+
+    BOOST_TEST(x.try_visit_or_emplace(1, 10, [](value_type&) {}) ==
+               try_result::would_block);
+    BOOST_TEST_EQ(x.size(), 0u);
+
+    x.reserve(100);
+    BOOST_TEST(x.try_visit_or_emplace(1, 10, [](value_type&) {
+      BOOST_ERROR("should not be visited");
+    }) == try_result::not_found);
+    BOOST_TEST(x.try_visit_or_emplace(1, 20, [](value_type& v) {
+      v.second += 1;
+    }) == try_result::done);
+    int k = 2;
+    BOOST_TEST(x.try_cvisit_or_emplace(k, 20, [](value_type const&) {}) ==
+               try_result::not_found);
+    BOOST_TEST_EQ(x.size(), 2u);
+
+    BOOST_TEST(x.try_visit(1, [](value_type& v) {
+      BOOST_TEST_EQ(v.second, 11);
+    }) == try_result::done);
+    BOOST_TEST(x.try_cvisit(2, [](value_type const& v) {
+      BOOST_TEST_EQ(v.second, 20);
+    }) == try_result::done);
+    X const& cx = x;
+    BOOST_TEST(cx.try_visit(2, [](value_type const&) {}) == try_result::done);
+
+    BOOST_TEST(x.try_erase(1) == try_result::done);
+    BOOST_TEST(x.try_erase(1) == try_result::not_found);
+    BOOST_TEST_EQ(x.size(), 1u);
+  }
+
+  template <class X> void test_busy_group()
+  {
+    using value_type = typename X::value_type;
+
+    X x;
+    x.reserve(100);
+    x.emplace(1, 1);
+
+    // group of 1 locked exclusively by a visitation
+
+    x.visit(1, [&](value_type&) {
+      std::thread th([&] {
+        BOOST_TEST(x.try_visit(1, [](value_type&) {
+          BOOST_ERROR("should not be visited");
+        }) == try_result::would_block);
+        BOOST_TEST(x.try_cvisit(1, [](value_type const&) {
+          BOOST_ERROR("should not be visited");
+        }) == try_result::would_block);
+        BOOST_TEST(x.try_visit_or_emplace(1, 2, [](value_type&) {
+          BOOST_ERROR("should not be visited");
+        }) == try_result::would_block);
+        BOOST_TEST(x.try_erase(1) == try_result::would_block);
+      });
+      th.join();
+    });
+
+    BOOST_TEST_EQ(x.size(), 1u);
+    BOOST_TEST(x.try_erase(1) == try_result::done);
+  }
+
+  template <class X> void test_rehash()
+  {
+    using value_type = typename X::value_type;
+
+    X x;
+    x.emplace(1, 1);
+
+    blocking_hash::entered = false;
+    blocking_hash::released = false;
+
+    std::thread th([&] {
+      blocking_hash::blocked_id = std::this_thread::get_id();
+      x.rehash(1000);
+    });
+
+    while (!blocking_hash::entered) {
+      std::this_thread::yield();
+    }
+
+    BOOST_TEST(x.try_cvisit(1, [](value_type const&) {
+      BOOST_ERROR("should not be visited");
+    }) == try_result::would_block);
+    BOOST_TEST(x.try_visit_or_emplace(2, 2, [](value_type&) {}) ==
+               try_result::would_block);
+    BOOST_TEST(x.try_erase(1) == try_result::would_block);
+
+    blocking_hash::released = true;
+    th.join();
+    blocking_hash::blocked_id = std::thread::id();
+
+    BOOST_TEST(x.try_cvisit(1, [](value_type const&) {}) == try_result::done);
+    BOOST_TEST_EQ(x.size(), 1u);
+  }
+
+  template <class X> void test_concurrent()
+  {
+    using value_type = typename X::value_type;
+
+    int const n = 10000;
+
+    X x;
+    std::atomic<int> inserted{0};
+
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < num_threads; ++t) {
+      threads.emplace_back([&, t] {
+        for (int i = 0; i < n; ++i) {
+          int k = static_cast<int>(t) * n + i;
+
+          // lookups of the keys of a neighbor thread
+
+          int k2 = static_cast<int>((t + 1) % num_threads) * n + i;
+          x.try_cvisit(k2, [&](value_type const& v) {
+            BOOST_TEST_EQ(v.second, k2);
+          });
+
+          auto r = x.try_visit_or_emplace(k, k, [](value_type&) {
+            BOOST_ERROR("should not be visited");
+          });
+          if (r == try_result::would_block) {
+            // most likely a rehash is due
+            BOOST_TEST(x.try_emplace(k, k));
+          }
+          ++inserted;
+
+          if (i % 2 == 0) {
+            // an ongoing cooperative rehash is only completed by blocking
+            // operations, so don't spin on would_block
+
+            if (x.try_erase(k) == try_result::would_block) {
+              BOOST_TEST_EQ(x.erase(k), 1u);
+            }
+            --inserted;
+          }
+        }
+      });
+    }
+    for (auto& th : threads) {
+      th.join();
+    }
+
+    BOOST_TEST_EQ(x.size(), static_cast<std::size_t>(inserted.load()));
+    BOOST_TEST_EQ(x.size(), num_threads * static_cast<std::size_t>(n / 2));
+    x.cvisit_all([](value_type const& v) {
+      BOOST_TEST_EQ(v.first % 2, 1);
+      BOOST_TEST_EQ(v.first, v.second);
+    });
+  }
+} // namespace
+
+UNORDERED_AUTO_TEST (try_ops) {
+  test_basic<boost::concurrent_flat_map<int, int> >();
+  test_basic<boost::concurrent_node_map<int, int> >();
+  test_busy_group<boost::concurrent_flat_map<int, int> >();
+  test_busy_group<boost::concurrent_node_map<int, int> >();
+  test_rehash<boost::concurrent_flat_map<int, int, blocking_hash> >();
+  test_rehash<boost::concurrent_node_map<int, int, blocking_hash> >();
+  test_concurrent<boost::concurrent_flat_map<int, int> >();
+  test_concurrent<boost::concurrent_node_map<int, int> >();
+}
+
+RUN_TESTS()
@@ -0,0 +1,253 @@
+// Copyright 2025 Joaquin M Lopez Munoz.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "helpers.hpp"
+
+#include <boost/unordered/concurrent_flat_map.hpp>
+#include <boost/unordered/concurrent_flat_set.hpp>
+#include <boost/unordered/concurrent_insert_only_flat_map.hpp>
+#include <boost/unordered/concurrent_node_map.hpp>
+#include <boost/unordered/concurrent_node_set.hpp>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+// visit_range traverses the container in slices resumed from a cursor;
+// elements present throughout a full traversal are visited exactly once,
+// even if the container is rehashed between slices.
+
+namespace {
+  int key_of(int x) { return x; }
+  template <class T> int key_of(std::pair<T, int> const& x)
+  {
+    return x.first;
+  }
+
+  template <class X> void make(X& x, int i) { x.emplace(i); }
+  template <class K, class T>
+  void make(boost::concurrent_flat_map<K, T>& x, int i)
+  {
+    x.emplace(i, i);
+  }
+  template <class K, class T>
+  void make(boost::concurrent_node_map<K, T>& x, int i)
+  {
+    x.emplace(i, i);
+  }
+  template <class K, class T>
+  void make(boost::concurrent_insert_only_flat_map<K, T>& x, int i)
+  {
+    x.emplace(i, i);
+  }
+
+  // full traversal in slices of max_groups groups, calling between(x)
+  // after every slice; returns the number of visits for each key
+
+  template <class X, class F>
+  std::vector<int> traverse(X& x, int n, std::size_t max_groups, F between)
+  {
+    using value_type = typename X::value_type;
+
+    std::vector<int> visits(static_cast<std::size_t>(n), 0);
+    typename X::cursor c;
+    std::size_t slices = 0;
+    while (!c.done()) {
+      c = x.cvisit_range(c, max_groups, [&](value_type const& v) {
+        int k = key_of(v);
+        if (k >= 0 && k < n) {
+          ++visits[static_cast<std::size_t>(k)];
+        }
+      });
+      ++slices;
+      between(x);
+    }
+    BOOST_TEST_GE(slices, 1u);
+    return visits;
+  }
+
+  template <class X> void test_basic()
+  {
+    using value_type = typename X::value_type;
+
+    int const n = 10000;
+
+    X x;
+    typename X::cursor c;
+
+    c = x.cvisit_range(c, 1, [](value_type const&) {
+      BOOST_ERROR("empty container visited");
+    });
+    BOOST_TEST(c.done());
+
+    for (int i = 0; i < n; ++i) {
+      make(x, i);
+    }
+
+    for (std::size_t max_groups : {1u, 7u, 100u, 1000000u}) {
+      auto visits = traverse(x, n, max_groups, [](X&) {});
+      for (int v : visits) {
+        BOOST_TEST_EQ(v, 1);
+      }
+    }
+
+    // frozen tables are traversed without locking
+
+    x.freeze();
+    auto visits = traverse(x, n, 9, [](X&) {});
+    for (int v : visits) {
+      BOOST_TEST_EQ(v, 1);
+    }
+    x.thaw();
+
+    // a done cursor visits nothing and stays done
+
+    c = x.cvisit_range(c, 1, [](value_type const&) {
+      BOOST_ERROR("done cursor visited");
+    });
+    BOOST_TEST(c.done());
+
+    // a single slice covering the whole table
+
+    std::size_t count = 0;
+    X const& cx = x;
+    c = cx.visit_range(
+      typename X::cursor(), x.bucket_count(), [&](value_type const&) {
+        ++count;
+      });
+    BOOST_TEST(c.done());
+    BOOST_TEST_EQ(count, x.size());
+  }
+
+  template <class X> void test_mutable_visitation()
+  {
+    using value_type = typename X::value_type;
+
+    int const n = 1000;
+
+    X x;
+    for (int i = 0; i < n; ++i) {
+      make(x, i);
+    }
+
+    typename X::cursor c;
+    while (!c.done()) {
+      c = x.visit_range(c, 3, [](value_type& v) { v.second += 1; });
+    }
+    x.cvisit_all([](value_type const& v) {
+      BOOST_TEST_EQ(v.second, v.first + 1);
+    });
+  }
+
+  template <class X> void test_rehash_between_slices()
+  {
+    int const n = 10000;
+
+    X x;
+    for (int i = 0; i < n; ++i) {
+      make(x, i);
+    }
+
+    // growing, shrinking and growing again between slices
+
+    int step = 0;
+    auto visits = traverse(x, n, 5, [&](X& y) {
+      switch (step++ % 3) {
+      case 0:
+        y.rehash(y.bucket_count() * 2);
+        break;
+      case 1:
+        y.rehash(0);
+        break;
+      default:
+        y.reserve(y.size() * 3);
+        break;
+      }
+    });
+    for (int v : visits) {
+      BOOST_TEST_EQ(v, 1);
+    }
+
+    // new elements between slices, forcing growth
+
+    int m = n;
+    visits = traverse(x, n, 11, [&](X& y) {
+      for (int i = 0; i < 100; ++i) {
+        make(y, m++);
+      }
+    });
+    for (int v : visits) {
+      BOOST_TEST_EQ(v, 1);
+    }
+    BOOST_TEST_EQ(x.size(), static_cast<std::size_t>(m));
+  }
+
+  template <class X> void erase_if_supported(X& x, int k) { x.erase(k); }
+  template <class K, class T>
+  void erase_if_supported(boost::concurrent_insert_only_flat_map<K, T>&, int)
+  {
+  }
+
+  template <class X> void test_concurrent_writers()
+  {
+    int const n = 20000;
+
+    X x;
+    for (int i = 0; i < n; ++i) {
+      make(x, i);
+    }
+
+    // writers insert (and erase, when supported) keys above n while a
+    // scanner repeatedly traverses in small slices
+
+    std::atomic<bool> stop{false};
+    std::vector<std::thread> writers;
+    for (std::size_t t = 0; t < num_threads; ++t) {
+      writers.emplace_back([&, t] {
+        int const lag = 64 * static_cast<int>(num_threads);
+        int k = n + static_cast<int>(t);
+        for (int i = 0; !stop && i < 100000; ++i) {
+          make(x, k);
+          if (k - lag >= n) {
+            erase_if_supported(x, k - lag);
+          }
+          k += static_cast<int>(num_threads);
+        }
+      });
+    }
+
+    for (int i = 0; i < 5; ++i) {
+      auto visits = traverse(x, n, 4, [](X&) { std::this_thread::yield(); });
+      for (int v : visits) {
+        BOOST_TEST_EQ(v, 1);
+      }
+    }
+
+    stop = true;
+    for (auto& th : writers) {
+      th.join();
+    }
+  }
+
+} // namespace
+
+UNORDERED_AUTO_TEST (visit_range) {
+  test_basic<boost::concurrent_flat_map<int, int> >();
+  test_basic<boost::concurrent_node_map<int, int> >();
+  test_basic<boost::concurrent_flat_set<int> >();
+  test_basic<boost::concurrent_node_set<int> >();
+  test_basic<boost::concurrent_insert_only_flat_map<int, int> >();
+  test_mutable_visitation<boost::concurrent_flat_map<int, int> >();
+  test_mutable_visitation<boost::concurrent_node_map<int, int> >();
+  test_rehash_between_slices<boost::concurrent_flat_map<int, int> >();
+  test_rehash_between_slices<boost::concurrent_node_map<int, int> >();
+  test_rehash_between_slices<boost::concurrent_flat_set<int> >();
+  test_rehash_between_slices<boost::concurrent_node_set<int> >();
+  test_concurrent_writers<boost::concurrent_flat_map<int, int> >();
+  test_concurrent_writers<boost::concurrent_node_map<int, int> >();
+  test_concurrent_writers<boost::concurrent_flat_set<int> >();
+  test_concurrent_writers<boost::concurrent_insert_only_flat_map<int, int> >();
+}
+
+RUN_TESTS()
@@ -0,0 +1,168 @@
+// Copyright 2025 Joaquin M Lopez Munoz.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#define BOOST_UNORDERED_ENABLE_AUTO_SHRINK
+
+#if defined(BOOST_UNORDERED_FOA_TESTS)
+#define BOOST_UNORDERED_ENABLE_STATS
+#endif
+
+#include "../helpers/unordered.hpp"
+
+#include "../helpers/test.hpp"
+#include <boost/core/lightweight_test.hpp>
+#include <cstddef>
+
+#if defined(BOOST_UNORDERED_FOA_TESTS)
+#include <boost/unordered/concurrent_flat_map.hpp>
+#endif
+
+// After a mass erasure, capacity is halved on the next insertion as many times
+// as needed for the load factor to be back over the shrink threshold. Erasure
+// itself never reallocates, so erase-while-iterating loops keep working.
+
+static float const shrink_lf = BOOST_UNORDERED_AUTO_SHRINK_LOAD_FACTOR;
+
+// statistics are only available for open-addressing containers
+
+template <class Container>
+static void test_shrink_count(Container const& x, std::size_t n)
+{
+#if defined(BOOST_UNORDERED_FOA_TESTS)
+  BOOST_TEST_EQ(x.get_stats().rehash.shrink_count, n);
+#else
+  (void)x;
+  (void)n;
+#endif
+}
+
+template <class Container> static void insert_range(Container& x, int n, int m)
+{
+  for (int i = n; i < m; ++i)
+    x.emplace(i, i);
+}
+
+template <class Container> static void test_mass_erase()
+{
+  int const n = 100000;
+
+  Container x;
+  insert_range(x, 0, n);
+  std::size_t const bc = x.bucket_count();
+
+  // erase 95% of the elements while iterating
+  std::size_t visited = 0;
+  for (auto it = x.begin(); it != x.end();) {
+    ++visited;
+    if (it->first % 20 != 0)
+      it = x.erase(it);
+    else
+      ++it;
+  }
+  BOOST_TEST_EQ(visited, static_cast<std::size_t>(n));
+  BOOST_TEST_EQ(x.size(), static_cast<std::size_t>(n / 20));
+  BOOST_TEST_EQ(x.bucket_count(), bc);
+
+  // shrinking happens on insertion
+  x.emplace(n, n);
+  BOOST_TEST_LT(x.bucket_count(), bc);
+  BOOST_TEST_GE(x.load_factor(), shrink_lf * x.max_load_factor());
+  BOOST_TEST_LT(x.load_factor(), 2 * shrink_lf * x.max_load_factor());
+  test_shrink_count(x, 1);
+  for (int i = 0; i <= n; ++i) {
+    BOOST_TEST_EQ(x.count(i), (i % 20 == 0 || i == n) ? 1u : 0u);
+  }
+
+  // no further shrinking while above the threshold
+  std::size_t const bc2 = x.bucket_count();
+  for (int i = 0; i < 100; ++i) {
+    x.erase(i * 20);
+    x.emplace(i * 20, i);
+  }
+  BOOST_TEST_EQ(x.bucket_count(), bc2);
+  test_shrink_count(x, 1);
+
+  // growth as usual
+  insert_range(x, n + 1, 2 * n);
+  BOOST_TEST_GE(x.bucket_count(), bc);
+  test_shrink_count(x, 1);
+
+  // erasure by key and by range
+  for (int i = n + 1; i < 2 * n; ++i)
+    x.erase(i);
+  x.erase(x.begin(), x.end());
+  BOOST_TEST(x.empty());
+  x.emplace(0, 0);
+  BOOST_TEST_EQ(x.size(), 1u);
+  BOOST_TEST_LT(x.bucket_count(), bc);
+}
+
+template <class Container> static void test_moderate_erase()
+{
+  Container x;
+  insert_range(x, 0, 10000);
+  std::size_t const bc = x.bucket_count();
+
+  for (int i = 0; i < 10000; i += 2)
+    x.erase(i);
+  insert_range(x, 10000, 10010);
+  BOOST_TEST_EQ(x.bucket_count(), bc);
+  test_shrink_count(x, 0);
+}
+
+template <class Container> static void test_rehash_and_clear()
+{
+  Container x;
+  insert_range(x, 0, 10000);
+  std::size_t const bc = x.bucket_count();
+
+  // clear keeps the bucket array
+  x.clear();
+  x.emplace(0, 0);
+  BOOST_TEST_EQ(x.bucket_count(), bc);
+
+  // explicit rehash/reserve requests are honored
+  x.reserve(10000);
+  std::size_t const bc2 = x.bucket_count();
+  BOOST_TEST_GE(bc2, bc);
+  x.emplace(1, 1);
+  BOOST_TEST_EQ(x.bucket_count(), bc2);
+  test_shrink_count(x, 0);
+}
+
+#if defined(BOOST_UNORDERED_FOA_TESTS)
+template <class K, class V> using flat_map = boost::unordered_flat_map<K, V>;
+template <class K, class V> using node_map = boost::unordered_node_map<K, V>;
+
+static void test_concurrent()
+{
+  // automatic shrinking is not supported by concurrent containers
+  boost::concurrent_flat_map<int, int> x;
+  for (int i = 0; i < 10000; ++i)
+    x.emplace(i, i);
+  std::size_t const bc = x.bucket_count();
+
+  x.erase_if([](std::pair<int const, int> const& v) { return v.first > 0; });
+  BOOST_TEST_EQ(x.size(), 1u);
+  x.emplace(10000, 0);
+  BOOST_TEST_EQ(x.bucket_count(), bc);
+}
+#else
+template <class K, class V> using flat_map = boost::unordered_map<K, V>;
+template <class K, class V> using node_map = boost::unordered_multimap<K, V>;
+#endif
+
+UNORDERED_AUTO_TEST (auto_shrink_) {
+  test_mass_erase<flat_map<int, int> >();
+  test_mass_erase<node_map<int, int> >();
+  test_moderate_erase<flat_map<int, int> >();
+  test_moderate_erase<node_map<int, int> >();
+  test_rehash_and_clear<flat_map<int, int> >();
+  test_rehash_and_clear<node_map<int, int> >();
+#if defined(BOOST_UNORDERED_FOA_TESTS)
+  test_concurrent();
+#endif
+}
+
+RUN_TESTS()
@@ -0,0 +1,135 @@
+// Copyright 2025 Joaquin M Lopez Munoz.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(BOOST_UNORDERED_FOA_TESTS)
+#error "bulk_lookup_tests is currently only supported by open-addressed containers"
+#else
+
+#include "../helpers/unordered.hpp"
+
+#include "../helpers/helpers.hpp"
+#include "../helpers/random_values.hpp"
+#include "../helpers/test.hpp"
+#include "../objects/test.hpp"
+
+#include <vector>
+
+template <class X>
+void bulk_lookup_tests(X*, test::random_generator generator)
+{
+  using key_type = typename X::key_type;
+  using value_type = typename X::value_type;
+  using iterator = typename X::iterator;
+  using const_iterator = typename X::const_iterator;
+
+  test::random_values<X> v(1000, generator);
+  test::random_values<X> w(500, generator);
+
+  X x(v.begin(), v.end());
+  X const& cx = x;
+
+  std::vector<key_type> keys;
+  for (auto const& y : v) keys.push_back(test::get_key<X>(y));
+  for (auto const& y : w) keys.push_back(test::get_key<X>(y));
+
+  // exercise every chunk boundary around bulk_visit_size
+
+  std::size_t const sizes[] = {0, 1, X::bulk_visit_size - 1,
+    X::bulk_visit_size, X::bulk_visit_size + 1, 2 * X::bulk_visit_size - 1,
+    2 * X::bulk_visit_size, 5 * X::bulk_visit_size + 3, keys.size()};
+
+  for (std::size_t m : sizes) {
+    auto first = keys.begin(), last = first + static_cast<std::ptrdiff_t>(m);
+
+    std::vector<iterator> its(m);
+    std::vector<const_iterator> cits(m);
+    std::vector<bool> found(m);
+    std::size_t expected = 0;
+
+    BOOST_TEST(x.find(first, last, its.begin()) == its.end());
+    BOOST_TEST(cx.find(first, last, cits.begin()) == cits.end());
+    BOOST_TEST(cx.contains(first, last, found.begin()) == found.end());
+
+    for (std::size_t i = 0; i < m; ++i) {
+      BOOST_TEST(its[i] == x.find(keys[i]));
+      BOOST_TEST(cits[i] == cx.find(keys[i]));
+      BOOST_TEST_EQ(found[i], x.contains(keys[i]));
+      if (found[i]) ++expected;
+    }
+
+    std::size_t num_visits = 0;
+    auto it = first;
+    BOOST_TEST_EQ(x.visit(first, last,
+                    [&](value_type const& y) {
+                      while (!x.contains(*it)) ++it;
+                      BOOST_TEST(&y == &*x.find(*it));
+                      ++it;
+                      ++num_visits;
+                    }),
+      expected);
+    BOOST_TEST_EQ(num_visits, expected);
+
+    num_visits = 0;
+    BOOST_TEST_EQ(cx.visit(first, last,
+                    [&](value_type const&) { ++num_visits; }),
+      expected);
+    BOOST_TEST_EQ(num_visits, expected);
+
+    num_visits = 0;
+    BOOST_TEST_EQ(x.cvisit(first, last,
+                    [&](value_type const&) { ++num_visits; }),
+      expected);
+    BOOST_TEST_EQ(num_visits, expected);
+  }
+}
+
+template <class X> void bulk_lookup_empty_tests(X*, test::random_generator)
+{
+  X x;
+  typename X::key_type keys[1] = {typename X::key_type()};
+  bool found[1] = {true};
+  typename X::const_iterator it;
+
+  x.contains(keys, keys + 1, found);
+  BOOST_TEST(!found[0]);
+  x.find(keys, keys + 1, &it);
+  BOOST_TEST(it == x.end());
+  BOOST_TEST_EQ(x.visit(keys, keys + 1, [](typename X::value_type const&) {}),
+    0u);
+}
+
+using test::default_generator;
+using test::generate_collisions;
+using test::limited_range;
+
+boost::unordered_flat_set<int>* int_set_ptr;
+boost::unordered_flat_map<int, int>* int_map_ptr;
+boost::unordered_flat_set<test::object, test::hash, test::equal_to,
+  test::allocator1<test::object> >* test_set;
+boost::unordered_flat_map<test::object, test::object, test::hash,
+  test::equal_to,
+  test::allocator1<std::pair<test::object const, test::object> > >* test_map;
+
+boost::unordered_node_set<int>* int_node_set_ptr;
+boost::unordered_node_map<int, int>* int_node_map_ptr;
+boost::unordered_node_set<test::object, test::hash, test::equal_to,
+  test::allocator1<test::object> >* test_node_set;
+boost::unordered_node_map<test::object, test::object, test::hash,
+  test::equal_to,
+  test::allocator1<std::pair<test::object const, test::object> > >*
+  test_node_map;
+
+// clang-format off
+UNORDERED_TEST(bulk_lookup_tests,
+  ((int_set_ptr)(int_map_ptr)(test_set)(test_map)
+   (int_node_set_ptr)(int_node_map_ptr)(test_node_set)(test_node_map))(
+    (default_generator)(generate_collisions)(limited_range)))
+
+UNORDERED_TEST(bulk_lookup_empty_tests,
+  ((int_set_ptr)(int_map_ptr)(int_node_set_ptr)(int_node_map_ptr))(
+    (default_generator)))
+// clang-format on
+#endif
+
+RUN_TESTS()
@@ -0,0 +1,145 @@
+// Copyright 2025 Joaquin M Lopez Munoz.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(BOOST_UNORDERED_FOA_TESTS)
+#error "bulk_modifiers_tests is currently only supported by open-addressed containers"
+#else
+
+#include "../helpers/unordered.hpp"
+
+#include "../helpers/helpers.hpp"
+#include "../helpers/random_values.hpp"
+#include "../helpers/test.hpp"
+#include "../helpers/tracker.hpp"
+#include "../helpers/invariants.hpp"
+#include "../objects/test.hpp"
+
+#include <iterator>
+#include <vector>
+
+template <class X>
+void bulk_insert_tests(X*, test::random_generator generator)
+{
+  test::random_values<X> v(1000, generator);
+
+  // insertion windows straddle rehashes as the container grows from empty
+
+  {
+    X x;
+    test::ordered<X> tracker;
+
+    x.insert(v.begin(), v.end());
+    tracker.insert_range(v.begin(), v.end());
+    tracker.compare(x);
+    test::check_equivalent_keys(x);
+  }
+
+  // values already present are not inserted again
+
+  {
+    X x;
+    test::ordered<X> tracker;
+
+    auto middle = v.begin();
+    std::advance(middle, 500);
+
+    x.insert(v.begin(), middle);
+    tracker.insert_range(v.begin(), middle);
+    x.insert(v.begin(), v.end());
+    tracker.insert_range(middle, v.end());
+    tracker.compare(x);
+    test::check_equivalent_keys(x);
+  }
+
+  // move iterators
+
+  {
+    X x;
+    test::ordered<X> tracker;
+
+    std::vector<typename X::init_type> w(v.begin(), v.end());
+    x.insert(std::make_move_iterator(w.begin()),
+      std::make_move_iterator(w.end()));
+    tracker.insert_range(v.begin(), v.end());
+    tracker.compare(x);
+  }
+}
+
+template <class X>
+void bulk_erase_tests(X*, test::random_generator generator)
+{
+  using key_type = typename X::key_type;
+
+  test::random_values<X> v(1000, generator);
+  test::random_values<X> w(500, generator);
+
+  X x(v.begin(), v.end());
+
+  std::vector<key_type> keys;
+  for (auto const& y : w) keys.push_back(test::get_key<X>(y));
+  for (auto const& y : v) keys.push_back(test::get_key<X>(y));
+
+  // erase the same keys individually in a reference copy
+
+  X y(x);
+  std::size_t expected = 0;
+  for (auto const& k : keys) expected += y.erase(k);
+
+  BOOST_TEST_EQ(x.erase_bulk(keys.begin(), keys.end()), expected);
+  BOOST_TEST(x.empty());
+  BOOST_TEST(y.empty());
+  BOOST_TEST_EQ(x.erase_bulk(keys.begin(), keys.end()), 0u);
+
+  // partial erasure, with repeated keys in the same chunk
+
+  X z(v.begin(), v.end());
+  std::vector<key_type> some_keys;
+  for (auto const& y2 : v) {
+    if (some_keys.size() >= 2 * X::bulk_visit_size) break;
+    some_keys.push_back(test::get_key<X>(y2));
+    some_keys.push_back(test::get_key<X>(y2));
+  }
+
+  auto size = z.size();
+  auto n = z.erase_bulk(some_keys.begin(), some_keys.end());
+  BOOST_TEST_EQ(z.size(), size - n);
+  for (auto const& k : some_keys) BOOST_TEST(!z.contains(k));
+  test::check_equivalent_keys(z);
+}
+
+using test::default_generator;
+using test::generate_collisions;
+using test::limited_range;
+
+boost::unordered_flat_set<int>* int_set_ptr;
+boost::unordered_flat_map<int, int>* int_map_ptr;
+boost::unordered_flat_set<test::object, test::hash, test::equal_to,
+  test::allocator1<test::object> >* test_set;
+boost::unordered_flat_map<test::object, test::object, test::hash,
+  test::equal_to,
+  test::allocator1<std::pair<test::object const, test::object> > >* test_map;
+
+boost::unordered_node_set<int>* int_node_set_ptr;
+boost::unordered_node_map<int, int>* int_node_map_ptr;
+boost::unordered_node_set<test::object, test::hash, test::equal_to,
+  test::allocator1<test::object> >* test_node_set;
+boost::unordered_node_map<test::object, test::object, test::hash,
+  test::equal_to,
+  test::allocator1<std::pair<test::object const, test::object> > >*
+  test_node_map;
+
+// clang-format off
+UNORDERED_TEST(bulk_insert_tests,
+  ((int_set_ptr)(int_map_ptr)(test_set)(test_map)
+   (int_node_set_ptr)(int_node_map_ptr)(test_node_set)(test_node_map))(
+    (default_generator)(generate_collisions)(limited_range)))
+
+UNORDERED_TEST(bulk_erase_tests,
+  ((int_set_ptr)(int_map_ptr)(test_set)(test_map)
+   (int_node_set_ptr)(int_node_map_ptr)(test_node_set)(test_node_map))(
+    (default_generator)(generate_collisions)(limited_range)))
+// clang-format on
+#endif
+
+RUN_TESTS()
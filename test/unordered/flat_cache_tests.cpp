@@ -0,0 +1,207 @@
+// Copyright 2025 Joaquin M Lopez Munoz.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(BOOST_UNORDERED_FOA_TESTS)
+#error "flat_cache_tests is currently only supported by open-addressed containers"
+#endif
+
+#include "../helpers/test.hpp"
+#include <boost/core/lightweight_test.hpp>
+#include <boost/unordered/unordered_flat_cache.hpp>
+#include <cstddef>
+#include <random>
+#include <string>
+#include <vector>
+
+// Fixed-capacity cache: insertion into a full cache evicts an element in
+// place, so surviving elements never move, and recently looked up elements
+// survive eviction under every policy.
+
+using cache_type = boost::unordered_flat_cache<int, int>;
+
+static boost::unordered::cache_eviction const policies[] = {
+  boost::unordered::cache_eviction::clock,
+  boost::unordered::cache_eviction::sieve,
+  boost::unordered::cache_eviction::lru};
+
+static void test_capacity(boost::unordered::cache_eviction policy)
+{
+  cache_type x(1000, policy);
+  BOOST_TEST_EQ(x.capacity(), 1000u);
+  BOOST_TEST(x.policy() == policy);
+  BOOST_TEST(x.empty());
+
+  for (int i = 0; i < 10000; ++i) {
+    auto r = x.try_emplace(i, i);
+    BOOST_TEST(r.second);
+    BOOST_TEST_EQ(r.first->first, i);
+    BOOST_TEST_LE(x.size(), 1000u);
+  }
+  BOOST_TEST_EQ(x.size(), 1000u);
+  BOOST_TEST(x.contains(9999));
+
+  std::size_t n = 0;
+  for (auto const& v : x) {
+    BOOST_TEST_EQ(v.first, v.second);
+    BOOST_TEST(x.find(v.first) != x.end());
+    ++n;
+  }
+  BOOST_TEST_EQ(n, 1000u);
+
+  // existing elements are not overwritten
+
+  BOOST_TEST_NOT(x.try_emplace(9999, 0).second);
+  BOOST_TEST_NOT(x.insert({9999, 0}).second);
+  BOOST_TEST_EQ(x.find(9999)->second, 9999);
+
+  BOOST_TEST_EQ(x.erase(9999), 1u);
+  BOOST_TEST_EQ(x.erase(9999), 0u);
+  BOOST_TEST_EQ(x.count(9999), 0u);
+  x.erase(x.find(9998));
+  BOOST_TEST_EQ(x.size(), 998u);
+  x.clear();
+  BOOST_TEST(x.empty());
+  BOOST_TEST(x.begin() == x.end());
+}
+
+static void test_hot_elements_survive(boost::unordered::cache_eviction policy)
+{
+  int const hot = 100;
+  cache_type x(1000, policy);
+
+  // read-through access: hot keys may only miss while the first turn of the
+  // hand finds every element marked
+
+  std::size_t misses = 0;
+  auto get = [&](int k) {
+    if (x.find(k) == x.end()) {
+      ++misses;
+      x.try_emplace(k, k);
+    }
+  };
+
+  for (int i = 0; i < 1000; ++i) {
+    x.try_emplace(i, i);
+  }
+  for (int i = 1000; i < 3000; ++i) {
+    for (int j = 0; j < hot; ++j) {
+      get(j);
+    }
+    x.try_emplace(i, i);
+  }
+  BOOST_TEST_LE(misses, static_cast<std::size_t>(hot));
+
+  // elements are never relocated
+
+  std::vector<cache_type::value_type*> addresses;
+  for (int j = 0; j < hot; ++j) {
+    addresses.push_back(&*x.find(j));
+  }
+
+  misses = 0;
+  for (int i = 3000; i < 20000; ++i) {
+    for (int j = 0; j < hot; ++j) {
+      get(j);
+    }
+    x.try_emplace(i, i);
+  }
+  BOOST_TEST_EQ(misses, 0u);
+
+  for (int j = 0; j < hot; ++j) {
+    auto it = x.find(j);
+    BOOST_TEST(it != x.end());
+    BOOST_TEST_EQ(&*it, addresses[static_cast<std::size_t>(j)]);
+  }
+  BOOST_TEST_EQ(x.size(), 1000u);
+}
+
+static void test_insert_or_assign()
+{
+  boost::unordered_flat_cache<int, std::string> x(100);
+
+  BOOST_TEST(x.insert_or_assign(1, "a").second);
+  auto r = x.insert_or_assign(1, "b");
+  BOOST_TEST_NOT(r.second);
+  BOOST_TEST_EQ(r.first->second, "b");
+  x.find(1)->second += "c";
+  BOOST_TEST_EQ(x.find(1)->second, "bc");
+}
+
+// Arguments to insertion into a full cache may refer to the element about to
+// be evicted.
+
+static void test_args_from_evicted(boost::unordered::cache_eviction policy)
+{
+  boost::unordered_flat_cache<int, std::string> x(1, policy);
+  std::string const s(100, 'a');
+
+  x.try_emplace(1, s);
+  auto const& v = x.find(1)->second;
+  auto r = x.try_emplace(2, v);
+  BOOST_TEST(r.second);
+  BOOST_TEST_EQ(r.first->second, s);
+  BOOST_TEST_EQ(x.size(), 1u);
+  BOOST_TEST_NOT(x.contains(1));
+
+  auto const& w = *x.find(2);
+  r = x.insert(w);
+  BOOST_TEST_NOT(r.second);
+  r = x.insert_or_assign(3, w.second);
+  BOOST_TEST(r.second);
+  BOOST_TEST_EQ(x.find(3)->second, s);
+  BOOST_TEST_EQ(x.size(), 1u);
+}
+
+// Erase/insert churn at constant size makes anti-drift lower the maximum
+// load of the underlying table: this must not cause any relocation.
+
+static void test_churn(boost::unordered::cache_eviction policy)
+{
+  cache_type x(500, policy);
+  std::mt19937 gen(1);
+  std::uniform_int_distribution<int> dist(1, 100000);
+
+  for (int i = 0; i < 500; ++i) {
+    x.try_emplace(i, i);
+  }
+  cache_type::value_type* p = nullptr;
+
+  for (int i = 0; i < 200000; ++i) {
+    if (i == 10000) {
+      p = &*x.find(0);
+    }
+    if (x.find(0) == x.end()) {
+      BOOST_TEST_LT(i, 10000);
+      x.try_emplace(0, 0);
+    }
+    int k = dist(gen);
+    if (i % 3 == 0) {
+      x.erase(k);
+    } else {
+      x.insert_or_assign(k, k);
+    }
+    BOOST_TEST_LE(x.size(), 500u);
+  }
+
+  BOOST_TEST_EQ(&*x.find(0), p);
+
+  std::size_t n = 0;
+  for (auto const& v : x) {
+    BOOST_TEST(x.find(v.first) != x.end());
+    ++n;
+  }
+  BOOST_TEST_EQ(n, x.size());
+}
+
+UNORDERED_AUTO_TEST (flat_cache) {
+  for (auto policy : policies) {
+    test_capacity(policy);
+    test_hot_elements_survive(policy);
+    test_churn(policy);
+    test_args_from_evicted(policy);
+  }
+  test_insert_or_assign();
+}
+
+RUN_TESTS()
@@ -0,0 +1,239 @@
+// Copyright 2025 Joaquin M Lopez Munoz.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "../helpers/unordered.hpp"
+
+#include "../helpers/pmr.hpp"
+#include "../helpers/test.hpp"
+#include <boost/core/lightweight_test.hpp>
+#include <boost/unordered/huge_page_allocator.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+#if defined(BOOST_UNORDERED_FOA_TESTS)
+#include <boost/unordered/concurrent_flat_map.hpp>
+#endif
+
+// Containers using huge_page_allocator with a low threshold so that their
+// bucket arrays take the huge page path, over std::allocator and
+// std::pmr::polymorphic_allocator. Huge page and NUMA hints are best-effort
+// and may well be ignored here, but behavior must be the same. With
+// lazy_zero, open-addressing containers rely on the bucket array coming
+// zeroed from the OS and don't initialize its metadata.
+
+static std::size_t const huge_page_size =
+  boost::unordered::huge_page_options::huge_page_size;
+
+template <class T> using huge_allocator = boost::huge_page_allocator<T>;
+
+static boost::huge_page_options make_options(int variant)
+{
+  boost::huge_page_options opts;
+  opts.threshold = 64 * 1024;
+  switch (variant) {
+  case 1:
+    opts.numa_policy = boost::huge_page_options::numa_interleave;
+    break;
+  case 2:
+    opts.hugetlb = true;
+    opts.numa_policy = boost::huge_page_options::numa_bind;
+    opts.numa_nodes = 1; // node 0
+    break;
+  case 3:
+    opts.lazy_zero = true;
+    break;
+  case 4:
+    opts.populate = true;
+    break;
+  case 5:
+    opts.lazy_zero = true;
+    opts.populate = true;
+    opts.numa_policy = boost::huge_page_options::numa_interleave;
+    break;
+  default:
+    break;
+  }
+  return opts;
+}
+
+static bool is_huge_page_aligned(void const* p)
+{
+  return reinterpret_cast<std::uintptr_t>(p) % huge_page_size == 0;
+}
+
+static void test_allocator(int variant)
+{
+  using allocator_type = huge_allocator<std::uint64_t>;
+
+  allocator_type al(make_options(variant));
+
+  // below threshold: upstream allocation
+  BOOST_TEST(!al.allocates_zeroed(16));
+  std::uint64_t* p = al.allocate(16);
+  p[0] = p[15] = 1;
+  al.deallocate(p, 16);
+
+  // above threshold
+  for (std::size_t n : {8192u, 100000u, 1000000u}) {
+    bool zeroed = al.allocates_zeroed(n);
+#if defined(__linux__)
+    BOOST_TEST_EQ(zeroed, al.options().lazy_zero);
+#endif
+
+    p = al.allocate(n);
+    BOOST_TEST(is_huge_page_aligned(p));
+    if (zeroed) {
+      for (std::size_t i = 0; i < n; ++i)
+        BOOST_TEST_EQ(p[i], 0u);
+    }
+    for (std::size_t i = 0; i < n; ++i)
+      p[i] = i;
+    for (std::size_t i = 0; i < n; i += 999)
+      BOOST_TEST_EQ(p[i], i);
+
+    // rebound copies are interchangeable
+    huge_allocator<char> al2(al);
+    allocator_type al3(al2);
+    BOOST_TEST(al2 == al);
+    BOOST_TEST(al3 == al);
+    al3.deallocate(p, n);
+  }
+
+  BOOST_TEST(allocator_type() != al);
+}
+
+template <class Container> static void test_container(int variant)
+{
+  using allocator_type = typename Container::allocator_type;
+
+  Container x(0, typename Container::hasher(), typename Container::key_equal(),
+    allocator_type(make_options(variant)));
+
+  for (int i = 0; i < 100000; ++i)
+    x.emplace(i, i);
+  BOOST_TEST_EQ(x.size(), 100000u);
+
+  Container y(x);
+  BOOST_TEST(x == y);
+  BOOST_TEST_EQ(y.get_allocator().options().threshold,
+    x.get_allocator().options().threshold);
+
+  for (int i = 0; i < 100000; i += 2)
+    BOOST_TEST_EQ(x.erase(i), 1u);
+  x.rehash(0);
+  for (int i = 0; i < 100000; ++i)
+    BOOST_TEST_EQ(x.count(i), static_cast<std::size_t>(i % 2));
+
+  y.clear();
+  y.rehash(0);
+  BOOST_TEST(y.empty());
+}
+
+#if defined(BOOST_UNORDERED_FOA_TESTS)
+template <class K, class V>
+using huge_flat_map = boost::unordered_flat_map<K, V, boost::hash<K>,
+  std::equal_to<K>, huge_allocator<std::pair<K const, V> > >;
+
+template <class K, class V>
+using huge_node_map = boost::unordered_node_map<K, V, boost::hash<K>,
+  std::equal_to<K>, huge_allocator<std::pair<K const, V> > >;
+
+template <class K>
+using huge_flat_set = boost::unordered_flat_set<K, boost::hash<K>,
+  std::equal_to<K>, huge_allocator<K> >;
+
+template <class K, class V>
+using huge_concurrent_flat_map = boost::concurrent_flat_map<K, V,
+  boost::hash<K>, std::equal_to<K>, huge_allocator<std::pair<K const, V> > >;
+
+static void test_flat_set(int variant)
+{
+  using allocator_type = huge_flat_set<int>::allocator_type;
+
+  huge_flat_set<int> x(0, boost::hash<int>(), std::equal_to<int>(),
+    allocator_type(make_options(variant)));
+  for (int i = 0; i < 100000; ++i)
+    x.insert(i);
+  BOOST_TEST_EQ(x.size(), 100000u);
+}
+
+static void test_concurrent(int variant)
+{
+  using allocator_type = huge_concurrent_flat_map<int, int>::allocator_type;
+
+  huge_concurrent_flat_map<int, int> x(0, boost::hash<int>(),
+    std::equal_to<int>(), allocator_type(make_options(variant)));
+  for (int i = 0; i < 100000; ++i)
+    x.emplace(i, i);
+  BOOST_TEST_EQ(x.size(), 100000u);
+
+  huge_flat_map<int, int> y(std::move(x));
+  BOOST_TEST_EQ(y.size(), 100000u);
+  for (int i = 0; i < 100000; ++i)
+    BOOST_TEST_EQ(y.at(i), i);
+}
+#else
+template <class K, class V>
+using huge_map = boost::unordered_map<K, V, boost::hash<K>, std::equal_to<K>,
+  huge_allocator<std::pair<K const, V> > >;
+
+template <class K, class V>
+using huge_multimap = boost::unordered_multimap<K, V, boost::hash<K>,
+  std::equal_to<K>, huge_allocator<std::pair<K const, V> > >;
+#endif
+
+#if !defined(BOOST_NO_CXX17_HDR_MEMORY_RESOURCE)
+static void test_pmr(int variant)
+{
+  using allocator_type = boost::huge_page_allocator<std::pair<int const, int>,
+    std::pmr::polymorphic_allocator<std::pair<int const, int> > >;
+#if defined(BOOST_UNORDERED_FOA_TESTS)
+  using container = boost::unordered_flat_map<int, int, boost::hash<int>,
+    std::equal_to<int>, allocator_type>;
+#else
+  using container = boost::unordered_map<int, int, boost::hash<int>,
+    std::equal_to<int>, allocator_type>;
+#endif
+
+  test::counted_new_delete_resource resource;
+  {
+    container x(0, boost::hash<int>(), std::equal_to<int>(),
+      allocator_type(make_options(variant), &resource));
+    for (int i = 0; i < 100000; ++i)
+      x.emplace(i, i);
+    BOOST_TEST_EQ(x.size(), 100000u);
+    BOOST_TEST(x.get_allocator().upstream().resource() == &resource);
+
+    // the memory of the bucket array comes from the resource unless it is
+    // mapped directly from the OS
+    auto opts = make_options(variant);
+    if (!opts.hugetlb && !opts.lazy_zero) {
+      BOOST_TEST_GE(resource.count(), 100000u * sizeof(std::pair<int, int>));
+    }
+  }
+  BOOST_TEST_EQ(resource.count(), 0u);
+}
+#endif
+
+UNORDERED_AUTO_TEST (huge_page_allocator_) {
+  for (int variant = 0; variant < 6; ++variant) {
+    test_allocator(variant);
+#if defined(BOOST_UNORDERED_FOA_TESTS)
+    test_container<huge_flat_map<int, int> >(variant);
+    test_container<huge_node_map<int, int> >(variant);
+    test_flat_set(variant);
+    test_concurrent(variant);
+#else
+    test_container<huge_map<int, int> >(variant);
+    test_container<huge_multimap<int, int> >(variant);
+#endif
+#if !defined(BOOST_NO_CXX17_HDR_MEMORY_RESOURCE)
+    test_pmr(variant);
+#endif
+  }
+}
+
+RUN_TESTS()
@@ -0,0 +1,250 @@
+// Copyright 2025 Joaquin M Lopez Munoz.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(BOOST_UNORDERED_FOA_TESTS)
+#error "in_place_rehash_tests is currently only supported by open-addressed containers"
+#endif
+
+#define BOOST_UNORDERED_ENABLE_STATS
+
+#include "../helpers/unordered.hpp"
+
+#include "../helpers/test.hpp"
+#include <boost/core/lightweight_test.hpp>
+#include <boost/unordered/concurrent_flat_map.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+// Erase/insert churn at constant size makes anti-drift lower the maximum load
+// until growth is requested within the same capacity: this must be resolved
+// by rebuilding overflow information in place, without reallocation.
+
+struct throwing_move
+{
+  int x;
+
+  throwing_move(int x_) : x{x_} {}
+  throwing_move(throwing_move const&) = default;
+  throwing_move(throwing_move&& rhs) noexcept(false) : x{rhs.x} {}
+  throwing_move& operator=(throwing_move const&) = default;
+
+  friend bool operator==(throwing_move const& lhs, throwing_move const& rhs)
+  {
+    return lhs.x == rhs.x;
+  }
+};
+
+struct throwing_move_hash
+{
+  std::size_t operator()(throwing_move const& v) const
+  {
+    return boost::hash<int>()(v.x);
+  }
+};
+
+// sequential keys spread too evenly over the table for overflow to occur, so
+// they are scrambled with a bijective mixing function
+
+static int scramble(int i)
+{
+  std::uint32_t x = static_cast<std::uint32_t>(i);
+  x ^= x >> 16;
+  x *= 0x85ebca6bu;
+  x ^= x >> 13;
+  x *= 0xc2b2ae35u;
+  x ^= x >> 16;
+  return static_cast<int>(x);
+}
+
+static int make_key(int i, int*) { return scramble(i); }
+
+static throwing_move make_key(int i, throwing_move*) { return {scramble(i)}; }
+
+template <class Container> static void insert_key(Container& x, int i)
+{
+  using key_type = typename Container::key_type;
+
+  x.emplace(make_key(i, (key_type*)nullptr), i);
+}
+
+static void insert_key(boost::unordered_flat_set<int>& x, int i)
+{
+  x.insert(scramble(i));
+}
+
+static void insert_key(boost::unordered_node_set<int>& x, int i)
+{
+  x.insert(scramble(i));
+}
+
+template <class Container>
+static bool contains_key(Container const& x, int i)
+{
+  using key_type = typename Container::key_type;
+
+  return x.contains(make_key(i, (key_type*)nullptr));
+}
+
+template <class Container> static void erase_key(Container& x, int i)
+{
+  using key_type = typename Container::key_type;
+
+  BOOST_TEST_EQ(x.erase(make_key(i, (key_type*)nullptr)), 1u);
+}
+
+// size close enough to the maximum load for anti-drift to be noticeable,
+// but leaving some 5% room so that growth does not need more capacity
+
+template <class Container> static int churn_size(Container& x)
+{
+  x.reserve(10000);
+  return static_cast<int>(static_cast<double>(x.max_load()) * 0.95);
+}
+
+template <class Container> static void test_churn()
+{
+  int const rounds = 10;
+
+  Container x;
+  int const n = churn_size(x);
+  for (int i = 0; i < n; ++i) {
+    insert_key(x, i);
+  }
+
+  std::size_t const bucket_count = x.bucket_count();
+  x.reset_stats();
+
+  // sliding window of keys [first, first + n)
+  int first = 0;
+  for (int i = 0; i < rounds * n; ++i, ++first) {
+    erase_key(x, first);
+    insert_key(x, first + n);
+  }
+
+  BOOST_TEST_EQ(x.size(), static_cast<std::size_t>(n));
+  BOOST_TEST_EQ(x.bucket_count(), bucket_count);
+  BOOST_TEST_EQ(
+    static_cast<std::size_t>(std::distance(x.begin(), x.end())), x.size());
+  for (int i = 0; i < first; ++i) {
+    BOOST_TEST(!contains_key(x, i));
+  }
+  for (int i = first; i < first + n; ++i) {
+    BOOST_TEST(contains_key(x, i));
+  }
+
+  auto stats = x.get_stats();
+  BOOST_TEST_EQ(stats.rehash.count, 0u);
+  BOOST_TEST_GT(stats.rehash.in_place_count, 0u);
+
+  // probe length kept under control
+  BOOST_TEST_LT(stats.successful_lookup.probe_length.average, 1.5);
+
+  x.reset_stats();
+  stats = x.get_stats();
+  BOOST_TEST_EQ(stats.rehash.count, 0u);
+  BOOST_TEST_EQ(stats.rehash.in_place_count, 0u);
+
+  // regular growth
+  for (int i = first + n; i < first + 2 * n; ++i) {
+    insert_key(x, i);
+  }
+  BOOST_TEST_GT(x.get_stats().rehash.count, 0u);
+}
+
+static void test_concurrent_churn()
+{
+  int const rounds = 10;
+
+  boost::concurrent_flat_map<int, int> x;
+  int const n = churn_size(x);
+  for (int i = 0; i < n; ++i) {
+    x.emplace(scramble(i), i);
+  }
+  x.reset_stats();
+
+  int first = 0;
+  for (int i = 0; i < rounds * n; ++i, ++first) {
+    BOOST_TEST_EQ(x.erase(scramble(first)), 1u);
+    BOOST_TEST(x.emplace(scramble(first + n), first + n));
+  }
+
+  BOOST_TEST_EQ(x.size(), static_cast<std::size_t>(n));
+  for (int i = 0; i < first + n; ++i) {
+    BOOST_TEST_EQ(x.count(scramble(i)), i < first ? 0u : 1u);
+  }
+
+  auto stats = x.get_stats();
+  BOOST_TEST_EQ(stats.rehash.count, 0u);
+  BOOST_TEST_GT(stats.rehash.in_place_count, 0u);
+}
+
+// hash function throwing on demand
+
+static int hash_countdown = -1;
+
+struct countdown_hash
+{
+  std::size_t operator()(int x) const
+  {
+    if (hash_countdown >= 0 && hash_countdown-- == 0) {
+      throw std::runtime_error("");
+    }
+    return boost::hash<int>()(x);
+  }
+};
+
+static void test_exception_safety()
+{
+  boost::unordered_flat_map<int, int, countdown_hash> x;
+  int const n = churn_size(x);
+  for (int i = 0; i < n; ++i) {
+    x.emplace(scramble(i), i);
+  }
+  x.reset_stats();
+
+  // insertion hashes once unless an in-place rehash is triggered, which is
+  // then made to throw midway
+  int first = 0;
+  bool thrown = false;
+  for (int i = 0; !thrown && i < 10 * n; ++i) {
+    BOOST_TEST_EQ(x.erase(scramble(first)), 1u);
+    ++first;
+
+    hash_countdown = n / 2;
+    try {
+      x.emplace(scramble(first + n - 1), 0);
+    } catch (std::runtime_error const&) {
+      thrown = true;
+    }
+    hash_countdown = -1;
+  }
+  BOOST_TEST(thrown);
+
+  BOOST_TEST_EQ(x.size(), static_cast<std::size_t>(n - 1));
+  BOOST_TEST(x.find(scramble(first + n - 1)) == x.end());
+  for (int i = first; i < first + n - 1; ++i) {
+    BOOST_TEST(x.contains(scramble(i)));
+  }
+  BOOST_TEST_EQ(x.get_stats().rehash.in_place_count, 0u);
+
+  // container still usable
+  BOOST_TEST(x.emplace(scramble(first + n - 1), 0).second);
+  BOOST_TEST(x.contains(scramble(first + n - 1)));
+  BOOST_TEST_EQ(x.size(), static_cast<std::size_t>(n));
+}
+
+UNORDERED_AUTO_TEST (in_place_rehash_) {
+  test_churn<boost::unordered_flat_map<int, int> >();
+  test_churn<boost::unordered_node_map<int, int> >();
+  test_churn<boost::unordered_flat_set<int> >();
+  test_churn<boost::unordered_node_set<int> >();
+  test_churn<
+    boost::unordered_flat_map<throwing_move, int, throwing_move_hash> >();
+
+  test_concurrent_churn();
+  test_exception_safety();
+}
+
+RUN_TESTS()
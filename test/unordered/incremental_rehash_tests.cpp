@@ -0,0 +1,294 @@
+// Copyright 2025 Joaquin M Lopez Munoz.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(BOOST_UNORDERED_FOA_TESTS)
+#error "incremental_rehash_tests is currently only supported by open-addressed containers"
+#endif
+
+#define BOOST_UNORDERED_ENABLE_INCREMENTAL_REHASH
+
+#include "../helpers/unordered.hpp"
+
+#include "../helpers/test.hpp"
+#include <boost/core/lightweight_test.hpp>
+#include <boost/unordered/concurrent_flat_map.hpp>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+// Operations are checked right after growth points, when old and new arrays
+// coexist and elements are split between them.
+
+static std::pair<int const, int> make_value(
+  int i, std::pair<int const, int>*)
+{
+  return {i, i};
+}
+
+static int make_value(int i, int*) { return i; }
+
+static int mapped_of(std::pair<int const, int> const& x) { return x.second; }
+
+static int mapped_of(int x) { return x; }
+
+template <class Container> static long long sum_of(Container const& x)
+{
+  long long s = 0;
+  for (auto const& v : x) {
+    s += mapped_of(v);
+  }
+  return s;
+}
+
+template <class Container> static bool contains_range(Container const& x, int n)
+{
+  for (int i = 0; i < n; ++i) {
+    if (x.find(i) == x.end()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// insert [0,n) checking that every element is reachable and visited exactly
+// once after each growth
+
+template <class Container> static void test_insertion(int n)
+{
+  using value_type = typename Container::value_type;
+
+  Container x;
+  long long sum = 0;
+  std::size_t bucket_count = x.bucket_count();
+
+  for (int i = 0; i < n; ++i) {
+    BOOST_TEST(x.insert(make_value(i, (value_type*)nullptr)).second);
+    BOOST_TEST(!x.insert(make_value(i, (value_type*)nullptr)).second);
+    sum += i;
+
+    if (x.bucket_count() != bucket_count || i % 101 == 0) {
+      bucket_count = x.bucket_count();
+      BOOST_TEST_EQ(x.size(), static_cast<std::size_t>(i + 1));
+      BOOST_TEST_EQ(
+        static_cast<std::size_t>(std::distance(x.begin(), x.end())), x.size());
+      BOOST_TEST_EQ(sum_of(x), sum);
+      BOOST_TEST(contains_range(x, i + 1));
+      BOOST_TEST(x.find(i + 1) == x.end());
+
+      // traversal from any element reaches the end
+      auto it = x.find(i / 2);
+      BOOST_TEST(it != x.end());
+      BOOST_TEST(
+        static_cast<std::size_t>(std::distance(it, x.end())) <= x.size());
+    }
+  }
+}
+
+template <class Container> static Container make_container(int n)
+{
+  using value_type = typename Container::value_type;
+
+  Container x;
+  for (int i = 0; i < n; ++i) {
+    x.insert(make_value(i, (value_type*)nullptr));
+  }
+  return x;
+}
+
+// size right past a growth point so that a migration is in progress
+
+template <class Container> static int growth_size()
+{
+  using value_type = typename Container::value_type;
+
+  Container x;
+  int i = 0;
+  for (; i < 1000; ++i) {
+    x.insert(make_value(i, (value_type*)nullptr));
+  }
+  auto bucket_count = x.bucket_count();
+  while (x.bucket_count() == bucket_count) {
+    x.insert(make_value(i++, (value_type*)nullptr));
+  }
+  return i + 1;
+}
+
+template <class Container> static void test_modifiers()
+{
+  using value_type = typename Container::value_type;
+
+  int const n = growth_size<Container>();
+
+  // erase by key and by iterator
+
+  {
+    auto x = make_container<Container>(n);
+    long long sum = sum_of(x);
+    for (int i = 0; i < n; i += 3) {
+      BOOST_TEST_EQ(x.erase(i), 1u);
+      sum -= i;
+    }
+    for (auto it = x.begin(); it != x.end();) {
+      if (mapped_of(*it) % 3 == 1) {
+        sum -= mapped_of(*it);
+        it = x.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    BOOST_TEST_EQ(sum_of(x), sum);
+    BOOST_TEST_EQ(
+      static_cast<std::size_t>(std::distance(x.begin(), x.end())), x.size());
+    for (int i = 0; i < n; ++i) {
+      BOOST_TEST_EQ(x.count(i), i % 3 == 2 ? 1u : 0u);
+    }
+  }
+
+  // erase_if
+
+  {
+    auto x = make_container<Container>(n);
+    auto s = erase_if(x, [](value_type const& v) { return mapped_of(v) % 2; });
+    BOOST_TEST_EQ(s, static_cast<std::size_t>(n / 2));
+    for (int i = 0; i < n; ++i) {
+      BOOST_TEST_EQ(x.count(i), i % 2 ? 0u : 1u);
+    }
+  }
+
+  // copy, move, swap, equality
+
+  {
+    auto x = make_container<Container>(n);
+    Container y(x);
+    BOOST_TEST(x == y);
+    BOOST_TEST(contains_range(y, n));
+
+    Container z;
+    z = x;
+    BOOST_TEST(x == z);
+
+    Container w(std::move(z));
+    BOOST_TEST(x == w);
+    BOOST_TEST(z.empty());
+
+    z = std::move(w);
+    BOOST_TEST(x == z);
+
+    auto v = make_container<Container>(n);
+    v.swap(y);
+    BOOST_TEST(x == v);
+    BOOST_TEST(x == y);
+
+    v.insert(make_value(n, (value_type*)nullptr));
+    BOOST_TEST(x != v);
+  }
+
+  // merge
+
+  {
+    auto x = make_container<Container>(n);
+    Container y;
+    y.merge(x);
+    BOOST_TEST(x.empty());
+    BOOST_TEST_EQ(y.size(), static_cast<std::size_t>(n));
+    BOOST_TEST(contains_range(y, n));
+  }
+
+  // rehash and reserve complete the migration
+
+  {
+    auto x = make_container<Container>(n);
+    x.reserve(0);
+    BOOST_TEST_EQ(x.size(), static_cast<std::size_t>(n));
+    BOOST_TEST(contains_range(x, n));
+
+    auto y = make_container<Container>(n);
+    y.rehash(0);
+    BOOST_TEST(x == y);
+  }
+
+  // clear
+
+  {
+    auto x = make_container<Container>(n);
+    x.clear();
+    BOOST_TEST(x.empty());
+    BOOST_TEST(x.begin() == x.end());
+    BOOST_TEST(x.find(0) == x.end());
+    x.insert(make_value(0, (value_type*)nullptr));
+    BOOST_TEST_EQ(x.size(), 1u);
+  }
+}
+
+// Insertion moves elements of flat containers while a migration is in
+// progress, but once it's completed, pointers and references stay valid
+// until the maximum load is reached, as usual.
+
+template <class Container> static void test_reference_stability()
+{
+  using value_type = typename Container::value_type;
+
+  int const n = growth_size<Container>();
+
+  auto x = make_container<Container>(n);
+  x.reserve(0);
+  auto bucket_count = x.bucket_count();
+
+  std::vector<value_type const*> addresses;
+  for (int i = 0; i < n; ++i) {
+    addresses.push_back(&*x.find(i));
+  }
+
+  int i = n;
+  for (; x.size() < x.max_load(); ++i) {
+    x.insert(make_value(i, (value_type*)nullptr));
+  }
+  BOOST_TEST_GT(i, n);
+  BOOST_TEST_EQ(x.bucket_count(), bucket_count);
+
+  for (int j = 0; j < n; ++j) {
+    BOOST_TEST_EQ(&*x.find(j), addresses[static_cast<std::size_t>(j)]);
+  }
+}
+
+template <class Container> static void test_concurrent_interop()
+{
+  using concurrent_container =
+    boost::concurrent_flat_map<typename Container::key_type,
+      typename Container::mapped_type>;
+
+  int const n = growth_size<Container>();
+
+  auto x = make_container<Container>(n);
+  concurrent_container cx(std::move(x));
+  BOOST_TEST_EQ(cx.size(), static_cast<std::size_t>(n));
+  for (int i = 0; i < n; ++i) {
+    BOOST_TEST_EQ(cx.count(i), 1u);
+  }
+
+  Container y(std::move(cx));
+  BOOST_TEST(contains_range(y, n));
+}
+
+UNORDERED_AUTO_TEST (incremental_rehash_) {
+  test_insertion<boost::unordered_flat_map<int, int> >(20000);
+  test_insertion<boost::unordered_node_map<int, int> >(20000);
+  test_insertion<boost::unordered_flat_set<int> >(20000);
+  test_insertion<boost::unordered_node_set<int> >(20000);
+
+  test_modifiers<boost::unordered_flat_map<int, int> >();
+  test_modifiers<boost::unordered_node_map<int, int> >();
+  test_modifiers<boost::unordered_flat_set<int> >();
+  test_modifiers<boost::unordered_node_set<int> >();
+
+  test_reference_stability<boost::unordered_flat_map<int, int> >();
+  test_reference_stability<boost::unordered_node_map<int, int> >();
+  test_reference_stability<boost::unordered_flat_set<int> >();
+  test_reference_stability<boost::unordered_node_set<int> >();
+
+  test_concurrent_interop<boost::unordered_flat_map<int, int> >();
+}
+
+RUN_TESTS()
@@ -0,0 +1,230 @@
+// Copyright 2025 Joaquin M Lopez Munoz.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifdef BOOST_UNORDERED_CFOA_TESTS
+#include <boost/unordered/concurrent_flat_map.hpp>
+#include <boost/unordered/concurrent_flat_set.hpp>
+#include <boost/unordered/concurrent_node_map.hpp>
+#include <boost/unordered/concurrent_node_set.hpp>
+#include "../cfoa/helpers.hpp"
+#elif defined(BOOST_UNORDERED_FOA_TESTS)
+#include "../helpers/unordered.hpp"
+#else
+#error "precomputed_hash_tests is currently only supported by open-addressed containers"
+#endif
+
+#include "../helpers/test.hpp"
+#include <boost/container_hash/hash.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <string>
+#include <type_traits>
+
+struct transparent_string_hash
+{
+  using is_transparent = void;
+
+  std::size_t operator()(std::string const& x) const
+  {
+    return boost::hash<std::string>()(x);
+  }
+
+  std::size_t operator()(char const* x) const
+  {
+    return boost::hash<std::string>()(x);
+  }
+};
+
+struct transparent_string_equal
+{
+  using is_transparent = void;
+
+  template <class T, class U> bool operator()(T const& x, U const& y) const
+  {
+    return std::string(x) == std::string(y);
+  }
+};
+
+struct avalanching_int_hash
+{
+  using is_avalanching = std::true_type;
+
+  std::size_t operator()(int x) const
+  {
+    return static_cast<std::size_t>(x) *
+           static_cast<std::size_t>(0x9E3779B97F4A7C15ull);
+  }
+};
+
+template <class T> static int make_key(int i, T*) { return i; }
+
+static std::string make_key(int i, std::string*) { return std::to_string(i); }
+
+template <class Key>
+static std::pair<Key const, int> make_value(
+  Key const& k, std::pair<Key const, int>*)
+{
+  return {k, 0};
+}
+
+template <class Key> static Key make_value(Key const& k, Key*) { return k; }
+
+template <class Container> static Container make_container(int n)
+{
+  using key_type = typename Container::key_type;
+  using value_type = typename Container::value_type;
+
+  Container x;
+  for (int i = 0; i < n; ++i) {
+    x.insert(make_value(make_key(i, (key_type*)nullptr), (value_type*)nullptr));
+  }
+  return x;
+}
+
+#ifdef BOOST_UNORDERED_CFOA_TESTS
+
+template <class Container> static void test_precomputed_hash()
+{
+  using key_type = typename Container::key_type;
+  using value_type = typename Container::value_type;
+
+  static constexpr int n = 500;
+
+  auto x = make_container<Container>(n);
+  Container y(x);
+
+  for (int i = 0; i < 2 * n; ++i) {
+    auto k = make_key(i, (key_type*)nullptr);
+    auto hash = x.hash_function_mixed(k);
+    std::size_t expected = i < n ? 1 : 0;
+
+    BOOST_TEST_EQ(hash.value(), y.hash_function_mixed(k).value());
+
+    std::size_t num_visits = 0;
+    BOOST_TEST_EQ(
+      x.visit(k, hash, [&](value_type const&) { ++num_visits; }), expected);
+    BOOST_TEST_EQ(
+      static_cast<Container const&>(x).visit(
+        k, hash, [&](value_type const&) { ++num_visits; }),
+      expected);
+    BOOST_TEST_EQ(
+      y.cvisit(k, hash, [&](value_type const&) { ++num_visits; }), expected);
+    BOOST_TEST_EQ(num_visits, 3 * expected);
+
+    BOOST_TEST_EQ(x.erase(k, hash), expected);
+    BOOST_TEST_EQ(x.erase(k, hash), 0u);
+  }
+  BOOST_TEST(x.empty());
+  BOOST_TEST_EQ(y.size(), static_cast<std::size_t>(n));
+}
+
+#else
+
+template <class Container>
+static void test_try_emplace(Container& x, std::true_type /* map */)
+{
+  using key_type = typename Container::key_type;
+
+  auto k = make_key(-1, (key_type*)nullptr);
+  auto hash = x.hash_function_mixed(k);
+
+  auto r = x.try_emplace(k, hash, 1);
+  BOOST_TEST(r.second);
+  BOOST_TEST(r.first == x.find(k));
+  BOOST_TEST_EQ(r.first->second, 1);
+
+  r = x.try_emplace(key_type(k), hash, 2);
+  BOOST_TEST(!r.second);
+  BOOST_TEST_EQ(r.first->second, 1);
+
+  BOOST_TEST_EQ(x.erase(k, hash), 1u);
+}
+
+template <class Container>
+static void test_try_emplace(Container&, std::false_type /* set */)
+{
+}
+
+template <class Container> static void test_precomputed_hash()
+{
+  using key_type = typename Container::key_type;
+
+  static constexpr int n = 500;
+
+  auto x = make_container<Container>(n);
+  Container y(x);
+  Container const& cy = y;
+
+  test_try_emplace(x,
+    std::integral_constant<bool,
+      !std::is_same<key_type, typename Container::value_type>::value>{});
+
+  for (int i = 0; i < 2 * n; ++i) {
+    auto k = make_key(i, (key_type*)nullptr);
+    auto hash = x.hash_function_mixed(k);
+
+    BOOST_TEST_EQ(hash.value(), y.hash_function_mixed(k).value());
+    BOOST_TEST(x.find(k, hash) == x.find(k));
+    BOOST_TEST(cy.find(k, hash) == cy.find(k));
+    BOOST_TEST_EQ(x.erase(k, hash), i < n ? 1u : 0u);
+    BOOST_TEST(x.find(k, hash) == x.end());
+  }
+  BOOST_TEST(x.empty());
+  BOOST_TEST_EQ(y.size(), static_cast<std::size_t>(n));
+}
+
+#endif
+
+template <class Container> static void test_transparent_precomputed_hash()
+{
+  auto x = make_container<Container>(10);
+  auto hash = x.hash_function_mixed("5");
+
+  BOOST_TEST_EQ(hash.value(), x.hash_function_mixed(std::string("5")).value());
+#ifdef BOOST_UNORDERED_CFOA_TESTS
+  BOOST_TEST_EQ(
+    x.cvisit("5", hash, [](typename Container::value_type const&) {}), 1u);
+#else
+  BOOST_TEST(x.find("5", hash) != x.end());
+#endif
+  BOOST_TEST_EQ(x.erase("5", hash), 1u);
+  BOOST_TEST_EQ(x.erase("5", hash), 0u);
+}
+
+template <class Container> static void test_avalanching_precomputed_hash()
+{
+  Container x;
+
+  // no post-mixing applied
+
+  BOOST_TEST_EQ(
+    x.hash_function_mixed(42).value(), avalanching_int_hash()(42));
+}
+
+UNORDERED_AUTO_TEST (precomputed_hash_) {
+#if defined(BOOST_UNORDERED_CFOA_TESTS)
+  test_precomputed_hash<boost::concurrent_flat_map<int, int> >();
+  test_precomputed_hash<boost::concurrent_node_map<std::string, int> >();
+  test_precomputed_hash<boost::concurrent_flat_set<std::string> >();
+  test_precomputed_hash<boost::concurrent_node_set<int> >();
+  test_transparent_precomputed_hash<boost::concurrent_flat_map<std::string,
+    int, transparent_string_hash, transparent_string_equal> >();
+  test_transparent_precomputed_hash<boost::concurrent_node_set<std::string,
+    transparent_string_hash, transparent_string_equal> >();
+  test_avalanching_precomputed_hash<
+    boost::concurrent_flat_set<int, avalanching_int_hash> >();
+#else
+  test_precomputed_hash<boost::unordered_flat_map<int, int> >();
+  test_precomputed_hash<boost::unordered_node_map<std::string, int> >();
+  test_precomputed_hash<boost::unordered_flat_set<std::string> >();
+  test_precomputed_hash<boost::unordered_node_set<int> >();
+  test_transparent_precomputed_hash<boost::unordered_flat_map<std::string,
+    int, transparent_string_hash, transparent_string_equal> >();
+  test_transparent_precomputed_hash<boost::unordered_node_set<std::string,
+    transparent_string_hash, transparent_string_equal> >();
+  test_avalanching_precomputed_hash<
+    boost::unordered_flat_set<int, avalanching_int_hash> >();
+#endif
+}
+
+RUN_TESTS()
@@ -0,0 +1,104 @@
+// Copyright 2025 Joaquin M Lopez Munoz.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(BOOST_UNORDERED_FOA_TESTS)
+#error "runtime_dispatch_tests is currently only supported by open-addressed containers"
+#endif
+
+#define BOOST_UNORDERED_ENABLE_RUNTIME_DISPATCH
+
+#include "../helpers/unordered.hpp"
+
+#include "../helpers/test.hpp"
+#include <boost/core/lightweight_test.hpp>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Exercises full-table traversal (copy, erase_if, merge, iteration) on sparse
+// tables so that long runs of empty groups are skipped, with and without the
+// AVX2 path when runtime dispatch is available on this platform.
+
+template <class Container>
+static Container make_sparse_container(
+  std::size_t capacity, std::size_t stride, std::size_t& sum)
+{
+  Container x;
+  x.reserve(capacity);
+  sum = 0;
+  for (std::size_t i = 0; i < capacity; i += stride) {
+    x.emplace(static_cast<int>(i), static_cast<int>(i));
+    sum += i;
+  }
+  return x;
+}
+
+template <class Container> static void test_traversal()
+{
+  using value_type = typename Container::value_type;
+
+  static std::size_t const capacity = 20000;
+
+  std::size_t const strides[] = {1, 7, 64, 500, 5000, capacity};
+  for (std::size_t stride : strides) {
+    std::size_t sum = 0;
+    auto x = make_sparse_container<Container>(capacity, stride, sum);
+    std::size_t const size = x.size();
+
+    Container y(x);
+    BOOST_TEST_EQ(y.size(), size);
+    BOOST_TEST(x == y);
+
+    std::size_t sum2 = 0;
+    auto n = erase_if(y, [&](value_type const& v) {
+      sum2 += static_cast<std::size_t>(v.second);
+      return false;
+    });
+    BOOST_TEST_EQ(n, 0u);
+    BOOST_TEST_EQ(sum2, sum);
+
+    sum2 = 0;
+    for (auto const& v : y) {
+      sum2 += static_cast<std::size_t>(v.second);
+    }
+    BOOST_TEST_EQ(sum2, sum);
+
+    Container z;
+    z.merge(y);
+    BOOST_TEST(y.empty());
+    BOOST_TEST(x == z);
+
+    n = erase_if(z, [](value_type const&) { return true; });
+    BOOST_TEST_EQ(n, size);
+    BOOST_TEST(z.empty());
+
+    x.clear();
+    BOOST_TEST(x.empty());
+    BOOST_TEST(x.begin() == x.end());
+  }
+}
+
+static void test_all()
+{
+  test_traversal<boost::unordered_flat_map<int, int> >();
+  test_traversal<boost::unordered_node_map<int, int> >();
+}
+
+UNORDERED_AUTO_TEST (runtime_dispatch_) {
+#if defined(BOOST_UNORDERED_RUNTIME_DISPATCH)
+  bool const avx2 = boost::unordered::detail::foa::cpu_features<>::avx2;
+
+  boost::unordered::detail::foa::cpu_features<>::avx2 = false;
+  test_all();
+
+  boost::unordered::detail::foa::cpu_features<>::avx2 = avx2;
+  if (avx2) {
+    test_all();
+  }
+#else
+  test_all();
+#endif
+}
+
+RUN_TESTS()
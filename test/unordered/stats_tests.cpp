@@ -160,8 +160,8 @@ void check_container_stats(const Stats& s, check_stats_contition cond)
     cond == stats_empty? stats_empty : stats_mostly_full);
 }
 
-template <class Stats>
-void check_container_stats(const Stats& s1, const Stats& s2)
+template <class Stats1, class Stats2>
+void check_container_stats(const Stats1& s1, const Stats2& s2)
 {
   check_insertion_stats(s1.insertion, s2.insertion);
   check_lookup_stats(s1.successful_lookup, s2.successful_lookup);